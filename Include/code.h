@@ -12,9 +12,11 @@ typedef uint16_t _Py_CODEUNIT;
 #ifdef WORDS_BIGENDIAN
 #  define _Py_OPCODE(word) ((word) >> 8)
 #  define _Py_OPARG(word) ((word) & 255)
+#  define _Py_MAKECODEUNIT(opcode, oparg) (((opcode) << 8) | (oparg))
 #else
 #  define _Py_OPCODE(word) ((word) & 255)
 #  define _Py_OPARG(word) ((word) >> 8)
+#  define _Py_MAKECODEUNIT(opcode, oparg) ((opcode) | ((oparg) << 8))
 #endif
 
 typedef struct _PyOpcache _PyOpcache;
@@ -64,6 +66,9 @@ typedef struct {
     //  * n > 0 means there is cache in co_opcache[n-1].
     unsigned char *co_opcache_map;
     _PyOpcache *co_opcache;
+    // Quickened copy of co_code executed by the interpreter, created at the
+    // same time as the cache, or NULL.
+    _Py_CODEUNIT *co_quickened;
     int co_opcache_flag;  // used to determine when create a cache.
     unsigned char co_opcache_size;  // length of co_opcache.
 } PyCodeObject;
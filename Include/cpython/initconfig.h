@@ -154,6 +154,14 @@ typedef struct {
     int dump_refs;          /* PYTHONDUMPREFS */
     int malloc_stats;       /* PYTHONMALLOCSTATS */
 
+    /* Size in bytes of the pymalloc arenas, 0 means the default size.
+       Set by -X pymalloc_arena_size=SIZE and PYTHONMALLOCARENASIZE. */
+    unsigned long pymalloc_arena_size;
+
+    /* Back the pymalloc arenas with huge pages?
+       Set to 1 by -X pymalloc_hugepages and PYTHONMALLOCHUGEPAGES. */
+    int pymalloc_hugepages;
+
     /* Python filesystem encoding and error handler:
        sys.getfilesystemencoding() and sys.getfilesystemencodeerrors().
 
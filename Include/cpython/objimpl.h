@@ -12,6 +12,10 @@ PyAPI_FUNC(Py_ssize_t) _Py_GetAllocatedBlocks(void);
 /* Macros */
 #ifdef WITH_PYMALLOC
 PyAPI_FUNC(int) _PyObject_DebugMallocStats(FILE *out);
+
+/* Give the memory of the unused pymalloc pools back to the OS.
+   Return the number of bytes released. */
+PyAPI_FUNC(size_t) _PyObject_TrimMemory(void);
 #endif
 
 
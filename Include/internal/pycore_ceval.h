@@ -18,6 +18,8 @@ PyAPI_FUNC(void) _PyEval_FiniThreads(
     struct _ceval_runtime_state *ceval);
 PyAPI_FUNC(void) _PyEval_SignalReceived(
     struct _ceval_runtime_state *ceval);
+PyAPI_FUNC(void) _PyEval_RequestSample(
+    struct _ceval_runtime_state *ceval);
 PyAPI_FUNC(int) _PyEval_AddPendingCall(
     PyThreadState *tstate,
     struct _ceval_runtime_state *ceval,
@@ -34,6 +36,14 @@ PyAPI_FUNC(void) _PyEval_SetCoroutineOriginTrackingDepth(
 /* Private function */
 void _PyEval_Fini(void);
 
+/* Sampling profiler: see Python/sampler.c */
+extern int _PySampler_Start(_PyTime_t interval, Py_ssize_t size);
+extern void _PySampler_Stop(void);
+extern void _PySampler_Sample(PyThreadState *tstate);
+extern PyObject* _PySampler_GetStacks(void);
+extern void _PySampler_Fini(void);
+PyAPI_FUNC(void) _PySampler_AfterFork(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,15 +10,33 @@ typedef struct {
     uint64_t builtins_ver; /* ma_version of builtin dict */
 } _PyOpcache_LoadGlobal;
 
+/* Kinds of attribute accesses cached by LOAD_ATTR, STORE_ATTR and
+   LOAD_METHOD */
+#define _PyOpcache_ATTR_DICT 1    /* value stored in the instance __dict__ */
+#define _PyOpcache_ATTR_SLOT 2    /* T_OBJECT_EX member (__slots__) */
+#define _PyOpcache_ATTR_METHOD 3  /* method descriptor of the type */
+
+typedef struct {
+    PyTypeObject *type;  /* Cached type (borrowed reference) */
+    unsigned int tp_version_tag;  /* tp_version_tag of the cached type */
+    char kind;  /* _PyOpcache_ATTR_DICT, _PyOpcache_ATTR_SLOT
+                   or _PyOpcache_ATTR_METHOD */
+    Py_ssize_t hint;  /* DICT: index of the entry in the instance dict,
+                         SLOT: offset of the member in the object */
+    PyObject *descr;  /* METHOD: method descriptor (borrowed reference) */
+} _PyOpcache_LoadAttr;
+
 struct _PyOpcache {
     union {
         _PyOpcache_LoadGlobal lg;
+        _PyOpcache_LoadAttr la;  /* LOAD_ATTR, STORE_ATTR and LOAD_METHOD */
     } u;
     char optimized;
 };
 
 /* Private API */
 int _PyCode_InitOpcache(PyCodeObject *co);
+int _PyCode_Quicken(PyCodeObject *co);
 
 
 #ifdef __cplusplus
@@ -101,6 +101,12 @@ struct gc_generation {
                   generations */
 };
 
+/* Number of buckets of the pause time histograms: bucket 0 counts the
+   collections which took less than 1 microsecond, bucket i the ones which
+   took between 2**(i-1) and 2**i microseconds, and the last bucket the
+   longer ones. */
+#define GC_PAUSE_BUCKETS 24
+
 /* Running stats per generation */
 struct gc_generation_stats {
     /* total number of collections */
@@ -109,6 +115,16 @@ struct gc_generation_stats {
     Py_ssize_t collected;
     /* total number of uncollectable objects (put into gc.garbage) */
     Py_ssize_t uncollectable;
+    /* total number of objects examined */
+    Py_ssize_t examined;
+    /* total time spent in collections, in finding the unreachable objects
+       and in finalizing them, and longest collection */
+    _PyTime_t time;
+    _PyTime_t unreachable_time;
+    _PyTime_t finalize_time;
+    _PyTime_t max_time;
+    /* histogram of the collection times */
+    Py_ssize_t pauses[GC_PAUSE_BUCKETS];
 };
 
 struct _gc_runtime_state {
@@ -143,6 +159,19 @@ struct _gc_runtime_state {
        collections, and are awaiting to undergo a full collection for
        the first time. */
     Py_ssize_t long_lived_pending;
+    /* Incremental collection of the oldest generation: number of objects
+       of the oldest generation examined by each increment (0 if the oldest
+       generation is collected all at once), and number of incremental
+       passes after which a full collection is done instead (0 for never). */
+    Py_ssize_t incremental_slice;
+    int incremental_full_passes;
+    /* Number of objects of the oldest generation not examined yet by the
+       current incremental pass (0 if no pass is in progress), and number of
+       objects which survived the increments of this pass. */
+    Py_ssize_t incremental_remaining;
+    Py_ssize_t incremental_survivors;
+    /* Number of incremental passes done since the last full collection. */
+    int incremental_passes;
 };
 
 PyAPI_FUNC(void) _PyGC_Initialize(struct _gc_runtime_state *);
@@ -188,6 +217,13 @@ PyAPI_FUNC(int) _PyMem_GetAllocatorName(
    PYMEM_ALLOCATOR_NOT_SET does nothing. */
 PyAPI_FUNC(int) _PyMem_SetupAllocators(PyMemAllocatorName allocator);
 
+/* Configure the arenas of pymalloc allocated from now on: size is their size
+   in bytes (0 means the default size), hugepages asks to back them with huge
+   pages (the size is then at least 2 MB).
+   Return 0 on success, or return -1 if the size is invalid: it must be a
+   power of 2 between 64 KB and 16 MB. */
+PyAPI_FUNC(int) _PyObject_SetArenaConfig(size_t size, int hugepages);
+
 #ifdef __cplusplus
 }
 #endif
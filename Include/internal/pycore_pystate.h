@@ -56,6 +56,8 @@ struct _ceval_runtime_state {
     struct _pending_calls pending;
     /* Request for checking signals. */
     _Py_atomic_int signals_pending;
+    /* Request for a sample of the sampling profiler. */
+    _Py_atomic_int sample_request;
     struct _gil_runtime_state gil;
 };
 
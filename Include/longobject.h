@@ -215,6 +215,11 @@ PyAPI_FUNC(int) _PyLong_FormatAdvancedWriter(
     PyObject *format_spec,
     Py_ssize_t start,
     Py_ssize_t end);
+
+/* free list api */
+PyAPI_FUNC(int) PyLong_ClearFreeList(void);
+
+PyAPI_FUNC(void) _PyLong_DebugMallocStats(FILE* out);
 #endif /* Py_LIMITED_API */
 
 /* These aren't really part of the int object, but they're handy. The
@@ -129,6 +129,26 @@ extern "C" {
 #define CALL_FINALLY            162
 #define POP_FINALLY             163
 
+    /* Specialized instructions, only used by the interpreter in the
+       quickened copy of the bytecode of hot code objects */
+#define BINARY_ADD_ADAPTIVE       7
+#define BINARY_ADD_INT            8
+#define BINARY_ADD_FLOAT         13
+#define BINARY_ADD_UNICODE       14
+#define BINARY_SUBSCR_ADAPTIVE   18
+#define BINARY_SUBSCR_LIST_INT   21
+#define BINARY_SUBSCR_TUPLE_INT  30
+#define BINARY_SUBSCR_DICT       31
+#define COMPARE_OP_ADAPTIVE      32
+#define COMPARE_OP_INT           33
+#define COMPARE_OP_FLOAT         34
+#define COMPARE_OP_STR           35
+#define LOAD_FAST__LOAD_FAST     36
+#define LOAD_FAST__LOAD_ATTR     37
+#define COMPARE_OP_INT__POP_JUMP_IF_FALSE  38
+#define COMPARE_OP_FLOAT__POP_JUMP_IF_FALSE  39
+#define COMPARE_OP_STR__POP_JUMP_IF_FALSE  40
+
 /* EXCEPT_HANDLER is a special, implicit block type which is created when
    entering an except handler. It is not an opcode but we define it here
    as we want it to be available to both frameobject.c and ceval.c, while
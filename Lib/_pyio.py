@@ -1687,6 +1687,36 @@ class FileIO(RawIOBase):
         m[:n] = data
         return n
 
+    if hasattr(os, 'pread'):
+        def readv_at(self, offsets, buffers, /):
+            """Read into each of the buffers from the matching offset of the file.
+
+            Return a list with the number of bytes actually read into each
+            buffer, which can be less than the size of the buffer: 0 at the end
+            of the file, or a short read, which the caller has to complete.
+            The file position is not changed.
+            """
+            self._checkClosed()
+            self._checkReadable()
+            offsets = list(offsets)
+            views = [memoryview(b).cast('B') for b in buffers]
+            if len(offsets) != len(views):
+                raise ValueError("offsets and buffers must have the same length")
+            for i, offset in enumerate(offsets):
+                try:
+                    offset_index = offset.__index__
+                except AttributeError:
+                    raise TypeError(f"{offset!r} is not an integer")
+                offsets[i] = offset = offset_index()
+                if offset < 0:
+                    raise ValueError("negative offset")
+            sizes = []
+            for offset, m in zip(offsets, views):
+                data = os.pread(self._fd, len(m), offset)
+                m[:len(data)] = data
+                sizes.append(len(data))
+            return sizes
+
     def write(self, b):
         """Write bytes b to file, return number written.
 
@@ -8,7 +8,7 @@ try:
 except ImportError:
     c_scanstring = None
 
-__all__ = ['JSONDecoder', 'JSONDecodeError']
+__all__ = ['JSONDecoder', 'JSONDecodeError', 'JSONStreamDecoder']
 
 FLAGS = re.VERBOSE | re.MULTILINE | re.DOTALL
 
@@ -43,6 +43,21 @@ class JSONDecodeError(ValueError):
         return self.__class__, (self.msg, self.doc, self.pos)
 
 
+def _stream_error_position(err, offset, lineno, linestart):
+    """Make the positions of err, a JSONDecodeError in a text found at index
+    offset of a stream, on line lineno which starts at index linestart,
+    positions in the whole stream.  Used by the stream scanners.
+    """
+    if not isinstance(err, JSONDecodeError):
+        return
+    if err.lineno == 1:
+        err.colno = offset + err.pos - linestart + 1
+    err.lineno += lineno - 1
+    err.pos += offset
+    err.args = ('%s: line %d column %d (char %d)'
+                % (err.msg, err.lineno, err.colno, err.pos),)
+
+
 _CONSTANTS = {
     '-Infinity': NegInf,
     'Infinity': PosInf,
@@ -130,6 +145,7 @@ def py_scanstring(s, end, strict=True,
 scanstring = c_scanstring or py_scanstring
 
 WHITESPACE = re.compile(r'[ \t\n\r]*', FLAGS)
+WHITESPACE_BYTES = re.compile(br'[ \t\n\r]*', FLAGS)
 WHITESPACE_STR = ' \t\n\r'
 
 
@@ -354,3 +370,102 @@ class JSONDecoder(object):
         except StopIteration as err:
             raise JSONDecodeError("Expecting value", s, err.value) from None
         return obj, end
+
+    def _decode_utf8(self, b, _w=WHITESPACE_BYTES.match):
+        """Return the Python representation of ``b`` (a ``bytes`` or
+        ``bytearray`` instance containing a UTF-8 encoded JSON document).
+
+        The C scanner parses ``b`` directly, the document is only decoded
+        to ``str`` as a whole to report errors.
+
+        """
+        if (scanner.c_make_scanner is None or
+                type(self.scan_once) is not scanner.c_make_scanner):
+            return self.decode(b.decode('utf-8', 'surrogatepass'))
+        # The indexes are in bytes
+        try:
+            obj, end = self.scan_once(b, _w(b, 0).end())
+        except StopIteration as err:
+            raise self._utf8_error("Expecting value", b, err.value) from None
+        end = _w(b, end).end()
+        if end != len(b):
+            raise self._utf8_error("Extra data", b, end)
+        return obj
+
+    def _utf8_error(self, msg, b, end):
+        doc = b.decode('utf-8', 'surrogatepass')
+        pos = len(b[:end].decode('utf-8', 'surrogatepass'))
+        return JSONDecodeError(msg, doc, pos)
+
+
+class JSONStreamDecoder(object):
+    """Incremental decoder of a stream of JSON values
+
+    The stream is passed in parts of any size to ``feed()``, which returns
+    the list of the values completed by each part, and ``close()`` returns
+    the values completed by the end of the stream.  The stream is a sequence
+    of JSON documents separated by whitespace, like JSON Lines, or, if
+    ``array`` is true, a single JSON array whose elements are returned one
+    by one.  Only the text of the current value is kept in memory.  The
+    errors are reported at their positions in the whole stream.
+
+    """
+
+    def __init__(self, decoder=None, *, array=False):
+        """``decoder`` is the ``JSONDecoder`` which decodes the values, a
+        default one is used if it is None.
+        """
+        if decoder is None:
+            decoder = JSONDecoder()
+        self.decoder = decoder
+        self.array = array
+        self._scanner = scanner.make_stream_scanner(decoder, array)
+        self._head = b''
+        self._bytes_decoder = None
+
+    def feed(self, s):
+        """Decode the next part ``s`` of the stream, and return the list of
+        the values which it completes.  ``s`` is a ``str``, or a ``bytes``
+        or ``bytearray`` instance whose encoding is detected from the start
+        of the stream like ``json.loads()`` does.
+
+        """
+        if not isinstance(s, str):
+            if not isinstance(s, (bytes, bytearray)):
+                raise TypeError(f'the JSON object must be str, bytes or '
+                                f'bytearray, not {s.__class__.__name__}')
+            if self._bytes_decoder is None:
+                # The encoding is detected from the first 4 bytes
+                self._head += s
+                if len(self._head) < 4:
+                    return []
+                s = self._start_bytes(final=False)
+            else:
+                s = self._bytes_decoder.decode(s)
+        return self._scanner.feed(s)
+
+    def close(self):
+        """End the stream, and return the list of the values which it
+        completes.  The decoder can then decode a new stream.
+
+        """
+        try:
+            values = []
+            if self._head:
+                values = self._scanner.feed(self._start_bytes(final=True))
+            elif self._bytes_decoder is not None:
+                values = self._scanner.feed(self._bytes_decoder.decode(
+                    b'', final=True))
+            return values + self._scanner.close()
+        finally:
+            self._head = b''
+            self._bytes_decoder = None
+
+    def _start_bytes(self, final):
+        import codecs
+        from json import detect_encoding
+        head = self._head
+        self._head = b''
+        self._bytes_decoder = codecs.getincrementaldecoder(
+            detect_encoding(head))('surrogatepass')
+        return self._bytes_decoder.decode(head, final)
@@ -1,12 +1,18 @@
 """JSON token scanner
 """
 import re
+# Partially initialized here: json.decoder imports this module
+from json import decoder
 try:
     from _json import make_scanner as c_make_scanner
 except ImportError:
     c_make_scanner = None
+try:
+    from _json import make_stream_scanner as c_make_stream_scanner
+except ImportError:
+    c_make_stream_scanner = None
 
-__all__ = ['make_scanner']
+__all__ = ['make_scanner', 'make_stream_scanner']
 
 NUMBER_RE = re.compile(
     r'(-?(?:0|[1-9]\d*))(\.\d+)?([eE][-+]?\d+)?',
@@ -71,3 +77,246 @@ def py_make_scanner(context):
     return scan_once
 
 make_scanner = c_make_scanner or py_make_scanner
+
+
+# States of the stream scanner
+(_VALUE, _VALUE_END, _ARRAY_START, _ARRAY_FIRST, _ARRAY_NEXT, _ARRAY_ELEMENT,
+ _ARRAY_END, _CONTAINER, _STRING, _SCALAR) = range(10)
+
+_WHITESPACE = ' \t\n\r'
+# Characters which change the state of the stream scanner
+CONTAINER_RE = re.compile(r'[][{}"]')
+STRING_RE = re.compile(r'["\\]')
+SCALAR_END_RE = re.compile(r'[][{}," \t\n\r]')
+NONWHITESPACE_RE = re.compile(r'[^ \t\n\r]')
+
+
+class py_make_stream_scanner:
+    """Split a stream of text into JSON values.
+
+    feed() only tracks the nesting of containers and strings to find where
+    each value ends, keeping the parts of the current value in a list, and
+    hands the text of every complete value to context.scan_once.  The
+    positions of the errors are given in the whole stream.
+    """
+
+    def __init__(self, context, array=False):
+        self.array = bool(array)
+        self._scan_once = context.scan_once
+        self._pending = []
+        self._reset()
+        self._reset_position()
+
+    def _reset(self):
+        self._state = _ARRAY_START if self.array else _VALUE
+        self._depth = 0
+        self._in_string = False
+        self._escape = False
+        self._pending.clear()
+
+    def _reset_position(self):
+        # The lines are counted up to index _counted of the current part,
+        # which starts at index _offset of the stream
+        self._offset = 0
+        self._counted = 0
+        self._lineno = 1
+        self._linestart = 0
+        self._value_position = (0, 1, 0)
+
+    def _advance(self, string, idx):
+        # Count the lines up to string[idx]
+        newlines = string.count('\n', self._counted, idx)
+        if newlines:
+            self._lineno += newlines
+            self._linestart = (self._offset +
+                               string.rindex('\n', self._counted, idx) + 1)
+        self._counted = idx
+
+    def _next_part(self, string):
+        self._advance(string, len(string))
+        self._offset += len(string)
+        self._counted = 0
+
+    def _error(self, msg, doc, pos, position):
+        err = decoder.JSONDecodeError(msg, doc, pos)
+        decoder._stream_error_position(err, *position)
+        return err
+
+    def _decode(self, text):
+        JSONDecodeError = decoder.JSONDecodeError
+        try:
+            obj, end = self._scan_once(text, 0)
+        except StopIteration as err:
+            raise JSONDecodeError("Expecting value", text, err.value) from None
+        if end != len(text):
+            raise JSONDecodeError("Extra data", text, end)
+        return obj
+
+    def _end_value(self, string, start, end, values):
+        self._pending.append(string[start:end])
+        text = ''.join(self._pending)
+        self._pending.clear()
+        try:
+            values.append(self._decode(text))
+        except decoder.JSONDecodeError as err:
+            decoder._stream_error_position(err, *self._value_position)
+            raise
+        self._state = _ARRAY_NEXT if self.array else _VALUE_END
+
+    def feed(self, string):
+        """Scan the next part of the stream, and return the list of the
+        values which it completes."""
+        if not isinstance(string, str):
+            raise TypeError(f'first argument must be a string, '
+                            f'not {string.__class__.__name__}')
+        try:
+            values = self._feed(string)
+        except:
+            self._reset()
+            raise
+        finally:
+            self._next_part(string)
+        return values
+
+    def _feed(self, string):
+        # Position of the start of the part, for the errors in it
+        position = (self._offset, self._lineno, self._linestart)
+        values = []
+        start = idx = 0
+        end = len(string)
+        if self._escape and end:
+            # The previous part ended with a backslash in a string
+            self._escape = False
+            idx = 1
+        while idx < end:
+            state = self._state
+            if state == _CONTAINER:
+                if self._in_string:
+                    m = STRING_RE.search(string, idx)
+                    if m is None:
+                        break
+                    idx = m.end()
+                    if m.group() == '\\':
+                        if idx == end:
+                            # The escaped character is in the next part
+                            self._escape = True
+                            break
+                        idx += 1
+                    else:
+                        self._in_string = False
+                    continue
+                m = CONTAINER_RE.search(string, idx)
+                if m is None:
+                    break
+                idx = m.end()
+                c = m.group()
+                if c == '"':
+                    self._in_string = True
+                elif c in '[{':
+                    self._depth += 1
+                else:
+                    self._depth -= 1
+                    if not self._depth:
+                        self._end_value(string, start, idx, values)
+                continue
+            elif state == _STRING:
+                m = STRING_RE.search(string, idx)
+                if m is None:
+                    break
+                idx = m.end()
+                if m.group() == '\\':
+                    if idx == end:
+                        self._escape = True
+                        break
+                    idx += 1
+                else:
+                    self._end_value(string, start, idx, values)
+                continue
+            elif state == _SCALAR:
+                m = SCALAR_END_RE.search(string, idx)
+                if m is None:
+                    break
+                # The character after the value is scanned again
+                idx = m.start()
+                self._end_value(string, start, idx, values)
+                continue
+            elif state == _VALUE_END:
+                # Documents are separated by whitespace
+                if string[idx] not in _WHITESPACE:
+                    raise self._error("Extra data", string, idx, position)
+                self._state = _VALUE
+                idx += 1
+                continue
+
+            # Between values
+            m = NONWHITESPACE_RE.search(string, idx)
+            if m is None:
+                break
+            idx = m.start()
+            c = string[idx]
+            if state == _ARRAY_START:
+                if c != '[':
+                    raise self._error("Expecting '['", string, idx, position)
+                self._state = _ARRAY_FIRST
+                idx += 1
+                continue
+            elif state == _ARRAY_FIRST and c == ']':
+                self._state = _ARRAY_END
+                idx += 1
+                continue
+            elif state == _ARRAY_NEXT:
+                if c == ',':
+                    self._state = _ARRAY_ELEMENT
+                elif c == ']':
+                    self._state = _ARRAY_END
+                else:
+                    raise self._error("Expecting ',' delimiter", string, idx,
+                                      position)
+                idx += 1
+                continue
+            elif state == _ARRAY_END:
+                raise self._error("Extra data", string, idx, position)
+
+            # Start of a value
+            if c in ']},:':
+                raise self._error("Expecting value", string, idx, position)
+            start = idx
+            self._advance(string, idx)
+            self._value_position = (self._offset + idx, self._lineno,
+                                    self._linestart)
+            idx += 1
+            if c in '[{':
+                self._state = _CONTAINER
+                self._depth = 1
+                self._in_string = False
+            elif c == '"':
+                self._state = _STRING
+            else:
+                self._state = _SCALAR
+
+        if self._state >= _CONTAINER:
+            # Keep the start of the current value for the next call
+            self._pending.append(string[start:])
+        return values
+
+    def close(self):
+        """End the stream, and return the list of the values which it
+        completes.  The scanner can then scan a new stream."""
+        try:
+            values = []
+            if self._state >= _CONTAINER:
+                # Only a scalar can end with the stream, the scanner reports
+                # why other values are incomplete.
+                self._end_value('', 0, 0, values)
+            if self._state not in (_VALUE, _VALUE_END, _ARRAY_END):
+                position = (self._offset, self._lineno, self._linestart)
+                if self._state == _ARRAY_NEXT:
+                    raise self._error("Expecting ',' delimiter", '', 0,
+                                      position)
+                raise self._error("Expecting value", '', 0, position)
+        finally:
+            self._reset()
+            self._reset_position()
+        return values
+
+make_stream_scanner = c_make_stream_scanner or py_make_stream_scanner
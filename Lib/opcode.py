@@ -214,3 +214,34 @@ jrel_op('CALL_FINALLY', 162)
 def_op('POP_FINALLY', 163)
 
 del def_op, name_op, jrel_op, jabs_op
+
+# Specialized instructions.  They are never emitted by the compiler: the
+# interpreter only uses them in the quickened copy of the bytecode of hot
+# code objects (see Python/ceval.c).  They are assigned to unused opcodes.
+_specialized_instructions = [
+    'BINARY_ADD_ADAPTIVE',
+    'BINARY_ADD_INT',
+    'BINARY_ADD_FLOAT',
+    'BINARY_ADD_UNICODE',
+    'BINARY_SUBSCR_ADAPTIVE',
+    'BINARY_SUBSCR_LIST_INT',
+    'BINARY_SUBSCR_TUPLE_INT',
+    'BINARY_SUBSCR_DICT',
+    'COMPARE_OP_ADAPTIVE',
+    'COMPARE_OP_INT',
+    'COMPARE_OP_FLOAT',
+    'COMPARE_OP_STR',
+    # Superinstructions: FIRST__SECOND executes FIRST and, without
+    # dispatching it, the SECOND instruction which follows it.
+    'LOAD_FAST__LOAD_FAST',
+    'LOAD_FAST__LOAD_ATTR',
+    'COMPARE_OP_INT__POP_JUMP_IF_FALSE',
+    'COMPARE_OP_FLOAT__POP_JUMP_IF_FALSE',
+    'COMPARE_OP_STR__POP_JUMP_IF_FALSE',
+]
+
+_specialized_opmap = {}
+_unused_opcodes = [op for op in range(1, 256) if opname[op] == '<%r>' % op]
+for _name, _op in zip(_specialized_instructions, _unused_opcodes):
+    _specialized_opmap[_name] = _op
+del _name, _op, _unused_opcodes
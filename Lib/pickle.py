@@ -265,8 +265,17 @@ class _Unframer:
     def __init__(self, file_read, file_readline, file_tell=None):
         self.file_read = file_read
         self.file_readline = file_readline
+        self.file_tell = file_tell
         self.current_frame = None
 
+    def tell(self):
+        if self.current_frame:
+            frame = self.current_frame
+            return (self.file_tell() - frame.getbuffer().nbytes +
+                    frame.tell())
+        else:
+            return self.file_tell()
+
     def readinto(self, buf):
         if self.current_frame:
             n = self.current_frame.readinto(buf)
@@ -1133,6 +1142,9 @@ class _Pickler:
 
 class _Unpickler:
 
+    # Set by _set_zerocopy()
+    _file_tell = _input_view = _input_rview = None
+
     def __init__(self, file, *, fix_imports=True,
                  encoding="ASCII", errors="strict", buffers=None):
         """This takes a binary file for reading a pickle data stream.
@@ -1191,7 +1203,8 @@ class _Unpickler:
         if not hasattr(self, "_file_read"):
             raise UnpicklingError("Unpickler.__init__() was not called by "
                                   "%s.__init__()" % (self.__class__.__name__,))
-        self._unframer = _Unframer(self._file_read, self._file_readline)
+        self._unframer = _Unframer(self._file_read, self._file_readline,
+                                   self._file_tell)
         self.read = self._unframer.read
         self.readinto = self._unframer.readinto
         self.readline = self._unframer.readline
@@ -1344,6 +1357,24 @@ class _Unpickler:
         self.append(self._decode_string(data))
     dispatch[BINSTRING[0]] = load_binstring
 
+    def _set_zerocopy(self, data, file_tell):
+        # Make bytes and bytearray payloads views of data, which is what
+        # the file being read holds, instead of copies of it
+        self._file_tell = file_tell
+        self._input_view = memoryview(data).cast('B')
+        self._input_rview = self._input_view.toreadonly()
+
+    def _read_view(self, view, n):
+        start = self._unframer.tell()
+        if len(self.read(n)) < n:
+            raise UnpicklingError("pickle data was truncated")
+        return view[start:start + n]
+
+    # Minimum size of the BINBYTES8 and BYTEARRAY8 payloads returned as
+    # views with zerocopy; smaller ones are often __reduce__() arguments
+    # which expect real bytes
+    _ZEROCOPY_MIN_SIZE = 64 * 1024
+
     def load_binbytes(self):
         len, = unpack('<I', self.read(4))
         if len > maxsize:
@@ -1377,6 +1408,10 @@ class _Unpickler:
         if len > maxsize:
             raise UnpicklingError("BINBYTES8 exceeds system's maximum size "
                                   "of %d bytes" % maxsize)
+        if (self._input_rview is not None and
+                len >= self._ZEROCOPY_MIN_SIZE):
+            self.append(self._read_view(self._input_rview, len))
+            return
         self.append(self.read(len))
     dispatch[BINBYTES8[0]] = load_binbytes8
 
@@ -1385,6 +1420,9 @@ class _Unpickler:
         if len > maxsize:
             raise UnpicklingError("BYTEARRAY8 exceeds system's maximum size "
                                   "of %d bytes" % maxsize)
+        if self._input_view is not None and len >= self._ZEROCOPY_MIN_SIZE:
+            self.append(self._read_view(self._input_view, len))
+            return
         b = bytearray(len)
         self.readinto(b)
         self.append(b)
@@ -1750,12 +1788,15 @@ def _load(file, *, fix_imports=True, encoding="ASCII", errors="strict",
                      encoding=encoding, errors=errors).load()
 
 def _loads(s, *, fix_imports=True, encoding="ASCII", errors="strict",
-           buffers=None):
+           buffers=None, zerocopy=False):
     if isinstance(s, str):
         raise TypeError("Can't load pickle from unicode string")
     file = io.BytesIO(s)
-    return _Unpickler(file, fix_imports=fix_imports, buffers=buffers,
-                      encoding=encoding, errors=errors).load()
+    unpickler = _Unpickler(file, fix_imports=fix_imports, buffers=buffers,
+                           encoding=encoding, errors=errors)
+    if zerocopy:
+        unpickler._set_zerocopy(s, file.tell)
+    return unpickler.load()
 
 # Use the faster _pickle if possible
 try:
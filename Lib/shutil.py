@@ -5,6 +5,7 @@ XXX The functions here don't copy the resource fork or other metadata on Mac.
 """
 
 import os
+import io
 import sys
 import stat
 import fnmatch
@@ -51,6 +52,7 @@ elif _WINDOWS:
 
 COPY_BUFSIZE = 1024 * 1024 if _WINDOWS else 64 * 1024
 _USE_CP_SENDFILE = hasattr(os, "sendfile") and sys.platform.startswith("linux")
+_USE_CP_SPLICE = hasattr(os, "splice")
 _HAS_FCOPYFILE = posix and hasattr(posix, "_fcopyfile")  # macOS
 
 __all__ = ["copyfileobj", "copyfile", "copymode", "copystat", "copy", "copy2",
@@ -168,6 +170,46 @@ def _fastcopy_sendfile(fsrc, fdst):
                 break  # EOF
             offset += sent
 
+def _fastcopy_splice(fsrc, fdst, length):
+    """Copy data between two unbuffered binary files, one of which is a
+    pipe, by using the zero-copy splice(2) syscall (Linux).
+    """
+    # Unlike in _fastcopy_sendfile(), fsrc and fdst may have been opened
+    # by the caller: only io.FileIO objects are handled, since other file
+    # objects may hide data in a buffer or transform it.
+    if not (fsrc.readable() and fdst.writable()):
+        # Let read() or write() raise io.UnsupportedOperation
+        raise _GiveupOnFastCopy("wrong file mode")
+    try:
+        infd = fsrc.fileno()
+        outfd = fdst.fileno()
+        if not (stat.S_ISFIFO(os.fstat(infd).st_mode) or
+                stat.S_ISFIFO(os.fstat(outfd).st_mode)):
+            raise _GiveupOnFastCopy("neither file is a pipe")
+        # read() and write() return None instead of raising
+        # BlockingIOError on non-blocking files
+        if not (os.get_blocking(infd) and os.get_blocking(outfd)):
+            raise _GiveupOnFastCopy("non-blocking file")
+    except OSError as err:
+        raise _GiveupOnFastCopy(err)
+
+    copied = 0
+    while True:
+        try:
+            n = os.splice(infd, outfd, length)
+        except OSError as err:
+            # ...in order to have a more informative exception.
+            err.filename = fsrc.name
+            err.filename2 = fdst.name
+            # e.g. fdst open in "a"(ppend) mode, or a file system which
+            # does not support splice()
+            if copied == 0 and err.errno == errno.EINVAL:
+                raise _GiveupOnFastCopy(err)
+            raise err
+        if n == 0:
+            break  # EOF
+        copied += n
+
 def _copyfileobj_readinto(fsrc, fdst, length=COPY_BUFSIZE):
     """readinto()/memoryview() based variant of copyfileobj().
     *fsrc* must support readinto() method and both files must be
@@ -192,6 +234,14 @@ def copyfileobj(fsrc, fdst, length=0):
     # Localize variable access to minimize overhead.
     if not length:
         length = COPY_BUFSIZE
+    # Linux
+    if (_USE_CP_SPLICE and type(fsrc) is io.FileIO and
+            type(fdst) is io.FileIO):
+        try:
+            _fastcopy_splice(fsrc, fdst, length if length > 0 else COPY_BUFSIZE)
+            return
+        except _GiveupOnFastCopy:
+            pass
     fsrc_read = fsrc.read
     fdst_write = fdst.write
     while True:
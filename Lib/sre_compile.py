@@ -489,6 +489,42 @@ def _get_literal_prefix(pattern, flags):
         return prefix, prefix_skip, True
     return prefix, prefix_skip, False
 
+def _get_sequence(pattern):
+    # iterate over the items matched one after the other by the pattern,
+    # including those of the groups which don't change the flags
+    for op, av in pattern.data:
+        if op is SUBPATTERN and not av[1] and not av[2]:
+            yield from _get_sequence(av[3])
+        else:
+            yield op, av
+
+def _get_required_literal(pattern, flags):
+    # look for the longest literal string which every match contains
+    # further than its start (which is the literal prefix), and for the
+    # bounds of its offset from the start of the match
+    required = []
+    required_lo = required_hi = 0
+    run = None
+    lo = hi = 0
+    iscased = _get_iscased(flags)
+    for op, av in _get_sequence(pattern):
+        if op is LITERAL and not (iscased and iscased(av)):
+            if run is None:
+                run = []
+                run_lo, run_hi = lo, hi
+            run.append(av)
+            if len(run) > len(required) and run_hi:
+                required, required_lo, required_hi = run, run_lo, run_hi
+            lo += 1
+            hi += 1
+        else:
+            run = None
+            l, h = sre_parse.SubPattern(pattern.state, [(op, av)]).getwidth()
+            lo += l
+            hi += h
+        hi = min(hi, MAXREPEAT)
+    return required, min(required_lo, MAXCODE), required_hi
+
 def _get_charset_prefix(pattern, flags):
     while True:
         if not pattern.data:
@@ -547,12 +583,17 @@ def _compile_info(code, pattern, flags):
     prefix = []
     prefix_skip = 0
     charset = [] # not used
+    required = []
     if not (flags & SRE_FLAG_IGNORECASE and flags & SRE_FLAG_LOCALE):
         # look for literal prefix
         prefix, prefix_skip, got_all = _get_literal_prefix(pattern, flags)
         # if no prefix, look for charset prefix
         if not prefix:
             charset = _get_charset_prefix(pattern, flags)
+        # look for a literal found further in every match, which can be
+        # searched for before trying to match
+        required, required_lo, required_hi = _get_required_literal(pattern,
+                                                                   flags)
 ##     if prefix:
 ##         print("*** PREFIX", prefix, prefix_skip)
 ##     if charset:
@@ -569,6 +610,8 @@ def _compile_info(code, pattern, flags):
             mask = mask | SRE_INFO_LITERAL
     elif charset:
         mask = mask | SRE_INFO_CHARSET
+    if required:
+        mask = mask | SRE_INFO_REQUIRED
     emit(mask)
     # pattern length
     if lo < MAXCODE:
@@ -577,6 +620,12 @@ def _compile_info(code, pattern, flags):
         emit(MAXCODE)
         prefix = prefix[:MAXCODE]
     emit(min(hi, MAXCODE))
+    # add required literal
+    if required:
+        emit(len(required))
+        emit(required_lo) # offset bounds
+        emit(required_hi)
+        code.extend(required)
     # add literal prefix
     if prefix:
         emit(len(prefix)) # length
@@ -731,10 +780,22 @@ def dis(code):
                     max = 'MAXREPEAT'
                 print_(op, skip, bin(flags), min, max, to=i+skip)
                 start = i+4
+                if flags & SRE_INFO_REQUIRED:
+                    required_len, required_lo, required_hi = \
+                        code[start: start+3]
+                    if required_hi == MAXREPEAT:
+                        required_hi = 'MAXREPEAT'
+                    print_2('  required_offset', required_lo, required_hi)
+                    start += 3
+                    required = code[start: start+required_len]
+                    print_2('  required',
+                            '[%s]' % ', '.join('%#02x' % x for x in required),
+                            '(%r)' % ''.join(map(chr, required)))
+                    start += required_len
                 if flags & SRE_INFO_PREFIX:
-                    prefix_len, prefix_skip = code[i+4: i+6]
+                    prefix_len, prefix_skip = code[start: start+2]
                     print_2('  prefix_skip', prefix_skip)
-                    start = i + 6
+                    start += 2
                     prefix = code[start: start+prefix_len]
                     print_2('  prefix',
                             '[%s]' % ', '.join('%#02x' % x for x in prefix),
@@ -2030,6 +2030,28 @@ class AbstractPickleTests(unittest.TestCase):
             else:
                 self.assertTrue(num_setitems >= 2)
 
+    def test_homogeneous_containers(self):
+        ints = [0, 1, -1, 255, 256, 65535, 65536, 2**30 - 1, -2**30 + 1,
+                2**30, -2**30, 2**31, 2**63, -2**255, 2**256]
+        ints += list(range(-1500, 1500, 7))
+        floats = [0.0, -0.0, 1.5, -1e300, float('inf')] * 300
+        strs = [str(i) for i in range(2500)] + ['\u20ac', '', 'x' * 300]
+        shared = 'shared' + str(len(strs))
+        objs = [ints, floats, strs, ints + floats + strs,
+                dict(zip(strs, ints * 200)), dict(zip(ints, floats)),
+                [{'key': i, 'value': str(i)} for i in range(100)]]
+        for proto in protocols:
+            for x in objs:
+                y = self.loads(self.dumps(x, proto))
+                self.assert_is_copy(x, y)
+            # A str the container shares with others is pickled once
+            x = [shared, str(proto), {shared: shared}, [shared]]
+            y = self.loads(self.dumps(x, proto))
+            self.assert_is_copy(x, y)
+            self.assertIs(y[0], list(y[2])[0])
+            self.assertIs(y[0], y[2][y[0]])
+            self.assertIs(y[0], y[3][0])
+
     def test_set_chunking(self):
         n = 10  # too small to chunk
         x = set(range(n))
@@ -3177,6 +3199,85 @@ class AbstractPickleModuleTests(unittest.TestCase):
 
         self.check_dumps_loads_oob_buffers(dumps, loads)
 
+    def check_zerocopy_view(self, view, source, readonly):
+        self.assertIsInstance(view, memoryview)
+        self.assertIs(view.obj, source)
+        self.assertEqual(view.readonly, readonly)
+
+    def test_loads_zerocopy(self):
+        big = bytes(range(256)) * 1000
+        obj = [b'abc', bytearray(b'xyz'), big, bytearray(big), 'str', []]
+        for proto in range(3, pickle.HIGHEST_PROTOCOL + 1):
+            data = self.dumps(obj, proto)
+            for source in (data, bytearray(data)):
+                with self.subTest(proto=proto, source=type(source)):
+                    new = self.loads(source, zerocopy=True)
+                    self.assertEqual(new, obj)
+                    # Only large bytearray objects are pickled with
+                    # BYTEARRAY8, bytes objects up to 4 GiB with BINBYTES
+                    self.assertEqual([type(x) for x in new[:3]],
+                                     [bytes, bytearray, bytes])
+                    if proto >= 5:
+                        self.check_zerocopy_view(new[3], source,
+                                                 isinstance(source, bytes))
+                    else:
+                        self.assertIs(type(new[3]), bytearray)
+                    self.assertIs(type(self.loads(source)[3]), bytearray)
+            with self.subTest(proto=proto):
+                with self.assertRaises(pickle.UnpicklingError):
+                    self.loads(self.dumps(bytearray(big), 5)[:-10],
+                               zerocopy=True)
+        # Protocols without bytes opcodes still return copies
+        data = self.dumps(obj, 2)
+        self.assertEqual(self.loads(data, zerocopy=True), obj)
+
+    def test_loads_zerocopy_binbytes8(self):
+        # BINBYTES8 is only used for bytes objects larger than 4 GiB
+        for payload in (b'x' * 100000, b'abc'):
+            data = (pickle.PROTO + b'\x04' + pickle.BINBYTES8 +
+                    struct.pack('<Q', len(payload)) + payload + pickle.STOP)
+            for source in (data, bytearray(data)):
+                with self.subTest(size=len(payload), source=type(source)):
+                    new = self.loads(source, zerocopy=True)
+                    self.assertEqual(new, payload)
+                    if len(payload) < 64 * 1024:
+                        self.assertIs(type(new), bytes)
+                    else:
+                        self.check_zerocopy_view(new, source, True)
+
+    def test_loads_zerocopy_reduce(self):
+        # Small bytes objects passed to constructors are not views
+        import array
+        import datetime
+        objs = [datetime.date(2020, 1, 2),
+                datetime.datetime(2020, 1, 2, 3, 4, 5, 6),
+                datetime.time(1, 2, 3),
+                array.array('i', range(10)),
+                array.array('d', range(100000)),
+                bytearray(b'x' * 100000)]
+        for proto in range(3, pickle.HIGHEST_PROTOCOL + 1):
+            with self.subTest(proto=proto):
+                data = self.dumps(objs, proto)
+                self.assertEqual(self.loads(data, zerocopy=True), objs)
+
+    def test_loads_zerocopy_mmap(self):
+        import mmap
+        obj = [b'x' * 100000, bytearray(b'y' * 100000)]
+        self.addCleanup(support.unlink, TESTFN)
+        with open(TESTFN, 'wb') as f:
+            f.write(self.dumps(obj, 5))
+        with open(TESTFN, 'r+b') as f:
+            m = mmap.mmap(f.fileno(), 0)
+        new = self.loads(m, zerocopy=True)
+        self.assertEqual(new, obj)
+        self.check_zerocopy_view(new[1], m, False)
+        # Writing through a bytearray view writes to the mapping
+        new[1][0] = ord('z')
+        self.assertIn(b'zyy', m[:])
+        self.assertRaises(BufferError, m.close)
+        del new
+        m.close()
+
 
 class AbstractPersistentPicklerTests(unittest.TestCase):
 
@@ -213,6 +213,38 @@ class BaseTest:
                 if loc != -1:
                     self.assertEqual(i[loc:loc+len(j)], j)
 
+    def test_find_periodic_pattern(self):
+        # Periodic needles match partially at most positions of a periodic
+        # text: the search switches to a linear time algorithm
+        def reference(text, pattern):
+            return [i for i in range(len(text) - len(pattern) + 1)
+                    if text.startswith(pattern, i)]
+
+        for k in (1, 5, 20, 40, 100):
+            for pattern, text in [
+                    ('a' * k + 'b' + 'a' * k, 'a' * 3000),
+                    ('a' * k + 'b' + 'a' * k, ('a' * k + 'b') * 50),
+                    ('ab' * k + 'b', 'ab' * 1500 + 'b' + 'ab' * 20),
+                    ('aab' * k, 'aab' * 1000 + 'ab' + 'aab' * 20),
+                    ('abc' * k + 'ab', 'abc' * 1000 + 'ab' + 'abc' * k)]:
+                positions = reference(text, pattern)
+                pattern = self.fixtype(pattern)
+                text = self.fixtype(text)
+                self.assertEqual(text.find(pattern),
+                                 positions[0] if positions else -1)
+                self.assertEqual(text.rfind(pattern),
+                                 positions[-1] if positions else -1)
+                self.assertEqual(text.find(pattern, 7),
+                                 next((i for i in positions if i >= 7), -1))
+                # count() does not count overlapping matches
+                count = 0
+                end = 0
+                for i in positions:
+                    if i >= end:
+                        count += 1
+                        end = i + len(pattern)
+                self.assertEqual(text.count(pattern), count)
+
     def test_rfind(self):
         self.checkequal(9,  'abcdefghiabc', 'rfind', 'abc')
         self.checkequal(12, 'abcdefghiabc', 'rfind', '')
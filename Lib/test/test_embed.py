@@ -347,6 +347,8 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
         'show_alloc_count': 0,
         'dump_refs': 0,
         'malloc_stats': 0,
+        'pymalloc_arena_size': 0,
+        'pymalloc_hugepages': 0,
 
         'filesystem_encoding': GET_DEFAULT_CONFIG,
         'filesystem_errors': GET_DEFAULT_CONFIG,
@@ -690,6 +692,7 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
             'show_ref_count': 1,
             'show_alloc_count': 1,
             'malloc_stats': 1,
+            'pymalloc_arena_size': 1024 * 1024,
 
             'stdio_encoding': 'iso8859-1',
             'stdio_errors': 'replace',
@@ -740,6 +743,8 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
             'tracemalloc': 2,
             'import_time': 1,
             'malloc_stats': 1,
+            'pymalloc_arena_size': 512 * 1024,
+            'pymalloc_hugepages': 1,
             'inspect': 1,
             'optimization_level': 2,
             'pythonpath_env': '/my/path',
@@ -767,6 +772,8 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
             'tracemalloc': 2,
             'import_time': 1,
             'malloc_stats': 1,
+            'pymalloc_arena_size': 512 * 1024,
+            'pymalloc_hugepages': 1,
             'inspect': 1,
             'optimization_level': 2,
             'pythonpath_env': '/my/path',
@@ -4,13 +4,14 @@ import sys
 import os
 import io
 import errno
+import threading
 import unittest
 from array import array
 from weakref import proxy
 from functools import wraps
 
 from test.support import (TESTFN, TESTFN_UNICODE, check_warnings, run_unittest,
-                          make_bad_fd, cpython_only, swap_attr)
+                          make_bad_fd, cpython_only, swap_attr, start_threads)
 from collections import UserList
 
 import _io  # C implementation of io
@@ -121,6 +122,74 @@ class AutoFileTests:
         self.assertEqual(a, array('I', b'\x01\x02\x00\xffefgh'))
         self.assertEqual(n, 4)
 
+    @unittest.skipUnless(hasattr(os, 'pread'), 'requires os.pread()')
+    def testReadvAt(self):
+        data = bytes(range(256)) * 40
+        self.f.write(data)
+        self.f.close()
+
+        with self.FileIO(TESTFN, 'r') as f:
+            f.seek(7)
+            # more reads than fit in a single submission
+            offsets = [(i * 97) % len(data) for i in range(200)]
+            buffers = [bytearray(i % 50) for i in range(200)]
+            sizes = f.readv_at(offsets, buffers)
+            self.assertEqual(sizes, [len(b) for b in buffers])
+            for offset, b in zip(offsets, buffers):
+                self.assertEqual(b, data[offset:offset + len(b)])
+            self.assertEqual(f.tell(), 7)
+
+            m = memoryview(bytearray(8)).cast('H', shape=[2, 2])
+            a = array('b', b'xyz')
+            b = bytearray(b'abcdef')
+            sizes = f.readv_at((3, len(data) - 2, len(data) + 5), [m, a, b])
+            self.assertEqual(sizes, [8, 2, 0])
+            self.assertEqual(bytes(m), data[3:11])
+            self.assertEqual(a.tobytes(), data[-2:] + b'z')
+            self.assertEqual(b, b'abcdef')
+            self.assertEqual(f.readv_at([], []), [])
+
+            self.assertRaises(ValueError, f.readv_at, [0, 1], [bytearray(1)])
+            self.assertRaises(ValueError, f.readv_at, [-1], [bytearray(1)])
+            self.assertRaises(TypeError, f.readv_at, [0.0], [bytearray(1)])
+            self.assertRaises((TypeError, BufferError),
+                              f.readv_at, [0], [b'x'])
+
+        with self.FileIO(TESTFN, 'w') as f:
+            self.assertRaises((ValueError, io.UnsupportedOperation),
+                              f.readv_at, [0], [bytearray(1)])
+        self.assertRaises(ValueError, f.readv_at, [0], [bytearray(1)])
+
+        r, w = os.pipe()
+        with self.FileIO(r, 'r') as f, self.FileIO(w, 'w') as g:
+            g.write(b'abc')
+            with self.assertRaises(OSError) as cm:
+                f.readv_at([0, 1], [bytearray(1), bytearray(1)])
+            self.assertEqual(cm.exception.errno, errno.ESPIPE)
+
+    @unittest.skipUnless(hasattr(os, 'pread'), 'requires os.pread()')
+    def testReadvAtThreads(self):
+        # Threads reading concurrently don't share their reads
+        data = bytes(range(256)) * 40
+        self.f.write(data)
+        self.f.close()
+
+        def read(f, start, results):
+            offsets = [(start + i * 97) % len(data) for i in range(100)]
+            buffers = [bytearray(i % 50) for i in range(100)]
+            for _ in range(20):
+                f.readv_at(offsets, buffers)
+                results.append(all(b == data[offset:offset + len(b)]
+                                   for offset, b in zip(offsets, buffers)))
+
+        results = []
+        with self.FileIO(TESTFN, 'r') as f:
+            threads = [threading.Thread(target=read, args=(f, i, results))
+                       for i in range(4)]
+            with start_threads(threads):
+                pass
+        self.assertEqual(results, [True] * 80)
+
     def testWritelinesList(self):
         l = [b'123', b'456']
         self.f.writelines(l)
@@ -740,10 +740,18 @@ class GCTests(unittest.TestCase):
         for st in stats:
             self.assertIsInstance(st, dict)
             self.assertEqual(set(st),
-                             {"collected", "collections", "uncollectable"})
+                             {"collected", "collections", "uncollectable",
+                              "examined", "time", "unreachable_time",
+                              "finalize_time", "max_time", "pauses"})
             self.assertGreaterEqual(st["collected"], 0)
             self.assertGreaterEqual(st["collections"], 0)
             self.assertGreaterEqual(st["uncollectable"], 0)
+            self.assertGreaterEqual(st["examined"], 0)
+            self.assertGreaterEqual(st["unreachable_time"], 0)
+            self.assertGreaterEqual(st["finalize_time"], 0)
+            self.assertGreaterEqual(st["time"], st["max_time"])
+            self.assertIsInstance(st["pauses"], tuple)
+            self.assertEqual(sum(st["pauses"]), st["collections"])
         # Check that collection counts are incremented correctly
         if gc.isenabled():
             self.addCleanup(gc.enable)
@@ -760,12 +768,100 @@ class GCTests(unittest.TestCase):
         self.assertEqual(new[1]["collections"], old[1]["collections"])
         self.assertEqual(new[2]["collections"], old[2]["collections"] + 1)
 
+    def test_get_stats_times(self):
+        if gc.isenabled():
+            self.addCleanup(gc.enable)
+            gc.disable()
+        gc.collect()
+        old = gc.get_stats()[2]
+        l = []
+        l.append(l)
+        del l
+        n = len(gc.get_objects())
+        self.assertEqual(gc.collect(2), 1)
+        new = gc.get_stats()[2]
+        self.assertEqual(new["collected"], old["collected"] + 1)
+        self.assertGreater(new["collections"], old["collections"])
+        self.assertGreaterEqual(new["examined"], old["examined"] + n)
+        # A fast collection can take zero ticks of a coarse clock
+        self.assertGreaterEqual(new["time"], old["time"])
+        self.assertGreaterEqual(new["unreachable_time"],
+                                old["unreachable_time"])
+        self.assertGreaterEqual(new["finalize_time"], old["finalize_time"])
+        self.assertGreaterEqual(new["time"] - old["time"],
+                                new["unreachable_time"]
+                                - old["unreachable_time"])
+        self.assertGreaterEqual(new["max_time"], old["max_time"])
+        # The collection is counted in one bucket of the histogram
+        diff = [b - a for a, b in zip(old["pauses"], new["pauses"])]
+        self.assertEqual(max(diff), 1)
+        self.assertEqual(sum(diff), 1)
+
     def test_freeze(self):
         gc.freeze()
         self.assertGreater(gc.get_freeze_count(), 0)
         gc.unfreeze()
         self.assertEqual(gc.get_freeze_count(), 0)
 
+    def test_incremental_settings(self):
+        old = gc.get_incremental()
+        self.addCleanup(gc.set_incremental, *old)
+        self.assertEqual(old, (0, 10))
+        gc.set_incremental(1000)
+        self.assertEqual(gc.get_incremental(), (1000, 10))
+        gc.set_incremental(500, 0)
+        self.assertEqual(gc.get_incremental(), (500, 0))
+        self.assertRaises(ValueError, gc.set_incremental, -1)
+        self.assertRaises(ValueError, gc.set_incremental, 1000, -1)
+        self.assertRaises(TypeError, gc.set_incremental, 1.5)
+        self.assertEqual(gc.get_incremental(), (500, 0))
+
+    def test_incremental(self):
+        class A:
+            pass
+
+        def churn(done):
+            # Create long lived objects to trigger collections of the
+            # oldest generation.
+            junk = []
+            for i in range(1000000):
+                if i % 100 == 0 and done():
+                    return True
+                junk.append([])
+            return False
+
+        gc.collect()
+        cycles = []
+        for i in range(100):
+            a = A()
+            a.a = a
+            cycles.append(a)
+        # A cycle much larger than the slices
+        head = a = A()
+        for i in range(10000):
+            a.next = A()
+            a = a.next
+        a.next = head
+        small = [weakref.ref(a) for a in cycles]
+        big = weakref.ref(head)
+        # Move the cycles to the oldest generation
+        gc.collect()
+        del a, cycles, head
+
+        self.addCleanup(gc.set_threshold, *gc.get_threshold())
+        self.addCleanup(gc.set_incremental, *gc.get_incremental())
+        gc.set_threshold(100, 2, 2)
+        gc.enable()
+        try:
+            # Increments find the cycles of the oldest generation...
+            gc.set_incremental(1000, 0)
+            self.assertTrue(churn(lambda: all(r() is None for r in small)))
+            # ... and the full collections the ones larger than a slice.
+            gc.set_incremental(1000, 1)
+            self.assertTrue(churn(lambda: big() is None))
+        finally:
+            gc.disable()
+
     def test_get_objects(self):
         gc.collect()
         l = []
@@ -31,6 +31,8 @@ class TestPyTest(PyTest):
     def test_pyjson(self):
         self.assertEqual(self.json.scanner.make_scanner.__module__,
                          'json.scanner')
+        self.assertEqual(self.json.scanner.make_stream_scanner.__module__,
+                         'json.scanner')
         self.assertEqual(self.json.decoder.scanstring.__module__,
                          'json.decoder')
         self.assertEqual(self.json.encoder.encode_basestring_ascii.__module__,
@@ -41,6 +43,8 @@ class TestCTest(CTest):
         self.assertEqual(self.json.scanner.make_scanner.__module__, '_json')
         self.assertEqual(self.json.decoder.scanstring.__module__, '_json')
         self.assertEqual(self.json.encoder.c_make_encoder.__module__, '_json')
+        self.assertEqual(self.json.scanner.make_stream_scanner.__module__,
+                         '_json')
         self.assertEqual(self.json.encoder.encode_basestring_ascii.__module__,
                          '_json')
 
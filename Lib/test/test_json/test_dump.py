@@ -12,6 +12,44 @@ class TestDump:
     def test_dumps(self):
         self.assertEqual(self.dumps({}), '{}')
 
+    def test_dump_large(self):
+        obj = [{'id': i, 'name': 'n\xe9€"%d' % i, 'x': [i * 0.5, None]}
+               for i in range(20000)]
+        chunks = []
+        class Writer:
+            def write(self, chunk):
+                chunks.append(chunk)
+        self.json.dump(obj, Writer())
+        self.assertEqual(''.join(chunks), self.dumps(obj))
+        sio = StringIO()
+        self.json.dump(obj, sio, ensure_ascii=False, separators=(',', ':'))
+        self.assertEqual(sio.getvalue(),
+                         self.dumps(obj, ensure_ascii=False,
+                                    separators=(',', ':')))
+
+    def test_dump_subclass(self):
+        # dump() still uses the iterencode() of JSONEncoder subclasses
+        class Encoder(self.json.JSONEncoder):
+            def iterencode(self, o, _one_shot=False):
+                yield '"x"'
+        sio = StringIO()
+        self.json.dump([1], sio, cls=Encoder)
+        self.assertEqual(sio.getvalue(), '"x"')
+
+    def test_dumps_numbers(self):
+        class I(int):
+            def __repr__(self):
+                return 'I()'
+        class F(float):
+            def __repr__(self):
+                return 'F()'
+        nums = [0, -1, 2**63 - 1, -2**63, 2**64, -10**40, I(5),
+                1.5, -0.0, 1e300, 1e-300, F(2.5)]
+        self.assertEqual(self.dumps(nums),
+                         '[0, -1, 9223372036854775807, -9223372036854775808, '
+                         '18446744073709551616, -%d, 5, '
+                         '1.5, -0.0, 1e+300, 1e-300, 2.5]' % 10**40)
+
     def test_encode_truefalse(self):
         self.assertEqual(self.dumps(
                  {True: False, False: True}, sort_keys=True),
@@ -22,6 +22,16 @@ class TestDecode(CTest):
     def test_make_scanner(self):
         self.assertRaises(AttributeError, self.json.scanner.c_make_scanner, 1)
 
+    def test_scan_bytes(self):
+        # UTF-8 encoded buffers are scanned with indexes in bytes
+        scan_once = self.json.decoder.JSONDecoder().scan_once
+        data = '  ["\xe9", {"\u20ac": 1.5}] '.encode()
+        for obj in (data, bytearray(data), memoryview(data)):
+            self.assertEqual(scan_once(obj, 2), (['\xe9', {'\u20ac': 1.5}], 22))
+        self.assertEqual(scan_once(b'"\xc3\xa9" 12', 5), (12, 7))
+        self.assertRaises(StopIteration, scan_once, b'  ', 2)
+        self.assertRaises(TypeError, scan_once, 1, 0)
+
     def test_bad_bool_args(self):
         def test(value):
             self.json.decoder.JSONDecoder(strict=BadBool()).decode(value)
@@ -38,6 +48,20 @@ class TestEncode(CTest):
             b"\xCD\x7D\x3D\x4E\x12\x4C\xF9\x79\xD7\x52\xBA\x82\xF2\x27\x4A\x7D\xA0\xCA\x75",
             None)
 
+    def test_write_chunks(self):
+        enc = self.json.encoder.c_make_encoder(
+            None, None, self.json.encoder.encode_basestring_ascii, None,
+            ': ', ', ', False, False, True)
+        obj = [{'key': 'value \xe9'}] * 10000
+        self.assertEqual(enc(obj, 0), [self.dumps(obj)])
+        chunks = []
+        self.assertIsNone(enc(obj, 0, chunks.append))
+        self.assertGreater(len(chunks), 1)
+        self.assertEqual(''.join(chunks), self.dumps(obj))
+        def bad_write(chunk):
+            1/0
+        self.assertRaises(ZeroDivisionError, enc, obj, 0, bad_write)
+
     def test_bad_str_encoder(self):
         # Issue #31505: There shouldn't be an assertion failure in case
         # c_make_encoder() receives a bad encoder() argument.
@@ -0,0 +1,192 @@
+from io import StringIO, BytesIO
+from collections import OrderedDict
+from test.test_json import PyTest, CTest
+
+
+DOCS = [
+    '{"a": [1, 2.5, {"b": null}], "c": "x]}\\"\\\\"}',
+    '[true, false, "[", "{", []]',
+    '"a \\"quoted\\" \\u00e9 string"',
+    '-12.5e3',
+    '0',
+    'null',
+    '{}',
+    '[]',
+    '""',
+]
+STREAM = ' ' + '\n'.join(DOCS) + '\n'
+ARRAY = '[' + ', '.join(DOCS) + ']'
+
+
+class TestStream:
+    def decode_parts(self, parts, **kwargs):
+        decoder = self.json.JSONStreamDecoder(**kwargs)
+        values = []
+        for part in parts:
+            values += decoder.feed(part)
+        return values + decoder.close()
+
+    def test_values(self):
+        expected = [self.loads(doc) for doc in DOCS]
+        self.assertEqual(self.decode_parts([STREAM]), expected)
+        self.assertEqual(self.decode_parts(STREAM), expected)
+        # values may be separated by any whitespace
+        self.assertEqual(self.decode_parts(['{} []\t"a"\r1\n2 \n 3\r\n']),
+                         [{}, [], 'a', 1, 2, 3])
+
+    def test_split_everywhere(self):
+        expected = [self.loads(doc) for doc in DOCS]
+        for i in range(len(STREAM) + 1):
+            with self.subTest(i=i):
+                self.assertEqual(self.decode_parts([STREAM[:i], STREAM[i:]]),
+                                 expected)
+        expected = self.loads(ARRAY)
+        for i in range(len(ARRAY) + 1):
+            with self.subTest(i=i):
+                self.assertEqual(
+                    self.decode_parts([ARRAY[:i], ARRAY[i:]], array=True),
+                    expected)
+
+    def test_feed_returns_complete_values(self):
+        decoder = self.json.JSONStreamDecoder()
+        self.assertEqual(decoder.feed('{"a": 1} [2'), [{'a': 1}])
+        self.assertEqual(decoder.feed('] "b'), [[2]])
+        self.assertEqual(decoder.feed('\\'), [])
+        self.assertEqual(decoder.feed('"" 12'), ['b"'])
+        # a number only ends with what follows it
+        self.assertEqual(decoder.feed('3'), [])
+        self.assertEqual(decoder.close(), [123])
+        # the decoder can be reused
+        self.assertEqual(decoder.feed('true'), [])
+        self.assertEqual(decoder.close(), [True])
+
+    def test_array(self):
+        decoder = self.json.JSONStreamDecoder(array=True)
+        self.assertEqual(decoder.feed(' [1, {"a": [2'), [1])
+        self.assertEqual(decoder.feed(']}, "c", 4'), [{'a': [2]}, 'c'])
+        self.assertEqual(decoder.feed('] '), [4])
+        self.assertEqual(decoder.close(), [])
+        self.assertEqual(self.decode_parts([' [ ] '], array=True), [])
+
+    def test_decoder(self):
+        decoder = self.json.JSONDecoder(object_pairs_hook=OrderedDict,
+                                        parse_int=float)
+        stream = self.json.JSONStreamDecoder(decoder)
+        self.assertIs(stream.decoder, decoder)
+        self.assertFalse(stream.array)
+        values = stream.feed('{"b": 1, "a": 2}\n')
+        self.assertEqual(values, [OrderedDict([('b', 1.0), ('a', 2.0)])])
+        self.assertEqual(type(values[0]), OrderedDict)
+
+    def test_bytes(self):
+        expected = [self.loads(doc) for doc in DOCS]
+        for encoding in ('utf-8', 'utf-8-sig', 'utf-16', 'utf-16-le',
+                         'utf-16-be', 'utf-32', 'utf-32-le', 'utf-32-be'):
+            data = STREAM.encode(encoding)
+            with self.subTest(encoding=encoding):
+                self.assertEqual(self.decode_parts([data]), expected)
+                # one byte at a time
+                parts = [data[i:i+1] for i in range(len(data))]
+                self.assertEqual(self.decode_parts(parts), expected)
+        self.assertEqual(self.decode_parts([bytearray(b'1 2')]), [1, 2])
+        self.assertEqual(self.decode_parts([b'1']), [1])
+
+    def test_errors(self):
+        for parts, kwargs, msg in [
+            (['{"a": 1]'], {}, "Expecting ',' delimiter"),
+            (['{"a": 1'], {}, "Expecting ',' delimiter"),
+            (['"abc'], {}, 'Unterminated string'),
+            (['1 ]'], {}, 'Expecting value'),
+            (['tru '], {}, 'Expecting value'),
+            (['1.5.'], {}, 'Extra data'),
+            (['{}{}'], {}, 'Extra data'),
+            (['1"a"'], {}, 'Extra data'),
+            (['"a"1'], {}, 'Extra data'),
+            (['true[1]'], {}, 'Extra data'),
+            (['[1]', '{}'], {}, 'Extra data'),
+            (['{"a": 1}', '1'], {'array': True}, "Expecting '\\['"),
+            (['[1 2]'], {'array': True}, "Expecting ',' delimiter"),
+            (['[1,]'], {'array': True}, 'Expecting value'),
+            (['[1] 2'], {'array': True}, 'Extra data'),
+            (['[1, 2'], {'array': True}, "Expecting ',' delimiter"),
+            (['[1,'], {'array': True}, 'Expecting value'),
+        ]:
+            with self.subTest(parts=parts, kwargs=kwargs):
+                with self.assertRaisesRegex(self.JSONDecodeError, msg):
+                    self.decode_parts(parts, **kwargs)
+        with self.assertRaises(TypeError):
+            self.decode_parts([1])
+
+    def test_error_position(self):
+        # The errors are reported at their positions in the whole stream
+        for parts, kwargs, msg, pos, lineno, colno in [
+            # in a value split between parts
+            (['{"a": 1}\n{"b": 2}\n{"c"', ': 3]\n'], {},
+             "Expecting ',' delimiter", 25, 3, 8),
+            (['1\n {"a"', '\n 1}'], {}, "Expecting ':' delimiter", 9, 3, 2),
+            # between values
+            (['1\n2', ' 3}'], {}, 'Extra data', 5, 2, 4),
+            (['"\u20ac"\n"\u20ac"', '\n\u20ac}'], {},
+             'Expecting value', 8, 3, 1),
+            (['[1,\n', ' 2 3]'], {'array': True},
+             "Expecting ',' delimiter", 7, 2, 4),
+            # at the end of the stream
+            (['[1, 2]\n', '  x'], {}, 'Expecting value', 9, 2, 3),
+            (['[1,\n 2'], {'array': True}, "Expecting ',' delimiter", 6, 2, 3),
+        ]:
+            with self.subTest(parts=parts, kwargs=kwargs):
+                with self.assertRaisesRegex(self.JSONDecodeError, msg) as cm:
+                    self.decode_parts(parts, **kwargs)
+                err = cm.exception
+                self.assertEqual((err.pos, err.lineno, err.colno),
+                                 (pos, lineno, colno))
+                self.assertIn('line %d column %d (char %d)'
+                              % (lineno, colno, pos), str(err))
+
+        # The positions go on after an error, and start again with a new
+        # stream
+        decoder = self.json.JSONStreamDecoder()
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            decoder.feed('1\n}')
+        self.assertEqual((cm.exception.pos, cm.exception.lineno), (2, 2))
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            decoder.feed('\n}')
+        self.assertEqual((cm.exception.pos, cm.exception.lineno,
+                          cm.exception.colno), (4, 3, 1))
+        self.assertEqual(decoder.close(), [])
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            decoder.feed('}')
+        self.assertEqual((cm.exception.pos, cm.exception.lineno), (0, 1))
+
+    def test_error_resets(self):
+        decoder = self.json.JSONStreamDecoder()
+        self.assertRaises(self.JSONDecodeError, decoder.feed, '[1, } "a')
+        self.assertEqual(decoder.feed('[2] '), [[2]])
+        self.assertEqual(decoder.close(), [])
+
+    def test_iterload(self):
+        expected = [self.loads(doc) for doc in DOCS]
+        for chunk_size in (1, 7, 65536):
+            with self.subTest(chunk_size=chunk_size):
+                values = self.json.iterload(StringIO(STREAM),
+                                            chunk_size=chunk_size)
+                self.assertEqual(list(values), expected)
+                values = self.json.iterload(BytesIO(STREAM.encode('utf-16')),
+                                            chunk_size=chunk_size)
+                self.assertEqual(list(values), expected)
+                values = self.json.iterload(StringIO(ARRAY), array=True,
+                                            chunk_size=chunk_size)
+                self.assertEqual(list(values), self.loads(ARRAY))
+        values = self.json.iterload(StringIO('{"a": 1.5} 2'),
+                                    parse_float=str, parse_int=str)
+        self.assertEqual(list(values), [{'a': '1.5'}, '2'])
+
+    def test_iterload_is_lazy(self):
+        fp = StringIO('[1] ' * 10)
+        values = self.json.iterload(fp, chunk_size=8)
+        self.assertEqual(next(values), [1])
+        self.assertEqual(fp.tell(), 8)
+
+
+class TestPyStream(TestStream, PyTest): pass
+class TestCStream(TestStream, CTest): pass
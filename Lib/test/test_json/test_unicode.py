@@ -79,6 +79,42 @@ class TestUnicode:
         self.assertEqual(self.loads(b'\x007'), 7)
         self.assertEqual(self.loads(b'57'), 57)
 
+    def test_utf8_bytes_decode(self):
+        # UTF-8 is scanned without decoding the document first
+        docs = [
+            '{"a\xe9": [1, -2.5e3, true, null, "€\\u00b5\\n"], '
+            '"\U0001d120": {"k": "\\ud834\\udd20\\"", "": []}}',
+            '[NaN, -Infinity, 12345678901234567890, "\\ud800", "\ud800"]',
+            ' "x\xb5" ',
+        ]
+        for doc in docs:
+            data = doc.encode('utf-8', 'surrogatepass')
+            self.assertEqual(repr(self.loads(data)), repr(self.loads(doc)))
+            self.assertEqual(repr(self.loads(bytearray(data))),
+                             repr(self.loads(doc)))
+            self.assertEqual(self.loads(data, object_pairs_hook=list),
+                             self.loads(doc, object_pairs_hook=list))
+            self.assertEqual(self.loads(data, parse_float=str, parse_int=str),
+                             self.loads(doc, parse_float=str, parse_int=str))
+        # repeated keys are the same object
+        a, b = self.loads('[{"cl\xe9": 1}, {"cl\xe9": 2}]'.encode())
+        self.assertIs(list(a)[0], list(b)[0])
+
+    def test_utf8_bytes_decode_errors(self):
+        # errors are reported in the decoded document
+        for doc in ['["\xe9€", \U0001d120]', '{"\xe9\xe9": 1 "x"}',
+                    '["\xe9\xe9\\x"]', '"\xe9\xe9', '["\xe9\x01"]',
+                    '"\xe9\xe9" 1', '€', '[1, \xe9]', '']:
+            with self.subTest(doc=doc):
+                with self.assertRaises(self.JSONDecodeError) as cm:
+                    self.loads(doc)
+                with self.assertRaises(self.JSONDecodeError) as cm2:
+                    self.loads(doc.encode())
+                self.assertEqual(str(cm2.exception), str(cm.exception))
+                self.assertEqual(cm2.exception.doc, doc)
+                self.assertEqual(cm2.exception.pos, cm.exception.pos)
+        self.assertRaises(UnicodeDecodeError, self.loads, b'{"\xff": 1}')
+
     def test_object_pairs_hook_with_unicode(self):
         s = '{"xkd":1, "kcw":2, "art":3, "hxm":4, "qrt":5, "pad":6, "hoy":7}'
         p = [("xkd", 1), ("kcw", 2), ("art", 3), ("hxm", 4),
@@ -12,6 +12,8 @@ SHIFT = sys.int_info.bits_per_digit
 BASE = 2 ** SHIFT
 MASK = BASE - 1
 KARATSUBA_CUTOFF = 70   # from longobject.c
+TOOM3_CUTOFF = 500      # from longobject.c
+BZ_DIV_CUTOFF = 40      # from longobject.c
 
 # Max number of base BASE digits to use in test cases.  Doubling
 # this will more than double the runtime.
@@ -229,6 +231,80 @@ class LongTest(unittest.TestCase):
                          1)
                     self.assertEqual(x, y)
 
+    def test_compact_arithmetic(self):
+        # Ints of at most 2 digits are added, subtracted and multiplied
+        # with machine integers: compare with results computed on larger
+        # ints, around the limits of the values and of the results.
+        big = 1 << (4 * SHIFT)
+        values = [0, 1, 2, 5, 256, 257, MASK, BASE, BASE + 1,
+                  BASE * BASE - 1, BASE * BASE - 2, BASE * BASE // 2,
+                  2**31 - 1, 2**31, 2**31 + 1, 2**32 - 1,
+                  BASE * BASE, 2**62, 2**63 - 1, 2**63, 2**64]
+        values += [-x for x in values]
+        for x in values:
+            for y in values:
+                with self.subTest(x=x, y=y):
+                    self.assertEqual(x + y, (x + big) + (y - big))
+                    self.assertEqual(x - y, (x + big) - (y + big))
+                    self.assertEqual(x * y, (x + big) * y - big * y)
+                    self.assertEqual(x * y, y * x)
+
+    def test_toom3(self):
+        digits = [TOOM3_CUTOFF - 1, TOOM3_CUTOFF, TOOM3_CUTOFF + 1,
+                  TOOM3_CUTOFF + 2, TOOM3_CUTOFF * 2, TOOM3_CUTOFF * 7]
+        bits = [digit * SHIFT for digit in digits]
+
+        # Same identity as in test_karatsuba.
+        for abits in bits:
+            a = (1 << abits) - 1
+            for bbits in bits:
+                if bbits < abits:
+                    continue
+                with self.subTest(abits=abits, bbits=bbits):
+                    b = (1 << bbits) - 1
+                    x = a * b
+                    y = ((1 << (abits + bbits)) -
+                         (1 << abits) -
+                         (1 << bbits) +
+                         1)
+                    self.assertEqual(x, y)
+
+        # Compare with the sums of the products of slices of a, which are
+        # too small for Toom-Cook, by b.
+        def slices_mul(a, b):
+            width = (TOOM3_CUTOFF - 1) * SHIFT
+            result = 0
+            for digit in range(0, abs(a).bit_length(), width):
+                result += ((abs(a) >> digit) & ((1 << width) - 1)) * b << digit
+            return -result if a < 0 else result
+        for adigits in digits:
+            for bdigits in digits:
+                with self.subTest(adigits=adigits, bdigits=bdigits):
+                    a = self.getran(adigits)
+                    b = self.getran(bdigits)
+                    self.assertEqual(a * b, slices_mul(a, b))
+                    self.assertEqual(a * a, slices_mul(a, a))
+
+    def test_burnikel_ziegler(self):
+        digits = [BZ_DIV_CUTOFF - 1, BZ_DIV_CUTOFF, BZ_DIV_CUTOFF + 1,
+                  BZ_DIV_CUTOFF + 2, BZ_DIV_CUTOFF * 3 + 1, BZ_DIV_CUTOFF * 10,
+                  BZ_DIV_CUTOFF * 33]
+        for ydigits in digits:
+            for qdigits in digits:
+                x = self.getran(ydigits + qdigits)
+                y = self.getran(ydigits)
+                self.check_division(x, y)
+                # Quotients made of BASE-1 digits take a special case of
+                # the recursion.
+                y = abs(y)
+                for x in ((y << (qdigits * SHIFT)) - 1,
+                          (y << (qdigits * SHIFT)) - y,
+                          y << (qdigits * SHIFT)):
+                    self.check_division(x, y)
+                    self.check_division(-x, y)
+                y = (1 << (ydigits * SHIFT)) - 1
+                self.check_division((y << (qdigits * SHIFT)) - 1, y)
+
     def check_bitop_identities_1(self, x):
         eq = self.assertEqual
         with self.subTest(x=x):
@@ -394,6 +470,49 @@ class LongTest(unittest.TestCase):
                 return 1729
         self.assertEqual(int(LongTrunc()), 1729)
 
+    def check_decimal_conversion(self, s):
+        # Compare the conversions of the decimal string s with results
+        # computed from chunks of 100 digits, which are small enough to be
+        # converted with the schoolbook algorithms.
+        n = 0
+        for i in range(0, len(s), 100):
+            chunk = s[i:i+100]
+            n = n * 10**len(chunk) + int(chunk)
+        self.assertEqual(int(s), n)
+        self.assertEqual(int('-' + s), -n)
+        chunks = []
+        m = n
+        while m >= 10**100:
+            m, r = divmod(m, 10**100)
+            chunks.append('%0100d' % r)
+        chunks.append(str(m))
+        expected = ''.join(reversed(chunks))
+        self.assertEqual(str(n), expected)
+        self.assertEqual(str(-n), '-' + expected)
+
+    def test_large_decimal_conversion(self):
+        # Large ints are converted to and from decimal strings with
+        # divide-and-conquer algorithms: check sizes around their cutoffs.
+        rng = random.Random(1729)
+        for ndigits in (6900, 7000, 7100, 11000, 11500, 12000, 60000):
+            with self.subTest(ndigits=ndigits):
+                s = str(rng.randrange(1, 10)) + ''.join(
+                    rng.choice('0123456789') for _ in range(ndigits - 1))
+                self.check_decimal_conversion(s)
+                # Runs of zeros and nines stress the carries and the
+                # zero padding of the lower halves
+                self.check_decimal_conversion('1' + '0' * ndigits)
+                self.check_decimal_conversion('9' * ndigits)
+                self.check_decimal_conversion(
+                    '1' + '0' * (ndigits // 2) + '1' + '0' * (ndigits // 2))
+                self.assertEqual(int('1' + '0' * ndigits), 10**ndigits)
+                self.assertEqual(str(10**ndigits - 1), '9' * ndigits)
+        s = '1234567_89' * 1000
+        self.assertEqual(int(s), int(s.replace('_', '')))
+        self.assertEqual(int('0' * 20000 + '42'), 42)
+        self.assertRaises(ValueError, int, '1' * 10000 + 'x')
+        self.assertRaises(ValueError, int, '1' * 10000 + '__1')
+
     def check_float_conversion(self, n):
         # Check that int -> float conversion behaviour matches
         # that of the pure Python version above.
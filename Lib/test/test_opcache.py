@@ -0,0 +1,496 @@
+"""Tests for the per-instruction opcode cache and the specialized
+instructions of the eval loop.
+
+The cache and the quickened bytecode of a code object are only created after
+it was executed a number of times (and never on debug builds), so each test
+runs a small function in a loop before changing the objects it accesses.
+"""
+
+import unittest
+
+# More than OPCACHE_MIN_RUNS in Python/ceval.c
+WARMUP = 1100
+
+
+class LoadAttrTests(unittest.TestCase):
+
+    def test_instance_dict(self):
+        class A:
+            def __init__(self, x):
+                self.x = x
+
+        def f(o):
+            return o.x
+
+        objs = [A(i) for i in range(10)]
+        for i in range(WARMUP):
+            self.assertEqual(f(objs[i % 10]), i % 10)
+
+        # The attribute is stored at another position in the dict
+        o = A(1)
+        del o.x
+        o.y = 2
+        o.x = 3
+        self.assertEqual(f(o), 3)
+
+        # The attribute is missing
+        del o.x
+        self.assertRaises(AttributeError, f, o)
+
+        # The instance dict is replaced
+        o.__dict__ = {'x': 5}
+        self.assertEqual(f(o), 5)
+
+    def test_type_modified(self):
+        class A:
+            def __init__(self):
+                self.x = 1
+
+        def f(o):
+            return o.x
+
+        o = A()
+        for _ in range(WARMUP):
+            self.assertEqual(f(o), 1)
+
+        # A data descriptor takes precedence over the instance dict
+        A.x = property(lambda self: 42)
+        self.assertEqual(f(o), 42)
+        del A.x
+        self.assertEqual(f(o), 1)
+
+    def test_class_attribute(self):
+        class A:
+            x = 0
+
+        def f(o):
+            return o.x
+
+        o = A()
+        o.x = 1
+        for _ in range(WARMUP):
+            self.assertEqual(f(o), 1)
+        del o.x
+        self.assertEqual(f(o), 0)
+
+    def test_slots(self):
+        class A:
+            __slots__ = ('x',)
+
+        def f(o):
+            return o.x
+
+        o = A()
+        o.x = 1
+        for _ in range(WARMUP):
+            self.assertEqual(f(o), 1)
+        o.x = 2
+        self.assertEqual(f(o), 2)
+        del o.x
+        self.assertRaises(AttributeError, f, o)
+
+    def test_polymorphic(self):
+        class A:
+            __slots__ = ('x',)
+
+        class B:
+            pass
+
+        def f(o):
+            return o.x
+
+        a = A()
+        a.x = 1
+        b = B()
+        b.x = 2
+        for _ in range(WARMUP):
+            self.assertEqual(f(a), 1)
+            self.assertEqual(f(b), 2)
+            self.assertRaises(AttributeError, f, object())
+
+    def test_dict_replaced_during_lookup(self):
+        class A:
+            pass
+
+        class Value:
+            def __del__(self):
+                deleted.append(True)
+
+        class Key(str):
+            __hash__ = str.__hash__
+
+            def __eq__(self, other):
+                # Replace and free the dict being looked up
+                o.__dict__ = {}
+                return True
+
+        def f(o):
+            return o.x
+
+        o = A()
+        o.x = 1
+        for _ in range(WARMUP):
+            self.assertEqual(f(o), 1)
+
+        # The value is only referenced by the dict, which must be kept
+        # alive until the value is returned
+        deleted = []
+        o.__dict__ = {Key('x'): Value()}
+        v = f(o)
+        self.assertEqual(deleted, [])
+        self.assertIsInstance(v, Value)
+        self.assertEqual(o.__dict__, {})
+        del v
+        self.assertEqual(deleted, [True])
+
+
+class StoreAttrTests(unittest.TestCase):
+
+    def test_instance_dict(self):
+        class A:
+            def __init__(self):
+                self.x = 0
+                self.y = 0
+
+        def f(o, v):
+            o.x = v
+
+        objs = [A() for _ in range(10)]
+        for i in range(WARMUP):
+            f(objs[i % 10], i)
+        self.assertEqual([o.x for o in objs],
+                         list(range(WARMUP - 10, WARMUP)))
+
+        # The instance dict layout differs from the other instances
+        o = A()
+        del o.x
+        f(o, 5)
+        self.assertEqual(o.__dict__, {'y': 0, 'x': 5})
+
+        # A data descriptor takes precedence over the instance dict
+        values = []
+        A.x = property(lambda self: 0, lambda self, v: values.append(v))
+        f(o, 6)
+        self.assertEqual(values, [6])
+        self.assertEqual(o.__dict__, {'y': 0, 'x': 5})
+
+    def test_init(self):
+        class A:
+            def __init__(self, x, y):
+                self.x = x
+                self.y = y
+
+        objs = [A(i, -i) for i in range(WARMUP)]
+        self.assertEqual([(o.x, o.y) for o in objs[-3:]],
+                         [(i, -i) for i in range(WARMUP - 3, WARMUP)])
+        # Instances still share the keys of their dicts
+        self.assertEqual(list(objs[-1].__dict__), ['x', 'y'])
+        objs[-1].__dict__ = {}
+        objs[-1].__init__(1, 2)
+        self.assertEqual(objs[-1].__dict__, {'x': 1, 'y': 2})
+
+    def test_slots(self):
+        class A:
+            __slots__ = ('x',)
+
+        def f(o, v):
+            o.x = v
+
+        o = A()
+        for i in range(WARMUP):
+            f(o, i)
+            self.assertEqual(o.x, i)
+        del o.x
+        f(o, 'a')
+        self.assertEqual(o.x, 'a')
+
+
+class LoadMethodTests(unittest.TestCase):
+
+    def test_method(self):
+        class A:
+            def m(self):
+                return 1
+
+        def f(o):
+            return o.m()
+
+        o = A()
+        for _ in range(WARMUP):
+            self.assertEqual(f(o), 1)
+
+        # The instance dict shadows the method
+        o.m = lambda: 2
+        self.assertEqual(f(o), 2)
+        del o.m
+        self.assertEqual(f(o), 1)
+
+        # The method is replaced on the class
+        A.m = lambda self: 3
+        self.assertEqual(f(o), 3)
+
+        # The method is replaced on a base class
+        class B(A):
+            pass
+        b = B()
+        for _ in range(WARMUP):
+            self.assertEqual(f(b), 3)
+        A.m = lambda self: 4
+        self.assertEqual(f(b), 4)
+
+    def test_builtin_method(self):
+        def f(o):
+            return o.count(1)
+
+        for _ in range(WARMUP):
+            self.assertEqual(f([1, 2, 1]), 2)
+        self.assertEqual(f((1, 2)), 1)
+
+
+class SpecializationTests(unittest.TestCase):
+
+    def test_binary_add(self):
+        def f(a, b):
+            return a + b
+
+        for i in range(WARMUP):
+            self.assertEqual(f(i, 1), i + 1)
+        self.assertEqual(f(-2**30, -2**30), -2**31)
+        self.assertEqual(f(2**100, 1), 2**100 + 1)
+        self.assertEqual(f(True, True), 2)
+        # Deoptimized
+        self.assertEqual(f(1.5, 1), 2.5)
+        self.assertEqual(f('a', 'b'), 'ab')
+        self.assertEqual(f(2, 3), 5)
+
+        def g(a, b):
+            return a + b
+
+        for i in range(WARMUP):
+            self.assertEqual(g(0.5, 0.25), 0.75)
+        self.assertEqual(g(float('inf'), 1.0), float('inf'))
+        self.assertEqual(g(1.0, 1), 2.0)
+        self.assertEqual(g([1], [2]), [1, 2])
+
+        def h(a, b):
+            a = a + b
+            return a
+
+        for i in range(WARMUP):
+            self.assertEqual(h('x', 'y'), 'xy')
+        self.assertEqual(h((1,), (2,)), (1, 2))
+
+    def test_compare_op(self):
+        def f(a, b):
+            return (a < b, a <= b, a == b, a != b, a > b, a >= b)
+
+        def expected(a, b):
+            return (a < b, a <= b, a == b, a != b, a > b, a >= b)
+
+        for i in range(WARMUP):
+            self.assertEqual(f(i, 500), expected(i, 500))
+        for a, b in [(2**100, 2**100), (-2**100, 1), (1, True), (1.5, 1),
+                     (-1, 0), (0, 0)]:
+            self.assertEqual(f(a, b), expected(a, b))
+
+        def g(a, b):
+            return (a < b, a <= b, a == b, a != b, a > b, a >= b)
+
+        nan = float('nan')
+        for i in range(WARMUP):
+            self.assertEqual(g(i / 3, 100.0), expected(i / 3, 100.0))
+        self.assertEqual(g(nan, nan), expected(nan, nan))
+        self.assertEqual(g(nan, 1.0), expected(nan, 1.0))
+        self.assertEqual(g(1.0, 1), expected(1.0, 1))
+
+        def h(a, b):
+            return (a < b, a <= b, a == b, a != b, a > b, a >= b)
+
+        for i in range(WARMUP):
+            self.assertEqual(h(str(i), '500'), expected(str(i), '500'))
+        self.assertEqual(h('\U0001f600', 'a'), expected('\U0001f600', 'a'))
+        self.assertEqual(h('abc', 'abc'), expected('abc', 'abc'))
+        try:
+            from _testcapi import unicode_legacy_string
+        except ImportError:
+            pass
+        else:
+            # Strings which are not ready yet
+            for a, b in [('abc', 'abd'), ('abc', 'abc'), ('\xe9', 'e')]:
+                self.assertEqual(h(unicode_legacy_string(a),
+                                   unicode_legacy_string(b)),
+                                 expected(a, b))
+        self.assertRaises(TypeError, h, 'a', 1)
+
+    def test_binary_subscr(self):
+        def f(container, index):
+            return container[index]
+
+        l = list(range(10))
+        for i in range(WARMUP):
+            self.assertEqual(f(l, i % 10), i % 10)
+        self.assertEqual(f(l, -1), 9)
+        self.assertEqual(f(l, -10), 0)
+        self.assertRaises(IndexError, f, l, 10)
+        self.assertRaises(IndexError, f, l, -11)
+        self.assertRaises(IndexError, f, l, 2**100)
+        self.assertEqual(f(l, True), 1)
+        self.assertEqual(f((1, 2), 0), 1)
+
+        t = tuple(range(10))
+        for i in range(WARMUP):
+            self.assertEqual(f(t, i % 10), i % 10)
+        self.assertEqual(f(t, -2), 8)
+        self.assertRaises(IndexError, f, t, 10)
+        self.assertEqual(f(t, slice(1, 3)), (1, 2))
+
+        def g(container, key):
+            return container[key]
+
+        d = {'a': 1, 2: 'b'}
+        for i in range(WARMUP):
+            self.assertEqual(g(d, 'a'), 1)
+        self.assertEqual(g(d, 2), 'b')
+        with self.assertRaises(KeyError) as cm:
+            g(d, (1,))
+        self.assertEqual(cm.exception.args, ((1,),))
+        self.assertRaises(TypeError, g, d, [])
+
+        class D(dict):
+            def __missing__(self, key):
+                return 42
+
+        self.assertEqual(g(D(), 'x'), 42)
+
+
+class SuperinstructionTests(unittest.TestCase):
+
+    def test_load_fast(self):
+        def f(a, flag):
+            if flag:
+                b = 2
+            return (a,
+                    b)
+
+        def error_lineno():
+            try:
+                f(1, False)
+            except UnboundLocalError as exc:
+                return exc.__traceback__.tb_next.tb_lineno
+            self.fail("UnboundLocalError not raised")
+
+        lineno = error_lineno()
+        for i in range(WARMUP):
+            self.assertEqual(f(1, True), (1, 2))
+        # The error is reported at the line of the second LOAD_FAST
+        self.assertEqual(error_lineno(), lineno)
+
+    def test_load_attr(self):
+        class A:
+            def __init__(self):
+                self.x = 1
+
+        class B:
+            def __getattr__(self, name):
+                return name
+
+        def f(obj):
+            return obj.x
+
+        for i in range(WARMUP):
+            self.assertEqual(f(A()), 1)
+        self.assertEqual(f(B()), 'x')
+        self.assertRaises(AttributeError, f, object())
+
+    def test_compare_jump(self):
+        def f(a, b):
+            if a < b:
+                return 'lt'
+            if a == b:
+                return 'eq'
+            if a is b:
+                return 'is'
+            return 'gt'
+
+        def expected(a, b):
+            if a < b:
+                return 'lt'
+            if a == b:
+                return 'eq'
+            if a is b:
+                return 'is'
+            return 'gt'
+
+        for i in range(WARMUP):
+            self.assertEqual(f(i, 500), expected(i, 500))
+        nan = float('nan')
+        for a, b in [(1.5, 2.5), (2.5, 2.5), (nan, nan), ('a', 'b'),
+                     ('b', 'b'), ('\U0001f600', 'a'), (2**100, 2**100 + 1),
+                     (-2**100, -2**100), (1, True), (1, 1.0), (2, 1.5)]:
+            self.assertEqual(f(a, b), expected(a, b), (a, b))
+        self.assertEqual(f(nan, float('nan')), 'gt')
+        self.assertRaises(TypeError, f, 'a', 1)
+
+        class Bad:
+            def __bool__(self):
+                raise ZeroDivisionError
+
+        class C:
+            def __lt__(self, other):
+                return Bad()
+
+        self.assertRaises(ZeroDivisionError, f, C(), C())
+
+    def test_compare_jump_specialized(self):
+        def compare(a, b):
+            if a < b:
+                return 'lt'
+            if a != b:
+                return 'ne'
+            return 'eq'
+
+        nan = float('nan')
+        cases = [(1.5, 2.5), (2.5, 2.5), (3.5, 2.5), (nan, nan), (1, 2),
+                 (2**100, 2**100), ('a', 'b'), ('b', 'b'), ('\xe9', 'e'),
+                 (1, 1.0), (1.5, True)]
+        # Each warmup specializes a copy of the function for one type
+        for warmup in [(1, 2), (2**100, 2**101), (1.5, 2.5), ('a', 'b')]:
+            f = type(compare)(compare.__code__.replace(), {})
+            for i in range(WARMUP):
+                self.assertEqual(f(*warmup), 'lt')
+            for a, b in cases:
+                self.assertEqual(f(a, b), compare(a, b), (warmup, a, b))
+            self.assertRaises(TypeError, f, 'a', 1)
+
+    def test_tracing(self):
+        import sys
+
+        def f(a, b):
+            if a < b:
+                return (a,
+                        b)
+            return (b,
+                    a)
+
+        def trace(func, *args):
+            lines = []
+            def tracer(frame, event, arg):
+                if frame.f_code is func.__code__ and event == 'line':
+                    lines.append(frame.f_lineno - func.__code__.co_firstlineno)
+                return tracer
+            sys.settrace(tracer)
+            try:
+                result = func(*args)
+            finally:
+                sys.settrace(None)
+            return result, lines
+
+        for i in range(WARMUP):
+            self.assertEqual(f(1, 2), (1, 2))
+        # The second instruction of a superinstruction is still traced
+        self.assertEqual(trace(f, 1, 2), ((1, 2), [1, 2, 3, 2]))
+        self.assertEqual(trace(f, 2, 1), ((1, 2), [1, 4, 5, 4]))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -370,6 +370,71 @@ class FileTests(unittest.TestCase):
             self.assertEqual(read[out_seek:],
                              data[in_skip:in_skip+i])
 
+    @unittest.skipUnless(hasattr(os, 'splice'), 'test needs os.splice()')
+    def test_splice_invalid_values(self):
+        with self.assertRaises(ValueError):
+            os.splice(0, 1, -10)
+
+    @unittest.skipUnless(hasattr(os, 'splice'), 'test needs os.splice()')
+    def test_splice(self):
+        TESTFN2 = support.TESTFN + ".3"
+        data = b'0123456789'
+
+        create_file(support.TESTFN, data)
+        self.addCleanup(support.unlink, support.TESTFN)
+
+        in_file = open(support.TESTFN, 'rb')
+        self.addCleanup(in_file.close)
+        in_fd = in_file.fileno()
+
+        read_fd, write_fd = os.pipe()
+        self.addCleanup(os.close, read_fd)
+        self.addCleanup(os.close, write_fd)
+
+        # file -> pipe, from the current position and from an offset
+        i = os.splice(in_fd, write_fd, 5)
+        self.assertIn(i, range(0, 6))
+        self.assertEqual(os.read(read_fd, 100), data[:i])
+        self.assertEqual(os.lseek(in_fd, 0, os.SEEK_CUR), i)
+        i = os.splice(in_fd, write_fd, 4, offset_src=6,
+                      flags=os.SPLICE_F_MOVE)
+        self.assertIn(i, range(0, 5))
+        self.assertEqual(os.read(read_fd, 100), data[6:6+i])
+
+        # pipe -> file, at an offset
+        out_file = open(TESTFN2, 'w+b')
+        self.addCleanup(support.unlink, TESTFN2)
+        self.addCleanup(out_file.close)
+        out_fd = out_file.fileno()
+        os.write(write_fd, data)
+        i = os.splice(read_fd, out_fd, len(data), offset_dst=3)
+        self.assertIn(i, range(0, len(data) + 1))
+        with open(TESTFN2, 'rb') as f:
+            self.assertEqual(f.read(), b'\0' * 3 + data[:i])
+
+        # neither is a pipe
+        with self.assertRaises(OSError) as cm:
+            os.splice(in_fd, out_fd, 5)
+        self.assertEqual(cm.exception.errno, errno.EINVAL)
+
+    @unittest.skipUnless(hasattr(os, 'tee'), 'test needs os.tee()')
+    def test_tee(self):
+        with self.assertRaises(ValueError):
+            os.tee(0, 1, -10)
+        r1, w1 = os.pipe()
+        r2, w2 = os.pipe()
+        for fd in r1, w1, r2, w2:
+            self.addCleanup(os.close, fd)
+        os.write(w1, b'0123456789')
+        i = os.tee(r1, w2, 4)
+        self.assertEqual(i, 4)
+        self.assertEqual(os.read(r2, 100), b'0123')
+        # the data is still in the source pipe
+        self.assertEqual(os.read(r1, 100), b'0123456789')
+        os.set_blocking(r1, False)
+        with self.assertRaises(BlockingIOError):
+            os.tee(r1, w2, 4, flags=os.SPLICE_F_NONBLOCK)
+
 # Test attributes on return values from os.*stat* family.
 class StatAttributeTests(unittest.TestCase):
     def setUp(self):
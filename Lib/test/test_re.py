@@ -2,8 +2,11 @@ from test.support import (gc_collect, bigmemtest, _2G,
                           cpython_only, captured_stdout)
 import locale
 import re
+import signal
 import sre_compile
 import string
+import sys
+import time
 import unittest
 import warnings
 from re import Scanner
@@ -993,6 +996,139 @@ class ReTests(unittest.TestCase):
         self.assertEqual(re.search(r"\s(b)", " b").group(1), "b")
         self.assertEqual(re.search(r"a\s", "a ").group(0), "a ")
 
+    def test_search_required_literal(self):
+        # Patterns containing a literal further than their start only try
+        # to match where the literal can be found at the right offset
+        text = 'x1 WARN a 22 ERROR b 333 ERROR c ERRO 4 ERROR'
+        for pattern, expected in [
+                (r'\d+ ERROR \w', ['22 ERROR b', '333 ERROR c']),
+                (r'\d ERROR', ['2 ERROR', '3 ERROR', '4 ERROR']),
+                (r'\d{2} ERROR', ['22 ERROR', '33 ERROR']),
+                (r'(\d+) (ERROR)', [('22', 'ERROR'), ('333', 'ERROR'),
+                                    ('4', 'ERROR')]),
+                (r'[a-z] \d+ ERROR', ['a 22 ERROR', 'b 333 ERROR']),
+                (r'x\d WARN', ['x1 WARN']),
+                (r'E.*R', ['ERROR b 333 ERROR c ERRO 4 ERROR']),
+                (r'(?<=\d )ERROR', ['ERROR', 'ERROR', 'ERROR']),
+                (r'\d (?i:error)', ['2 ERROR', '3 ERROR', '4 ERROR']),
+                (r'\w+ FATAL', []),
+                (r'\d+ ERRORS', []),
+                (r'\d ERROR \w', ['2 ERROR b', '3 ERROR c'])]:
+            with self.subTest(pattern=pattern):
+                self.assertEqual(re.findall(pattern, text), expected)
+                self.assertEqual(re.findall(pattern.encode(), text.encode()),
+                                 [x.encode() if isinstance(x, str) else
+                                  tuple(y.encode() for y in x)
+                                  for x in expected])
+                self.assertEqual(re.findall(pattern, text + '\u0100'),
+                                 expected)
+        # The literal is looked for between pos and endpos
+        p = re.compile(r'\d ERROR')
+        self.assertEqual(p.search(text, 11).span(), (11, 18))
+        self.assertEqual(p.search(text, 12).span(), (23, 30))
+        self.assertIsNone(p.search(text, 12, 29))
+        self.assertIsNone(p.search(text, 41))
+        # Non-Latin-1 literals in Latin-1 strings and vice versa
+        self.assertIsNone(re.search(r'\d+\u0100', 'a 1\xe9'))
+        self.assertEqual(re.search(r'\d+\xe9', '\u0100 1\xe9').group(), '1\xe9')
+        self.assertIsNone(re.search(r'\d+\U0001f600', '\u0100 1\xe9'))
+        # Case-insensitive patterns only use the uncased literals
+        self.assertEqual(re.findall(r'(?i)\d+ error:', 'a 1 ERROR: 2 Error:'),
+                         ['1 ERROR:', '2 Error:'])
+        self.assertEqual(re.findall(r'\d+ error:', 'a 1 ERROR: 2 error:', re.I),
+                         ['1 ERROR:', '2 error:'])
+
+    def test_large_immutable_string(self):
+        # Long str and bytes objects are matched with the GIL released,
+        # bytearray objects are not
+        text = 'ab1 ' * 5000 + 'abc 22 (x)'
+        data = text.encode()
+        for pattern in [r'(a)(b)?(?:\d|c)', r'\w+', r'(?:ab\d )*abc', r'x',
+                        r'(a+|b)\d', r'', r'(?i)AB(C)?', r'\d+ \((\w)\)$']:
+            with self.subTest(pattern=pattern):
+                p = re.compile(pattern)
+                b = re.compile(pattern.encode())
+                expected = [x.encode() if isinstance(x, str) else
+                            tuple(y.encode() for y in x)
+                            for x in p.findall(text)]
+                self.assertEqual(b.findall(data), expected)
+                self.assertEqual(b.findall(bytearray(data)), expected)
+                for meth in 'match', 'fullmatch', 'search':
+                    m = getattr(p, meth)(text, 3)
+                    m1 = getattr(b, meth)(data, 3)
+                    m2 = getattr(b, meth)(bytearray(data), 3)
+                    self.assertEqual(m and m.span(), m1 and m1.span())
+                    self.assertEqual(m1 and m1.regs, m2 and m2.regs)
+
+    def test_large_mutable_buffer_keeps_gil(self):
+        # A read-only view of mutable memory is matched with the GIL held,
+        # so no other thread can run (and change the data) meanwhile
+        import threading
+        data = b'ab1 ' * 100000 + b'abc'
+        p = re.compile(rb'(?:ab\d )*ab(c)')
+        counter = 0
+        done = False
+        started = threading.Event()
+        def worker():
+            nonlocal counter
+            started.set()
+            while not done:
+                counter += 1
+                time.sleep(0)
+        # Only switch threads when the GIL is released explicitly
+        self.addCleanup(sys.setswitchinterval, sys.getswitchinterval())
+        sys.setswitchinterval(1000)
+        t = threading.Thread(target=worker)
+        t.start()
+        try:
+            started.wait()
+            def ran_concurrently(string):
+                before = counter
+                self.assertEqual(p.match(string).span(1), (400002, 400003))
+                return counter != before
+            # bytes is matched with the GIL released
+            self.assertTrue(any(ran_concurrently(data) for i in range(100)))
+            for string in (memoryview(bytearray(data)).toreadonly(),
+                           bytearray(data)):
+                with self.subTest(type=type(string)):
+                    for i in range(10):
+                        self.assertFalse(ran_concurrently(string))
+        finally:
+            done = True
+            t.join()
+
+    def test_large_string_threads(self):
+        import threading
+        data = b'ab1 ' * 10000 + b'abc'
+        p = re.compile(rb'(?:ab\d )*ab(c)')
+        results = []
+        def worker():
+            for i in range(20):
+                results.append((p.match(data).span(1), len(p.findall(data))))
+        threads = [threading.Thread(target=worker) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(results, [((40002, 40003), 1)] * 80)
+
+    @unittest.skipUnless(hasattr(signal, 'setitimer'), 'requires setitimer()')
+    def test_large_string_interrupted(self):
+        class Alarm(Exception):
+            pass
+        def handler(signum, frame):
+            raise Alarm
+        old_handler = signal.signal(signal.SIGALRM, handler)
+        self.addCleanup(signal.signal, signal.SIGALRM, old_handler)
+        # exponential backtracking
+        data = b'a' * 40 + b'c' * 5000
+        signal.setitimer(signal.ITIMER_REAL, 0.1)
+        try:
+            with self.assertRaises(Alarm):
+                re.match(rb'(?:a+)+b', data)
+        finally:
+            signal.setitimer(signal.ITIMER_REAL, 0)
+
     def assertMatch(self, pattern, text, match=None, span=None,
                     matcher=re.fullmatch):
         if match is None and span is None:
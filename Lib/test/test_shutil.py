@@ -16,6 +16,7 @@ import random
 import string
 import contextlib
 import io
+import threading
 from shutil import (make_archive,
                     register_archive_format, unregister_archive_format,
                     get_archive_formats, Error, unpack_archive,
@@ -2084,6 +2085,54 @@ class TestCopyFileObj(unittest.TestCase):
             self.assertEqual(src.tell(), self.FILESIZE)
             self.assertEqual(dst.tell(), self.FILESIZE)
 
+    def test_pipe(self):
+        # Raw files may be spliced to and from pipes
+        for bufsize in 0, -1:
+            with self.subTest(bufsize=bufsize):
+                r, w = os.pipe()
+                with open(TESTFN, "rb", buffering=bufsize) as src, \
+                     open(w, "wb", buffering=bufsize) as dst:
+                    with open(r, "rb", buffering=bufsize) as pipe_src, \
+                         open(TESTFN2, "wb", buffering=bufsize) as pipe_dst:
+                        t = threading.Thread(target=shutil.copyfileobj,
+                                             args=(pipe_src, pipe_dst))
+                        t.start()
+                        try:
+                            shutil.copyfileobj(src, dst)
+                            dst.close()
+                        finally:
+                            t.join()
+                        self.assertEqual(src.tell(), self.FILESIZE)
+                self.assert_files_eq(TESTFN, TESTFN2)
+
+    @unittest.skipUnless(hasattr(os, 'splice'), 'test needs os.splice()')
+    def test_splice_fallback(self):
+        r, w = os.pipe()
+        with open(r, "rb", buffering=0) as src, \
+             open(TESTFN2, "ab", buffering=0) as dst:
+            with open(w, "wb", buffering=0) as f:
+                f.write(b"abc")
+            # splice() does not write to files open in append mode
+            with unittest.mock.patch("shutil._fastcopy_splice",
+                                     wraps=shutil._fastcopy_splice) as m:
+                shutil.copyfileobj(src, dst)
+            self.assertTrue(m.called)
+        with open(TESTFN2, "rb") as f:
+            self.assertEqual(f.read(), b"abc")
+
+    def test_pipe_wrong_mode(self):
+        r, w = os.pipe()
+        with open(r, "rb", buffering=0) as rf, \
+             open(w, "wb", buffering=0) as wf:
+            # The write end of the pipe as the source
+            with open(TESTFN2, "wb", buffering=0) as dst:
+                self.assertRaises(io.UnsupportedOperation,
+                                  shutil.copyfileobj, wf, dst)
+            # The read end of the pipe as the destination
+            with open(TESTFN, "rb", buffering=0) as src:
+                self.assertRaises(io.UnsupportedOperation,
+                                  shutil.copyfileobj, src, rf)
+
     @unittest.skipIf(os.name != 'nt', "Windows only")
     def test_win_impl(self):
         # Make sure alternate Windows implementation is called.
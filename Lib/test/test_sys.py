@@ -12,6 +12,7 @@ import sys
 import sysconfig
 import test.support
 import textwrap
+import time
 import unittest
 import warnings
 
@@ -778,6 +779,94 @@ class SysModuleTest(unittest.TestCase):
         # The function has no parameter
         self.assertRaises(TypeError, sys._debugmallocstats, True)
 
+    @test.support.cpython_only
+    def test_trim_memory(self):
+        # Test sys._trim_memory()
+        from test.support.script_helper import assert_python_ok
+        code = textwrap.dedent('''
+            import sys
+            # Free most pools, but not the arenas
+            objs = [(i, str(i)) for i in range(200000)]
+            for i in range(len(objs)):
+                if (i // 100) % 20:
+                    objs[i] = None
+            released = sys._trim_memory()
+            print(released)
+            # Released pools are reused
+            objs2 = [(i, str(i)) for i in range(200000)]
+            assert objs2[12345] == (12345, '12345')
+            assert objs[2001] == (2001, '2001')
+            sys._debugmallocstats()
+        ''')
+        ret, out, err = assert_python_ok('-c', code)
+        released = int(out)
+        self.assertGreaterEqual(released, 0)
+        if (support.with_pymalloc() and sys.platform.startswith('linux')
+                and os.environ.get('PYTHONMALLOC') not in ('malloc',
+                                                           'malloc_debug')):
+            self.assertGreater(released, 0)
+            self.assertIn(b'released to the OS', err)
+
+        # The function has no parameter
+        self.assertRaises(TypeError, sys._trim_memory, True)
+
+    @test.support.cpython_only
+    def test_sampling(self):
+        # Test sys._start_sampling(), sys._stop_sampling() and
+        # sys._get_sampled_stacks()
+        def busy():
+            deadline = time.monotonic() + 0.2
+            while time.monotonic() < deadline:
+                pass
+
+        def outer():
+            busy()
+
+        sys._start_sampling(0.001)
+        try:
+            self.assertRaises(RuntimeError, sys._start_sampling)
+            outer()
+        finally:
+            sys._stop_sampling()
+        stacks = sys._get_sampled_stacks()
+        self.assertGreater(sum(stacks.values()), 0)
+
+        # Frames are labelled with the line they are executing
+        code = outer.__code__
+        label = '%s (%s:%d)' % (code.co_name, code.co_filename,
+                                code.co_firstlineno + 1)
+        code = busy.__code__
+        busy_labels = {'%s;%s (%s:%d)' % (label, code.co_name,
+                                          code.co_filename,
+                                          code.co_firstlineno + i)
+                       for i in (1, 2, 3)}
+        self.assertTrue(any(stack.endswith(busy_label)
+                            for stack in stacks
+                            for busy_label in busy_labels),
+                        stacks)
+        for stack, count in stacks.items():
+            self.assertIsInstance(stack, str)
+            self.assertIsInstance(count, int)
+            self.assertGreater(count, 0)
+
+        # Samples are kept after stopping, and stopping twice is fine
+        sys._stop_sampling()
+        self.assertEqual(sys._get_sampled_stacks(), stacks)
+
+        # A small buffer only keeps the newest samples
+        sys._start_sampling(0.001, size=10)
+        try:
+            outer()
+        finally:
+            sys._stop_sampling()
+        stacks = sys._get_sampled_stacks()
+        self.assertLessEqual(sum(stacks.values()), 10)
+
+        self.assertRaises(ValueError, sys._start_sampling, 0)
+        self.assertRaises(ValueError, sys._start_sampling, -1.0)
+        self.assertRaises(ValueError, sys._start_sampling, size=1)
+        self.assertRaises(TypeError, sys._start_sampling, 'x')
+
     @unittest.skipUnless(hasattr(sys, "getallocatedblocks"),
                          "sys.getallocatedblocks unavailable on this build")
     def test_getallocatedblocks(self):
@@ -1120,13 +1209,13 @@ class SizeofTest(unittest.TestCase):
         # code
         def check_code_size(a, expected_size):
             self.assertGreaterEqual(sys.getsizeof(a), expected_size)
-        check_code_size(get_cell().__code__, size('6i13P'))
-        check_code_size(get_cell.__code__, size('6i13P'))
+        check_code_size(get_cell().__code__, size('6i14P'))
+        check_code_size(get_cell.__code__, size('6i14P'))
         def get_cell2(x):
             def inner():
                 return x
             return inner
-        check_code_size(get_cell2.__code__, size('6i13P') + calcsize('n'))
+        check_code_size(get_cell2.__code__, size('6i14P') + calcsize('n'))
         # complex
         check(complex(0,1), size('2d'))
         # method_descriptor (descriptor object)
@@ -230,6 +230,15 @@ class UnicodeTest(string_tests.CommonTest,
         self.checkequal(-1, 'a' * 100, 'find', 'a\u0102')
         self.checkequal(-1, 'a' * 100, 'find', 'a\U00100304')
         self.checkequal(-1, '\u0102' * 100, 'find', '\u0102\U00100304')
+        # the SIMD filter and the two-way search with wide characters; the
+        # low bytes of the characters are equal
+        for a, b in ('\u0102', '\u0202'), ('\U00100304', '\U00100404'):
+            for k in (5, 20, 100):
+                pattern = a * k + b + a * k
+                self.checkequal(-1, a * 3000, 'find', pattern)
+                self.checkequal(1000, a * 1000 + pattern + a * 1000,
+                                'find', pattern)
+                self.checkequal(2, (a * 1000 + pattern) * 2, 'count', pattern)
 
     def test_rfind(self):
         string_tests.CommonTest.test_rfind(self)
@@ -1737,6 +1746,48 @@ class UnicodeTest(string_tests.CommonTest,
             self.assertRaises(UnicodeDecodeError,
                               (b'\xF4'+cb+b'\xBF\xBF').decode, 'utf-8')
 
+    def test_utf8_decode_long(self):
+        # Long inputs are validated and decoded by blocks of 16 or 32 bytes
+        # on some platforms: put sequences at all the offsets of a block
+        texts = ['abcd' * 30, 'abcdé' * 30, 'абвгд' * 30, 'a€b€' * 30,
+                 'ab\U0001F600' * 30, 'abĀ€\U0010ffff' * 30]
+        valid = ['\x7f', '\x80', '\xff', 'Ā', '߿', 'ࠀ',
+                 '퟿', '', '￿', '\U00010000', '\U0010ffff']
+        invalid = [b'\x80', b'\xbf', b'\xc0\x80', b'\xc1\xbf', b'\xc2',
+                   b'\xc2\x41', b'\xe0\x80\x80', b'\xe0\x9f\xbf',
+                   b'\xe1\x80', b'\xed\xa0\x80', b'\xed\xbf\xbf',
+                   b'\xf0\x8f\xbf\xbf', b'\xf1\x80\x80', b'\xf4\x90\x80\x80',
+                   b'\xf5\x80\x80\x80', b'\xff']
+        for text in texts:
+            for i in range(40):
+                prefix = text[:i]
+                suffix = text[i:]
+                for c in valid:
+                    s = prefix + c + suffix
+                    self.assertEqual(s.encode('utf-8').decode('utf-8'), s)
+                for seq in invalid:
+                    data = (prefix.encode('utf-8') + seq +
+                            suffix.encode('utf-8'))
+                    with self.assertRaises(UnicodeDecodeError) as cm:
+                        data.decode('utf-8')
+                    self.assertEqual(cm.exception.start,
+                                     len(prefix.encode('utf-8')))
+                    self.assertEqual(
+                        data.decode('utf-8', 'surrogateescape'),
+                        prefix + seq.decode('utf-8', 'surrogateescape') +
+                        suffix)
+
+        # The stateful decoder leaves an incomplete sequence at the end
+        for text in texts:
+            data = text.encode('utf-8') + '\U0010ffff'.encode('utf-8')
+            for i in range(1, 4):
+                self.assertEqual(codecs.utf_8_decode(data[:-i], 'strict',
+                                                     False),
+                                 (text, len(data) - 4))
+                self.assertRaises(UnicodeDecodeError,
+                                  codecs.utf_8_decode, data[:-i], 'strict',
+                                  True)
+
     def test_issue8271(self):
         # Issue #8271: during the decoding of an invalid UTF-8 byte sequence,
         # only the start byte and the continuation byte(s) are now considered
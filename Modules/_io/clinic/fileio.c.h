@@ -218,6 +218,48 @@ exit:
     return return_value;
 }
 
+#if defined(HAVE_PREAD)
+
+PyDoc_STRVAR(_io_FileIO_readv_at__doc__,
+"readv_at($self, offsets, buffers, /)\n"
+"--\n"
+"\n"
+"Read into each of the buffers from the matching offset of the file.\n"
+"\n"
+"Return a list with the number of bytes actually read into each buffer,\n"
+"which can be less than the size of the buffer: 0 at the end of the file,\n"
+"or a short read, which the caller has to complete.  The file position is\n"
+"not changed.\n"
+"\n"
+"On Linux, the reads are submitted together with io_uring if it is\n"
+"available.  Otherwise, they are done one by one with pread().");
+
+#define _IO_FILEIO_READV_AT_METHODDEF    \
+    {"readv_at", (PyCFunction)(void(*)(void))_io_FileIO_readv_at, METH_FASTCALL, _io_FileIO_readv_at__doc__},
+
+static PyObject *
+_io_FileIO_readv_at_impl(fileio *self, PyObject *offsets, PyObject *buffers);
+
+static PyObject *
+_io_FileIO_readv_at(fileio *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *offsets;
+    PyObject *buffers;
+
+    if (!_PyArg_CheckPositional("readv_at", nargs, 2, 2)) {
+        goto exit;
+    }
+    offsets = args[0];
+    buffers = args[1];
+    return_value = _io_FileIO_readv_at_impl(self, offsets, buffers);
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_PREAD) */
+
 PyDoc_STRVAR(_io_FileIO_readall__doc__,
 "readall($self, /)\n"
 "--\n"
@@ -444,7 +486,11 @@ _io_FileIO_isatty(fileio *self, PyObject *Py_UNUSED(ignored))
     return _io_FileIO_isatty_impl(self);
 }
 
+#ifndef _IO_FILEIO_READV_AT_METHODDEF
+    #define _IO_FILEIO_READV_AT_METHODDEF
+#endif /* !defined(_IO_FILEIO_READV_AT_METHODDEF) */
+
 #ifndef _IO_FILEIO_TRUNCATE_METHODDEF
     #define _IO_FILEIO_TRUNCATE_METHODDEF
 #endif /* !defined(_IO_FILEIO_TRUNCATE_METHODDEF) */
-/*[clinic end generated code: output=7ee4f3ae584fc6d2 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=747005aac2bdad4e input=a9049054013a1b77]*/
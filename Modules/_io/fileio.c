@@ -17,6 +17,12 @@
 #include <fcntl.h>
 #endif
 #include <stddef.h> /* For offsetof */
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
 #include "_iomodule.h"
 
 /*
@@ -650,6 +656,437 @@ _io_FileIO_readinto_impl(fileio *self, Py_buffer *buffer)
     return PyLong_FromSsize_t(n);
 }
 
+#if defined(HAVE_LINUX_IO_URING_H) && defined(__NR_io_uring_setup)
+#define USE_IO_URING
+
+/* A minimal io_uring, used by readv_at() to submit many reads with a
+   single system call.  One ring is shared by all the FileIO objects: a
+   thread takes it while holding the GIL, and gives it back when done.
+   Meanwhile, the other threads use pread(). */
+
+#define URING_ENTRIES 64
+/* Number of times waiting for the reads in flight is retried, once every
+   millisecond, after io_uring_enter() failed */
+#define URING_MAX_RETRIES 1000
+
+typedef struct {
+    int fd;
+    pid_t pid;          /* the process which created the ring */
+    unsigned int entries;
+    unsigned int *sq_tail, *sq_mask, *sq_array;
+    unsigned int *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring, *cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+} uring;
+
+static uring *shared_uring = NULL;
+static int uring_busy = 0;
+static int uring_unavailable = 0;
+
+static void
+uring_free(uring *ring)
+{
+    if (ring->sqes != MAP_FAILED)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring)
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring != MAP_FAILED)
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+    PyMem_RawFree(ring);
+}
+
+/* Return a new ring, or NULL with *setup_errno set to the error of
+   io_uring_setup() or to 0 if something else failed.  Don't set an
+   exception: the caller falls back to pread(). */
+static uring *
+uring_new(int *setup_errno)
+{
+    struct io_uring_params p;
+    uring *ring;
+    char *sq, *cq;
+
+    *setup_errno = 0;
+    ring = PyMem_RawMalloc(sizeof(uring));
+    if (ring == NULL)
+        return NULL;
+    memset(&p, 0, sizeof(p));
+    ring->fd = (int)syscall(__NR_io_uring_setup, URING_ENTRIES, &p);
+    if (ring->fd < 0) {
+        *setup_errno = errno;
+        PyMem_RawFree(ring);
+        return NULL;
+    }
+    ring->pid = getpid();
+    ring->entries = p.sq_entries;
+    ring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+    ring->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->cq_ring = ring->sqes = MAP_FAILED;
+
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sq_ring_size = ring->cq_ring_size =
+            Py_MAX(ring->sq_ring_size, ring->cq_ring_size);
+#endif
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd,
+                         IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED)
+        goto error;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        ring->cq_ring = ring->sq_ring;
+    else
+#endif
+    {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->fd,
+                             IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED)
+            goto error;
+    }
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED)
+        goto error;
+
+    sq = ring->sq_ring;
+    cq = ring->cq_ring;
+    ring->sq_tail = (unsigned int *)(sq + p.sq_off.tail);
+    ring->sq_mask = (unsigned int *)(sq + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned int *)(sq + p.sq_off.array);
+    ring->cq_head = (unsigned int *)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned int *)(cq + p.cq_off.tail);
+    ring->cq_mask = (unsigned int *)(cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return ring;
+
+  error:
+    uring_free(ring);
+    return NULL;
+}
+
+/* Take the shared ring, creating it if needed.  Return NULL if another
+   thread is using it or if io_uring is not available: the caller then
+   uses pread(). */
+static uring *
+uring_take(void)
+{
+    int setup_errno;
+
+    if (shared_uring != NULL && shared_uring->pid != getpid()) {
+        /* Inherited by fork(): the parent still uses the same ring, and
+           the thread which was using it doesn't exist in the child */
+        uring_free(shared_uring);
+        shared_uring = NULL;
+        uring_busy = 0;
+    }
+    if (uring_busy || uring_unavailable)
+        return NULL;
+    if (shared_uring == NULL) {
+        shared_uring = uring_new(&setup_errno);
+        if (shared_uring == NULL) {
+            /* Not supported by the kernel, denied by a seccomp filter or
+               by the io_uring_disabled sysctl: don't try again.  Other
+               errors, like ENOMEM or EMFILE, may be transient. */
+            if (setup_errno == ENOSYS || setup_errno == EPERM ||
+                setup_errno == EINVAL)
+                uring_unavailable = 1;
+            return NULL;
+        }
+    }
+    uring_busy = 1;
+    return shared_uring;
+}
+
+/* Give back the ring returned by uring_take().  If broken, free it: the
+   next call to uring_take() creates a new one.  If leaked, some reads are
+   still in flight: forget the ring without freeing it. */
+static void
+uring_give_back(uring *ring, int broken, int leaked)
+{
+    assert(ring == shared_uring && uring_busy);
+    if (broken || leaked) {
+        if (!leaked)
+            uring_free(ring);
+        shared_uring = NULL;
+    }
+    uring_busy = 0;
+}
+
+/* Read iov[i] from fd at offsets[i] for i < n, and store the results of
+   the reads (a size, or a negative errno value) in results.  Return 0 on
+   success, or -1 with an exception set; *broken is set if the ring
+   cannot be used anymore, and *in_flight if the kernel may still write
+   into the buffers, which must then never be freed. */
+static int
+uring_readv_at(uring *ring, int fd, Py_ssize_t n, const Py_off_t *offsets,
+               struct iovec *iov, Py_ssize_t *results, int *broken,
+               int *in_flight)
+{
+    Py_ssize_t i = 0, j;
+    int async_err = 0;
+    int err = 0;
+    int retries = 0;
+
+    while (i < n) {
+        unsigned int batch, tail, head, idx;
+        unsigned int pending, inflight = 0;
+        int ret;
+
+        /* Fill the submission queue */
+        batch = (unsigned int)Py_MIN(n - i, (Py_ssize_t)ring->entries);
+        tail = *ring->sq_tail;
+        for (j = 0; j < batch; j++) {
+            struct io_uring_sqe *sqe;
+
+            idx = (tail + j) & *ring->sq_mask;
+            sqe = &ring->sqes[idx];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = fd;
+            sqe->off = offsets[i + j];
+            sqe->addr = (uintptr_t)&iov[i + j];
+            sqe->len = 1;
+            sqe->user_data = i + j;
+            ring->sq_array[idx] = idx;
+        }
+        __atomic_store_n(ring->sq_tail, tail + batch, __ATOMIC_RELEASE);
+
+        /* Submit it and wait for the completions.  The buffers must not
+           be released before all the submitted reads are completed, so
+           errors are only reported then. */
+        pending = batch;
+        while (pending > 0 || inflight > 0) {
+            Py_BEGIN_ALLOW_THREADS
+            ret = (int)syscall(__NR_io_uring_enter, ring->fd,
+                               err ? 0 : pending, 1,
+                               IORING_ENTER_GETEVENTS, NULL, 0);
+            Py_END_ALLOW_THREADS
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    if (!async_err && PyErr_CheckSignals())
+                        async_err = 1;
+                    continue;
+                }
+                if (!err) {
+                    err = errno;
+                    /* The remaining entries stay in the submission queue */
+                    *broken = 1;
+                }
+                if (inflight > 0) {
+                    /* Stop submitting but wait for the completions of the
+                       reads in flight, which are also posted without
+                       io_uring_enter() */
+                    struct timespec delay = {0, 1000000};
+
+                    if (++retries > URING_MAX_RETRIES) {
+                        *in_flight = 1;
+                        break;
+                    }
+                    Py_BEGIN_ALLOW_THREADS
+                    nanosleep(&delay, NULL);
+                    Py_END_ALLOW_THREADS
+                }
+            }
+            else if (!err) {
+                pending -= ret;
+                inflight += ret;
+            }
+
+            head = *ring->cq_head;
+            tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+                results[cqe->user_data] = cqe->res;
+                head++;
+                inflight--;
+            }
+            __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+            if (err && inflight == 0)
+                break;
+        }
+        if (err || async_err)
+            break;
+        i += batch;
+    }
+
+    if (async_err)
+        return -1;
+    if (err) {
+        errno = err;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    return 0;
+}
+#endif /* HAVE_LINUX_IO_URING_H */
+
+#ifdef HAVE_PREAD
+/*[clinic input]
+_io.FileIO.readv_at
+    offsets: object
+    buffers: object
+    /
+
+Read into each of the buffers from the matching offset of the file.
+
+Return a list with the number of bytes actually read into each buffer,
+which can be less than the size of the buffer: 0 at the end of the file,
+or a short read, which the caller has to complete.  The file position is
+not changed.
+
+On Linux, the reads are submitted together with io_uring if it is
+available.  Otherwise, they are done one by one with pread().
+[clinic start generated code]*/
+
+static PyObject *
+_io_FileIO_readv_at_impl(fileio *self, PyObject *offsets, PyObject *buffers)
+/*[clinic end generated code: output=49c8d072e25e5301 input=78dd5a8e8495dfd7]*/
+{
+    PyObject *offsets_fast = NULL, *buffers_fast = NULL, *seekable;
+    PyObject *result = NULL;
+    Py_buffer *views = NULL;
+    Py_off_t *offs = NULL;
+    Py_ssize_t *sizes = NULL;
+    Py_ssize_t i, n, nviews = 0;
+#ifdef USE_IO_URING
+    struct iovec *iov = NULL;
+    uring *ring;
+#endif
+
+    if (self->fd < 0)
+        return err_closed();
+    if (!self->readable)
+        return err_mode("reading");
+
+    offsets_fast = PySequence_Fast(offsets, "offsets must be a sequence");
+    if (offsets_fast == NULL)
+        goto done;
+    buffers_fast = PySequence_Fast(buffers, "buffers must be a sequence");
+    if (buffers_fast == NULL)
+        goto done;
+    n = PySequence_Fast_GET_SIZE(offsets_fast);
+    if (PySequence_Fast_GET_SIZE(buffers_fast) != n) {
+        PyErr_SetString(PyExc_ValueError,
+                        "offsets and buffers must have the same length");
+        goto done;
+    }
+
+    offs = PyMem_New(Py_off_t, n);
+    sizes = PyMem_New(Py_ssize_t, n);
+    views = PyMem_New(Py_buffer, n);
+    if (offs == NULL || sizes == NULL || views == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n; i++) {
+        offs[i] = PyLong_AsOff_t(PySequence_Fast_GET_ITEM(offsets_fast, i));
+        if (offs[i] == -1 && PyErr_Occurred())
+            goto done;
+        if (offs[i] < 0) {
+            PyErr_SetString(PyExc_ValueError, "negative offset");
+            goto done;
+        }
+    }
+    for (; nviews < n; nviews++) {
+        if (PyObject_GetBuffer(PySequence_Fast_GET_ITEM(buffers_fast, nviews),
+                               &views[nviews], PyBUF_WRITABLE) < 0)
+            goto done;
+    }
+
+    /* Reads with an offset only make sense on a seekable file, and
+       pread() reports ESPIPE for the others */
+    seekable = _io_FileIO_seekable_impl(self);
+    if (seekable == NULL)
+        goto done;
+    Py_DECREF(seekable);
+
+#ifdef USE_IO_URING
+    if (self->seekable > 0 && n > 1 && (ring = uring_take()) != NULL) {
+        int broken = 0, in_flight = 0, res;
+
+        iov = PyMem_New(struct iovec, n);
+        if (iov == NULL) {
+            uring_give_back(ring, 0, 0);
+            PyErr_NoMemory();
+            goto done;
+        }
+        for (i = 0; i < n; i++) {
+            iov[i].iov_base = views[i].buf;
+            iov[i].iov_len = views[i].len;
+        }
+        res = uring_readv_at(ring, self->fd, n, offs, iov, sizes,
+                             &broken, &in_flight);
+        if (in_flight) {
+            /* Leak the ring, the iovecs and the buffers (keeping the
+               objects alive) rather than letting the kernel write into
+               freed memory */
+            iov = NULL;
+            views = NULL;
+            nviews = 0;
+        }
+        uring_give_back(ring, broken, in_flight);
+        if (res < 0)
+            goto done;
+        for (i = 0; i < n; i++) {
+            if (sizes[i] < 0) {
+                errno = (int)-sizes[i];
+                PyErr_SetFromErrno(PyExc_OSError);
+                goto done;
+            }
+        }
+    }
+    else
+#endif
+    for (i = 0; i < n; i++) {
+        int async_err = 0;
+        Py_ssize_t size;
+
+        do {
+            Py_BEGIN_ALLOW_THREADS
+            size = pread(self->fd, views[i].buf, views[i].len, offs[i]);
+            Py_END_ALLOW_THREADS
+        } while (size < 0 && errno == EINTR &&
+                 !(async_err = PyErr_CheckSignals()));
+        if (size < 0) {
+            if (!async_err)
+                PyErr_SetFromErrno(PyExc_OSError);
+            goto done;
+        }
+        sizes[i] = size;
+    }
+
+    result = PyList_New(n);
+    if (result == NULL)
+        goto done;
+    for (i = 0; i < n; i++) {
+        PyObject *size = PyLong_FromSsize_t(sizes[i]);
+        if (size == NULL) {
+            Py_CLEAR(result);
+            goto done;
+        }
+        PyList_SET_ITEM(result, i, size);
+    }
+
+  done:
+    for (i = 0; i < nviews; i++)
+        PyBuffer_Release(&views[i]);
+#ifdef USE_IO_URING
+    PyMem_Free(iov);
+#endif
+    PyMem_Free(views);
+    PyMem_Free(sizes);
+    PyMem_Free(offs);
+    Py_XDECREF(buffers_fast);
+    Py_XDECREF(offsets_fast);
+    return result;
+}
+#endif /* HAVE_PREAD */
+
 static size_t
 new_buffersize(fileio *self, size_t currentsize)
 {
@@ -1131,6 +1568,7 @@ static PyMethodDef fileio_methods[] = {
     _IO_FILEIO_READ_METHODDEF
     _IO_FILEIO_READALL_METHODDEF
     _IO_FILEIO_READINTO_METHODDEF
+    _IO_FILEIO_READV_AT_METHODDEF
     _IO_FILEIO_WRITE_METHODDEF
     _IO_FILEIO_SEEK_METHODDEF
     _IO_FILEIO_TELL_METHODDEF
@@ -10,7 +10,6 @@
 
 #include "Python.h"
 #include "structmember.h"
-#include "pycore_accu.h"
 
 #ifdef __GNUC__
 #define UNUSED __attribute__((__unused__))
@@ -20,10 +19,12 @@
 
 #define PyScanner_Check(op) PyObject_TypeCheck(op, &PyScannerType)
 #define PyScanner_CheckExact(op) (Py_TYPE(op) == &PyScannerType)
+#define PyStreamScanner_Check(op) PyObject_TypeCheck(op, &PyStreamScannerType)
 #define PyEncoder_Check(op) PyObject_TypeCheck(op, &PyEncoderType)
 #define PyEncoder_CheckExact(op) (Py_TYPE(op) == &PyEncoderType)
 
 static PyTypeObject PyScannerType;
+static PyTypeObject PyStreamScannerType;
 static PyTypeObject PyEncoderType;
 
 typedef struct _PyScannerObject {
@@ -47,6 +48,47 @@ static PyMemberDef scanner_members[] = {
     {NULL}
 };
 
+/* States of the stream scanner */
+enum {
+    STREAM_VALUE,           /* expecting a top-level value */
+    STREAM_VALUE_END,       /* expecting whitespace after a value */
+    STREAM_ARRAY_START,     /* expecting the '[' of the top-level array */
+    STREAM_ARRAY_FIRST,     /* expecting its first element or ']' */
+    STREAM_ARRAY_NEXT,      /* expecting ',' or ']' after an element */
+    STREAM_ARRAY_ELEMENT,   /* expecting an element after ',' */
+    STREAM_ARRAY_END,       /* after the ']' of the top-level array */
+    STREAM_CONTAINER,       /* in an object or array value */
+    STREAM_STRING,          /* in a string value */
+    STREAM_SCALAR,          /* in a number or a constant */
+};
+
+typedef struct _PyStreamScannerObject {
+    PyObject_HEAD
+    PyObject *scan_once;    /* scanner of the context, for complete values */
+    PyObject *pending;      /* list of the parts of the current value */
+    char array;             /* yield the elements of a top-level array */
+    char in_string;         /* in a string of the current container */
+    char escape;            /* after a backslash in a string */
+    int state;
+    Py_ssize_t depth;       /* nesting level in the current container */
+    /* The lines are counted up to index counted of the current part, which
+       starts at index offset of the stream: the errors are reported at
+       their positions in the stream */
+    Py_ssize_t offset;
+    Py_ssize_t counted;
+    Py_ssize_t lineno;      /* line at index counted */
+    Py_ssize_t linestart;   /* index of the start of that line */
+    /* Position of the start of the current value */
+    Py_ssize_t value_offset;
+    Py_ssize_t value_lineno;
+    Py_ssize_t value_linestart;
+} PyStreamScannerObject;
+
+static PyMemberDef stream_scanner_members[] = {
+    {"array", T_BOOL, offsetof(PyStreamScannerObject, array), READONLY, "array"},
+    {NULL}
+};
+
 typedef struct _PyEncoderObject {
     PyObject_HEAD
     PyObject *markers;
@@ -61,6 +103,15 @@ typedef struct _PyEncoderObject {
     PyCFunction fast_encode;
 } PyEncoderObject;
 
+/* Output of the encoder.  If write is not NULL, the content of writer is
+   passed to it in chunks of about ENCODER_CHUNK_SIZE characters. */
+typedef struct {
+    _PyUnicodeWriter writer;
+    PyObject *write;
+} EncoderWriter;
+
+#define ENCODER_CHUNK_SIZE 65536
+
 static PyMemberDef encoder_members[] = {
     {"markers", T_OBJECT, offsetof(PyEncoderObject, markers), READONLY, "markers"},
     {"default", T_OBJECT, offsetof(PyEncoderObject, defaultfn), READONLY, "default"},
@@ -96,6 +147,8 @@ void init_json(void);
 static PyObject *
 scan_once_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
 static PyObject *
+scan_once_bytes(PyScannerObject *s, Py_buffer *view, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
+static PyObject *
 _build_rval_index_tuple(PyObject *rval, Py_ssize_t idx);
 static PyObject *
 scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
@@ -103,6 +156,8 @@ static void
 scanner_dealloc(PyObject *self);
 static int
 scanner_clear(PyObject *self);
+static int
+stream_scanner_clear(PyObject *self);
 static PyObject *
 encoder_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 static void
@@ -110,11 +165,11 @@ encoder_dealloc(PyObject *self);
 static int
 encoder_clear(PyObject *self);
 static int
-encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc, PyObject *seq, Py_ssize_t indent_level);
+encoder_listencode_list(PyEncoderObject *s, EncoderWriter *w, PyObject *seq, Py_ssize_t indent_level);
 static int
-encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc, PyObject *obj, Py_ssize_t indent_level);
+encoder_listencode_obj(PyEncoderObject *s, EncoderWriter *w, PyObject *obj, Py_ssize_t indent_level);
 static int
-encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc, PyObject *dct, Py_ssize_t indent_level);
+encoder_listencode_dict(PyEncoderObject *s, EncoderWriter *w, PyObject *dct, Py_ssize_t indent_level);
 static PyObject *
 _encoded_const(PyObject *obj);
 static void
@@ -163,27 +218,17 @@ ascii_escape_unichar(Py_UCS4 c, unsigned char *output, Py_ssize_t chars)
     return chars;
 }
 
-static PyObject *
-ascii_escape_unicode(PyObject *pystr)
+static Py_ssize_t
+ascii_escape_size(PyObject *pystr)
 {
-    /* Take a PyUnicode pystr and return a new ASCII-only escaped PyUnicode */
+    /* Return the length of the ASCII-only escaped ready PyUnicode pystr,
+       quotes included, or -1 on overflow */
     Py_ssize_t i;
-    Py_ssize_t input_chars;
+    Py_ssize_t input_chars = PyUnicode_GET_LENGTH(pystr);
     Py_ssize_t output_size;
-    Py_ssize_t chars;
-    PyObject *rval;
-    void *input;
-    unsigned char *output;
-    int kind;
-
-    if (PyUnicode_READY(pystr) == -1)
-        return NULL;
-
-    input_chars = PyUnicode_GET_LENGTH(pystr);
-    input = PyUnicode_DATA(pystr);
-    kind = PyUnicode_KIND(pystr);
+    void *input = PyUnicode_DATA(pystr);
+    int kind = PyUnicode_KIND(pystr);
 
-    /* Compute the output size */
     for (i = 0, output_size = 2; i < input_chars; i++) {
         Py_UCS4 c = PyUnicode_READ(kind, input, i);
         Py_ssize_t d;
@@ -201,17 +246,24 @@ ascii_escape_unicode(PyObject *pystr)
         }
         if (output_size > PY_SSIZE_T_MAX - d) {
             PyErr_SetString(PyExc_OverflowError, "string is too long to escape");
-            return NULL;
+            return -1;
         }
         output_size += d;
     }
+    return output_size;
+}
+
+static void
+ascii_escape_fill(PyObject *pystr, unsigned char *output)
+{
+    /* Write the ASCII-only escaped ready PyUnicode pystr to output, which
+       has room for ascii_escape_size(pystr) characters */
+    Py_ssize_t i;
+    Py_ssize_t input_chars = PyUnicode_GET_LENGTH(pystr);
+    Py_ssize_t chars = 0;
+    void *input = PyUnicode_DATA(pystr);
+    int kind = PyUnicode_KIND(pystr);
 
-    rval = PyUnicode_New(output_size, 127);
-    if (rval == NULL) {
-        return NULL;
-    }
-    output = PyUnicode_1BYTE_DATA(rval);
-    chars = 0;
     output[chars++] = '"';
     for (i = 0; i < input_chars; i++) {
         Py_UCS4 c = PyUnicode_READ(kind, input, i);
@@ -223,6 +275,26 @@ ascii_escape_unicode(PyObject *pystr)
         }
     }
     output[chars++] = '"';
+}
+
+static PyObject *
+ascii_escape_unicode(PyObject *pystr)
+{
+    /* Take a PyUnicode pystr and return a new ASCII-only escaped PyUnicode */
+    Py_ssize_t output_size;
+    PyObject *rval;
+
+    if (PyUnicode_READY(pystr) == -1)
+        return NULL;
+
+    output_size = ascii_escape_size(pystr);
+    if (output_size < 0)
+        return NULL;
+    rval = PyUnicode_New(output_size, 127);
+    if (rval == NULL) {
+        return NULL;
+    }
+    ascii_escape_fill(pystr, PyUnicode_1BYTE_DATA(rval));
 #ifdef Py_DEBUG
     assert(_PyUnicode_CheckConsistency(rval, 1));
 #endif
@@ -1167,120 +1239,1239 @@ scan_once_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ssize_
     return _match_number_unicode(s, pystr, idx, next_idx_ptr);
 }
 
-static PyObject *
-scanner_call(PyObject *self, PyObject *args, PyObject *kwds)
+static void
+raise_errmsg_bytes(const char *msg, Py_buffer *view, Py_ssize_t end)
 {
-    /* Python callable interface to scan_once_{str,unicode} */
-    PyObject *pystr;
-    PyObject *rval;
-    Py_ssize_t idx;
-    Py_ssize_t next_idx = -1;
-    static char *kwlist[] = {"string", "idx", NULL};
-    PyScannerObject *s;
-    assert(PyScanner_Check(self));
-    s = (PyScannerObject *)self;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:scan_once", kwlist, &pystr, &idx))
-        return NULL;
-
-    if (PyUnicode_Check(pystr)) {
-        rval = scan_once_unicode(s, pystr, idx, &next_idx);
-    }
-    else {
-        PyErr_Format(PyExc_TypeError,
-                 "first argument must be a string, not %.80s",
-                 Py_TYPE(pystr)->tp_name);
-        return NULL;
-    }
-    PyDict_Clear(s->memo);
-    if (rval == NULL)
-        return NULL;
-    return _build_rval_index_tuple(rval, next_idx);
+    /* Raise the JSONDecodeError of the bytes scanner: like json.loads(),
+       report it in the document decoded from UTF-8, at the index of the
+       character at byte offset end. */
+    const unsigned char *buf = view->buf;
+    Py_ssize_t i, pos = 0;
+    PyObject *doc;
+
+    doc = PyUnicode_DecodeUTF8(view->buf, view->len, "surrogatepass");
+    if (doc == NULL)
+        return;
+    /* Count the bytes which start a character */
+    for (i = 0; i < end; i++) {
+        if ((buf[i] & 0xC0) != 0x80)
+            pos++;
+    }
+    raise_errmsg(msg, doc, pos);
+    Py_DECREF(doc);
 }
 
 static PyObject *
-scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+scanstring_bytes(Py_buffer *view, Py_ssize_t end, int strict, Py_ssize_t *next_end_ptr)
 {
-    PyScannerObject *s;
-    PyObject *ctx;
-    PyObject *strict;
-    static char *kwlist[] = {"context", NULL};
+    /* Read the JSON string from the UTF-8 encoded buffer view, like
+    scanstring_unicode() but with indexes in bytes.
+    end is the index of the first byte after the quote.
+    if strict is zero then literal control characters are allowed
+    *next_end_ptr is a return-by-reference index of the byte after the end
+        quote
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:make_scanner", kwlist, &ctx))
-        return NULL;
+    Return value is a new PyUnicode
+    */
+    const unsigned char *buf = view->buf;
+    Py_ssize_t len = view->len;
+    Py_ssize_t begin = end - 1;
+    Py_ssize_t next;
+    int has_escape = 0;
+    _PyUnicodeWriter writer;
+    PyObject *chunk;
 
-    s = (PyScannerObject *)type->tp_alloc(type, 0);
-    if (s == NULL) {
-        return NULL;
+    _PyUnicodeWriter_Init(&writer);
+    writer.overallocate = 1;
+    while (1) {
+        /* Find the end of the string or the next escape.  Both are ASCII
+           bytes, which cannot be part of a multibyte UTF-8 sequence. */
+        Py_UCS4 c = 0;
+        for (next = end; next < len; next++) {
+            c = buf[next];
+            if (c == '"' || c == '\\') {
+                break;
+            }
+            else if (c <= 0x1f && strict) {
+                raise_errmsg_bytes("Invalid control character at", view, next);
+                goto bail;
+            }
+        }
+        if (next == len) {
+            raise_errmsg_bytes("Unterminated string starting at", view, begin);
+            goto bail;
+        }
+        if (c == '"' && !has_escape) {
+            /* Most strings have no escape: decode them in one go */
+            *next_end_ptr = next + 1;
+            return PyUnicode_DecodeUTF8((const char *)buf + end, next - end,
+                                        "surrogatepass");
+        }
+        has_escape = 1;
+        /* Pick up this chunk if it's not zero length */
+        if (next != end) {
+            chunk = PyUnicode_DecodeUTF8((const char *)buf + end, next - end,
+                                         "surrogatepass");
+            if (chunk == NULL)
+                goto bail;
+            if (_PyUnicodeWriter_WriteStr(&writer, chunk) < 0) {
+                Py_DECREF(chunk);
+                goto bail;
+            }
+            Py_DECREF(chunk);
+        }
+        next++;
+        if (c == '"') {
+            end = next;
+            break;
+        }
+        if (next == len) {
+            raise_errmsg_bytes("Unterminated string starting at", view, begin);
+            goto bail;
+        }
+        c = buf[next];
+        if (c != 'u') {
+            /* Non-unicode backslash escapes */
+            end = next + 1;
+            switch (c) {
+                case '"': break;
+                case '\\': break;
+                case '/': break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                default: c = 0;
+            }
+            if (c == 0) {
+                raise_errmsg_bytes("Invalid \\escape", view, end - 2);
+                goto bail;
+            }
+        }
+        else {
+            c = 0;
+            next++;
+            end = next + 4;
+            if (end >= len) {
+                raise_errmsg_bytes("Invalid \\uXXXX escape", view, next - 1);
+                goto bail;
+            }
+            /* Decode 4 hex digits */
+            for (; next < end; next++) {
+                Py_UCS4 digit = buf[next];
+                c <<= 4;
+                switch (digit) {
+                    case '0': case '1': case '2': case '3': case '4':
+                    case '5': case '6': case '7': case '8': case '9':
+                        c |= (digit - '0'); break;
+                    case 'a': case 'b': case 'c': case 'd': case 'e':
+                    case 'f':
+                        c |= (digit - 'a' + 10); break;
+                    case 'A': case 'B': case 'C': case 'D': case 'E':
+                    case 'F':
+                        c |= (digit - 'A' + 10); break;
+                    default:
+                        raise_errmsg_bytes("Invalid \\uXXXX escape", view, end - 5);
+                        goto bail;
+                }
+            }
+            /* Surrogate pair */
+            if (Py_UNICODE_IS_HIGH_SURROGATE(c) && end + 6 < len &&
+                buf[next++] == '\\' &&
+                buf[next++] == 'u') {
+                Py_UCS4 c2 = 0;
+                end += 6;
+                /* Decode 4 hex digits */
+                for (; next < end; next++) {
+                    Py_UCS4 digit = buf[next];
+                    c2 <<= 4;
+                    switch (digit) {
+                        case '0': case '1': case '2': case '3': case '4':
+                        case '5': case '6': case '7': case '8': case '9':
+                            c2 |= (digit - '0'); break;
+                        case 'a': case 'b': case 'c': case 'd': case 'e':
+                        case 'f':
+                            c2 |= (digit - 'a' + 10); break;
+                        case 'A': case 'B': case 'C': case 'D': case 'E':
+                        case 'F':
+                            c2 |= (digit - 'A' + 10); break;
+                        default:
+                            raise_errmsg_bytes("Invalid \\uXXXX escape", view, end - 5);
+                            goto bail;
+                    }
+                }
+                if (Py_UNICODE_IS_LOW_SURROGATE(c2))
+                    c = Py_UNICODE_JOIN_SURROGATES(c, c2);
+                else
+                    end -= 6;
+            }
+        }
+        if (_PyUnicodeWriter_WriteChar(&writer, c) < 0)
+            goto bail;
     }
 
-    s->memo = PyDict_New();
-    if (s->memo == NULL)
-        goto bail;
-
-    /* All of these will fail "gracefully" so we don't need to verify them */
-    strict = PyObject_GetAttrString(ctx, "strict");
-    if (strict == NULL)
-        goto bail;
-    s->strict = PyObject_IsTrue(strict);
-    Py_DECREF(strict);
-    if (s->strict < 0)
-        goto bail;
-    s->object_hook = PyObject_GetAttrString(ctx, "object_hook");
-    if (s->object_hook == NULL)
-        goto bail;
-    s->object_pairs_hook = PyObject_GetAttrString(ctx, "object_pairs_hook");
-    if (s->object_pairs_hook == NULL)
-        goto bail;
-    s->parse_float = PyObject_GetAttrString(ctx, "parse_float");
-    if (s->parse_float == NULL)
-        goto bail;
-    s->parse_int = PyObject_GetAttrString(ctx, "parse_int");
-    if (s->parse_int == NULL)
-        goto bail;
-    s->parse_constant = PyObject_GetAttrString(ctx, "parse_constant");
-    if (s->parse_constant == NULL)
-        goto bail;
-
-    return (PyObject *)s;
-
+    *next_end_ptr = end;
+    return _PyUnicodeWriter_Finish(&writer);
 bail:
-    Py_DECREF(s);
+    *next_end_ptr = -1;
+    _PyUnicodeWriter_Dealloc(&writer);
     return NULL;
 }
 
-PyDoc_STRVAR(scanner_doc, "JSON scanner object");
+static PyObject *
+_parse_object_bytes(PyScannerObject *s, Py_buffer *view, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+{
+    /* Read a JSON object from the UTF-8 encoded buffer view.
+    idx is the index of the first byte after the opening curly brace.
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the closing curly brace.
 
-static
-PyTypeObject PyScannerType = {
-    PyVarObject_HEAD_INIT(NULL, 0)
-    "_json.Scanner",       /* tp_name */
-    sizeof(PyScannerObject), /* tp_basicsize */
-    0,                    /* tp_itemsize */
-    scanner_dealloc, /* tp_dealloc */
-    0,                    /* tp_vectorcall_offset */
-    0,                    /* tp_getattr */
-    0,                    /* tp_setattr */
-    0,                    /* tp_as_async */
-    0,                    /* tp_repr */
-    0,                    /* tp_as_number */
-    0,                    /* tp_as_sequence */
-    0,                    /* tp_as_mapping */
-    0,                    /* tp_hash */
-    scanner_call,         /* tp_call */
-    0,                    /* tp_str */
-    0,/* PyObject_GenericGetAttr, */                    /* tp_getattro */
-    0,/* PyObject_GenericSetAttr, */                    /* tp_setattro */
-    0,                    /* tp_as_buffer */
-    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,   /* tp_flags */
-    scanner_doc,          /* tp_doc */
-    scanner_traverse,                    /* tp_traverse */
-    scanner_clear,                    /* tp_clear */
+    Returns a new PyObject (usually a dict, but object_hook can change that)
+    */
+    const unsigned char *str = view->buf;
+    Py_ssize_t end_idx = view->len - 1;
+    PyObject *val = NULL;
+    PyObject *rval = NULL;
+    PyObject *key = NULL;
+    int has_pairs_hook = (s->object_pairs_hook != Py_None);
+    Py_ssize_t next_idx;
+
+    if (has_pairs_hook)
+        rval = PyList_New(0);
+    else
+        rval = PyDict_New();
+    if (rval == NULL)
+        return NULL;
+
+    /* skip whitespace after { */
+    while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+    /* only loop if the object is non-empty */
+    if (idx > end_idx || str[idx] != '}') {
+        while (1) {
+            PyObject *memokey;
+
+            /* read key */
+            if (idx > end_idx || str[idx] != '"') {
+                raise_errmsg_bytes("Expecting property name enclosed in double quotes", view, idx);
+                goto bail;
+            }
+            key = scanstring_bytes(view, idx + 1, s->strict, &next_idx);
+            if (key == NULL)
+                goto bail;
+            memokey = PyDict_GetItemWithError(s->memo, key);
+            if (memokey != NULL) {
+                Py_INCREF(memokey);
+                Py_DECREF(key);
+                key = memokey;
+            }
+            else if (PyErr_Occurred()) {
+                goto bail;
+            }
+            else {
+                if (PyDict_SetItem(s->memo, key, key) < 0)
+                    goto bail;
+            }
+            idx = next_idx;
+
+            /* skip whitespace between key and : delimiter, read :, skip whitespace */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+            if (idx > end_idx || str[idx] != ':') {
+                raise_errmsg_bytes("Expecting ':' delimiter", view, idx);
+                goto bail;
+            }
+            idx++;
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+            /* read any JSON term */
+            val = scan_once_bytes(s, view, idx, &next_idx);
+            if (val == NULL)
+                goto bail;
+
+            if (has_pairs_hook) {
+                PyObject *item = PyTuple_Pack(2, key, val);
+                if (item == NULL)
+                    goto bail;
+                Py_CLEAR(key);
+                Py_CLEAR(val);
+                if (PyList_Append(rval, item) == -1) {
+                    Py_DECREF(item);
+                    goto bail;
+                }
+                Py_DECREF(item);
+            }
+            else {
+                if (PyDict_SetItem(rval, key, val) < 0)
+                    goto bail;
+                Py_CLEAR(key);
+                Py_CLEAR(val);
+            }
+            idx = next_idx;
+
+            /* skip whitespace before } or , */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+            /* bail if the object is closed or we didn't get the , delimiter */
+            if (idx <= end_idx && str[idx] == '}')
+                break;
+            if (idx > end_idx || str[idx] != ',') {
+                raise_errmsg_bytes("Expecting ',' delimiter", view, idx);
+                goto bail;
+            }
+            idx++;
+
+            /* skip whitespace after , delimiter */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+        }
+    }
+
+    *next_idx_ptr = idx + 1;
+
+    if (has_pairs_hook) {
+        val = _PyObject_CallOneArg(s->object_pairs_hook, rval);
+        Py_DECREF(rval);
+        return val;
+    }
+
+    /* if object_hook is not None: rval = object_hook(rval) */
+    if (s->object_hook != Py_None) {
+        val = _PyObject_CallOneArg(s->object_hook, rval);
+        Py_DECREF(rval);
+        return val;
+    }
+    return rval;
+bail:
+    Py_XDECREF(key);
+    Py_XDECREF(val);
+    Py_XDECREF(rval);
+    return NULL;
+}
+
+static PyObject *
+_parse_array_bytes(PyScannerObject *s, Py_buffer *view, Py_ssize_t idx, Py_ssize_t *next_idx_ptr) {
+    /* Read a JSON array from the UTF-8 encoded buffer view.
+    idx is the index of the first byte after the opening brace.
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the closing brace.
+
+    Returns a new PyList
+    */
+    const unsigned char *str = view->buf;
+    Py_ssize_t end_idx = view->len - 1;
+    PyObject *val = NULL;
+    PyObject *rval;
+    Py_ssize_t next_idx;
+
+    rval = PyList_New(0);
+    if (rval == NULL)
+        return NULL;
+
+    /* skip whitespace after [ */
+    while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+    /* only loop if the array is non-empty */
+    if (idx > end_idx || str[idx] != ']') {
+        while (1) {
+
+            /* read any JSON term  */
+            val = scan_once_bytes(s, view, idx, &next_idx);
+            if (val == NULL)
+                goto bail;
+
+            if (PyList_Append(rval, val) == -1)
+                goto bail;
+
+            Py_CLEAR(val);
+            idx = next_idx;
+
+            /* skip whitespace between term and , */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+            /* bail if the array is closed or we didn't get the , delimiter */
+            if (idx <= end_idx && str[idx] == ']')
+                break;
+            if (idx > end_idx || str[idx] != ',') {
+                raise_errmsg_bytes("Expecting ',' delimiter", view, idx);
+                goto bail;
+            }
+            idx++;
+
+            /* skip whitespace after , */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+        }
+    }
+
+    /* verify that idx < end_idx, str[idx] should be ']' */
+    if (idx > end_idx || str[idx] != ']') {
+        raise_errmsg_bytes("Expecting value", view, end_idx);
+        goto bail;
+    }
+    *next_idx_ptr = idx + 1;
+    return rval;
+bail:
+    Py_XDECREF(val);
+    Py_DECREF(rval);
+    return NULL;
+}
+
+static PyObject *
+_match_number_bytes(PyScannerObject *s, Py_buffer *view, Py_ssize_t start, Py_ssize_t *next_idx_ptr) {
+    /* Read a JSON number from the UTF-8 encoded buffer view.
+    idx is the index of the first byte of the number
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the number.
+
+    Returns a new PyObject representation of that number:
+        PyLong, or PyFloat.
+        May return other types if parse_int or parse_float are set
+    */
+    const char *str = view->buf;
+    Py_ssize_t end_idx = view->len - 1;
+    Py_ssize_t idx = start;
+    int is_float = 0;
+    PyObject *rval;
+    PyObject *custom_func;
+
+    /* read a sign if it's there, make sure it's not the end of the string */
+    if (str[idx] == '-') {
+        idx++;
+        if (idx > end_idx) {
+            raise_stop_iteration(start);
+            return NULL;
+        }
+    }
+
+    /* read as many integer digits as we find as long as it doesn't start with 0 */
+    if (str[idx] >= '1' && str[idx] <= '9') {
+        idx++;
+        while (idx <= end_idx && str[idx] >= '0' && str[idx] <= '9') idx++;
+    }
+    /* if it starts with 0 we only expect one integer digit */
+    else if (str[idx] == '0') {
+        idx++;
+    }
+    /* no integer digits, error */
+    else {
+        raise_stop_iteration(start);
+        return NULL;
+    }
+
+    /* if the next char is '.' followed by a digit then read all float digits */
+    if (idx < end_idx && str[idx] == '.' && str[idx + 1] >= '0' && str[idx + 1] <= '9') {
+        is_float = 1;
+        idx += 2;
+        while (idx <= end_idx && str[idx] >= '0' && str[idx] <= '9') idx++;
+    }
+
+    /* if the next char is 'e' or 'E' then maybe read the exponent (or backtrack) */
+    if (idx < end_idx && (str[idx] == 'e' || str[idx] == 'E')) {
+        Py_ssize_t e_start = idx;
+        idx++;
+
+        /* read an exponent sign if present */
+        if (idx < end_idx && (str[idx] == '-' || str[idx] == '+')) idx++;
+
+        /* read all digits */
+        while (idx <= end_idx && str[idx] >= '0' && str[idx] <= '9') idx++;
+
+        /* if we got a digit, then parse as float. if not, backtrack */
+        if (str[idx - 1] >= '0' && str[idx - 1] <= '9') {
+            is_float = 1;
+        }
+        else {
+            idx = e_start;
+        }
+    }
+
+    if (is_float && s->parse_float != (PyObject *)&PyFloat_Type)
+        custom_func = s->parse_float;
+    else if (!is_float && s->parse_int != (PyObject *) &PyLong_Type)
+        custom_func = s->parse_int;
+    else
+        custom_func = NULL;
+
+    if (custom_func) {
+        /* copy the section we determined to be a number */
+        PyObject *numstr = PyUnicode_DecodeASCII(str + start, idx - start,
+                                                 NULL);
+        if (numstr == NULL)
+            return NULL;
+        rval = _PyObject_CallOneArg(custom_func, numstr);
+        Py_DECREF(numstr);
+    }
+    else {
+        /* The conversion functions need a NUL terminated copy, which
+           fits on the stack for all but huge numbers */
+        char small[64];
+        char *buf = small;
+        Py_ssize_t n = idx - start;
+
+        if (n >= (Py_ssize_t)sizeof(small)) {
+            buf = PyMem_Malloc(n + 1);
+            if (buf == NULL)
+                return PyErr_NoMemory();
+        }
+        memcpy(buf, str + start, n);
+        buf[n] = '\0';
+        if (is_float) {
+            double d = PyOS_string_to_double(buf, NULL, NULL);
+            if (d == -1.0 && PyErr_Occurred())
+                rval = NULL;
+            else
+                rval = PyFloat_FromDouble(d);
+        }
+        else {
+            rval = PyLong_FromString(buf, NULL, 10);
+        }
+        if (buf != small)
+            PyMem_Free(buf);
+    }
+    *next_idx_ptr = idx;
+    return rval;
+}
+
+static PyObject *
+scan_once_bytes(PyScannerObject *s, Py_buffer *view, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+{
+    /* Read one JSON term (of any kind) from the UTF-8 encoded buffer view.
+    idx is the index of the first byte of the term
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the term.
+
+    Strings are decoded from UTF-8 as they are found, so that the document
+    is never decoded as a whole.
+
+    Returns a new PyObject representation of the term.
+    */
+    PyObject *res;
+    const char *str = view->buf;
+    Py_ssize_t length = view->len;
+
+    if (idx < 0) {
+        PyErr_SetString(PyExc_ValueError, "idx cannot be negative");
+        return NULL;
+    }
+    if (idx >= length) {
+        raise_stop_iteration(idx);
+        return NULL;
+    }
+
+    switch (str[idx]) {
+        case '"':
+            /* string */
+            return scanstring_bytes(view, idx + 1, s->strict, next_idx_ptr);
+        case '{':
+            /* object */
+            if (Py_EnterRecursiveCall(" while decoding a JSON object "
+                                      "from a bytes-like object"))
+                return NULL;
+            res = _parse_object_bytes(s, view, idx + 1, next_idx_ptr);
+            Py_LeaveRecursiveCall();
+            return res;
+        case '[':
+            /* array */
+            if (Py_EnterRecursiveCall(" while decoding a JSON array "
+                                      "from a bytes-like object"))
+                return NULL;
+            res = _parse_array_bytes(s, view, idx + 1, next_idx_ptr);
+            Py_LeaveRecursiveCall();
+            return res;
+        case 'n':
+            /* null */
+            if ((idx + 3 < length) && memcmp(str + idx + 1, "ull", 3) == 0) {
+                *next_idx_ptr = idx + 4;
+                Py_RETURN_NONE;
+            }
+            break;
+        case 't':
+            /* true */
+            if ((idx + 3 < length) && memcmp(str + idx + 1, "rue", 3) == 0) {
+                *next_idx_ptr = idx + 4;
+                Py_RETURN_TRUE;
+            }
+            break;
+        case 'f':
+            /* false */
+            if ((idx + 4 < length) && memcmp(str + idx + 1, "alse", 4) == 0) {
+                *next_idx_ptr = idx + 5;
+                Py_RETURN_FALSE;
+            }
+            break;
+        case 'N':
+            /* NaN */
+            if ((idx + 2 < length) && memcmp(str + idx + 1, "aN", 2) == 0) {
+                return _parse_constant(s, "NaN", idx, next_idx_ptr);
+            }
+            break;
+        case 'I':
+            /* Infinity */
+            if ((idx + 7 < length) && memcmp(str + idx + 1, "nfinity", 7) == 0) {
+                return _parse_constant(s, "Infinity", idx, next_idx_ptr);
+            }
+            break;
+        case '-':
+            /* -Infinity */
+            if ((idx + 8 < length) && memcmp(str + idx + 1, "Infinity", 8) == 0) {
+                return _parse_constant(s, "-Infinity", idx, next_idx_ptr);
+            }
+            break;
+    }
+    /* Didn't find a string, object, array, or named constant. Look for a number. */
+    return _match_number_bytes(s, view, idx, next_idx_ptr);
+}
+
+static PyObject *
+scanner_call(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    /* Python callable interface to scan_once_{str,unicode} */
+    PyObject *pystr;
+    PyObject *rval;
+    Py_ssize_t idx;
+    Py_ssize_t next_idx = -1;
+    static char *kwlist[] = {"string", "idx", NULL};
+    PyScannerObject *s;
+    assert(PyScanner_Check(self));
+    s = (PyScannerObject *)self;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:scan_once", kwlist, &pystr, &idx))
+        return NULL;
+
+    if (PyUnicode_Check(pystr)) {
+        rval = scan_once_unicode(s, pystr, idx, &next_idx);
+    }
+    else if (PyObject_CheckBuffer(pystr)) {
+        /* UTF-8 encoded document, idx and next_idx are in bytes */
+        Py_buffer view;
+        if (PyObject_GetBuffer(pystr, &view, PyBUF_SIMPLE) < 0)
+            return NULL;
+        rval = scan_once_bytes(s, &view, idx, &next_idx);
+        PyBuffer_Release(&view);
+    }
+    else {
+        PyErr_Format(PyExc_TypeError,
+                 "first argument must be a string or a bytes-like object, "
+                 "not %.80s",
+                 Py_TYPE(pystr)->tp_name);
+        return NULL;
+    }
+    PyDict_Clear(s->memo);
+    if (rval == NULL)
+        return NULL;
+    return _build_rval_index_tuple(rval, next_idx);
+}
+
+static PyObject *
+scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyScannerObject *s;
+    PyObject *ctx;
+    PyObject *strict;
+    static char *kwlist[] = {"context", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:make_scanner", kwlist, &ctx))
+        return NULL;
+
+    s = (PyScannerObject *)type->tp_alloc(type, 0);
+    if (s == NULL) {
+        return NULL;
+    }
+
+    s->memo = PyDict_New();
+    if (s->memo == NULL)
+        goto bail;
+
+    /* All of these will fail "gracefully" so we don't need to verify them */
+    strict = PyObject_GetAttrString(ctx, "strict");
+    if (strict == NULL)
+        goto bail;
+    s->strict = PyObject_IsTrue(strict);
+    Py_DECREF(strict);
+    if (s->strict < 0)
+        goto bail;
+    s->object_hook = PyObject_GetAttrString(ctx, "object_hook");
+    if (s->object_hook == NULL)
+        goto bail;
+    s->object_pairs_hook = PyObject_GetAttrString(ctx, "object_pairs_hook");
+    if (s->object_pairs_hook == NULL)
+        goto bail;
+    s->parse_float = PyObject_GetAttrString(ctx, "parse_float");
+    if (s->parse_float == NULL)
+        goto bail;
+    s->parse_int = PyObject_GetAttrString(ctx, "parse_int");
+    if (s->parse_int == NULL)
+        goto bail;
+    s->parse_constant = PyObject_GetAttrString(ctx, "parse_constant");
+    if (s->parse_constant == NULL)
+        goto bail;
+
+    return (PyObject *)s;
+
+bail:
+    Py_DECREF(s);
+    return NULL;
+}
+
+PyDoc_STRVAR(scanner_doc, "JSON scanner object");
+
+static
+PyTypeObject PyScannerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_json.Scanner",       /* tp_name */
+    sizeof(PyScannerObject), /* tp_basicsize */
+    0,                    /* tp_itemsize */
+    scanner_dealloc, /* tp_dealloc */
+    0,                    /* tp_vectorcall_offset */
+    0,                    /* tp_getattr */
+    0,                    /* tp_setattr */
+    0,                    /* tp_as_async */
+    0,                    /* tp_repr */
+    0,                    /* tp_as_number */
+    0,                    /* tp_as_sequence */
+    0,                    /* tp_as_mapping */
+    0,                    /* tp_hash */
+    scanner_call,         /* tp_call */
+    0,                    /* tp_str */
+    0,/* PyObject_GenericGetAttr, */                    /* tp_getattro */
+    0,/* PyObject_GenericSetAttr, */                    /* tp_setattro */
+    0,                    /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,   /* tp_flags */
+    scanner_doc,          /* tp_doc */
+    scanner_traverse,                    /* tp_traverse */
+    scanner_clear,                    /* tp_clear */
+    0,                    /* tp_richcompare */
+    0,                    /* tp_weaklistoffset */
+    0,                    /* tp_iter */
+    0,                    /* tp_iternext */
+    0,                    /* tp_methods */
+    scanner_members,                    /* tp_members */
+    0,                    /* tp_getset */
+    0,                    /* tp_base */
+    0,                    /* tp_dict */
+    0,                    /* tp_descr_get */
+    0,                    /* tp_descr_set */
+    0,                    /* tp_dictoffset */
+    0,                    /* tp_init */
+    0,/* PyType_GenericAlloc, */        /* tp_alloc */
+    scanner_new,          /* tp_new */
+    0,/* PyObject_GC_Del, */              /* tp_free */
+};
+
+/* The stream scanner splits a stream of text into JSON values: feed() only
+   tracks the nesting of containers and strings to find where each value
+   ends, keeping the parts of the current value in a list, and hands the
+   text of every complete value to the scanner of the context.  Only the
+   current value is kept in memory. */
+
+static void
+stream_scanner_reset(PyStreamScannerObject *s)
+{
+    s->state = s->array ? STREAM_ARRAY_START : STREAM_VALUE;
+    s->depth = 0;
+    s->in_string = 0;
+    s->escape = 0;
+}
+
+static void
+stream_scanner_reset_position(PyStreamScannerObject *s)
+{
+    s->offset = 0;
+    s->counted = 0;
+    s->lineno = 1;
+    s->linestart = 0;
+    s->value_offset = 0;
+    s->value_lineno = 1;
+    s->value_linestart = 0;
+}
+
+static void
+stream_scanner_advance(PyStreamScannerObject *s, int kind, void *str,
+                       Py_ssize_t idx)
+{
+    /* Count the lines up to str[idx] */
+    Py_ssize_t i;
+
+    if (kind == PyUnicode_1BYTE_KIND) {
+        const char *p = (const char *)str + s->counted;
+        const char *end = (const char *)str + idx;
+        while ((p = memchr(p, '\n', end - p)) != NULL) {
+            p++;
+            s->lineno++;
+            s->linestart = s->offset + (p - (const char *)str);
+        }
+    }
+    else {
+        for (i = s->counted; i < idx; i++) {
+            if (PyUnicode_READ(kind, str, i) == '\n') {
+                s->lineno++;
+                s->linestart = s->offset + i + 1;
+            }
+        }
+    }
+    s->counted = idx;
+}
+
+static void
+stream_scanner_error_position(Py_ssize_t offset, Py_ssize_t lineno,
+                              Py_ssize_t linestart)
+{
+    /* The current exception, if a JSONDecodeError, was raised in a text
+       found at index offset of the stream, on line lineno which starts at
+       index linestart: make its positions positions in the stream */
+    PyObject *type, *value, *tb, *decoder, *res;
+
+    PyErr_Fetch(&type, &value, &tb);
+    PyErr_NormalizeException(&type, &value, &tb);
+    decoder = PyImport_ImportModule("json.decoder");
+    if (decoder == NULL)
+        goto error;
+    res = PyObject_CallMethod(decoder, "_stream_error_position", "Onnn",
+                              value, offset, lineno, linestart);
+    Py_DECREF(decoder);
+    if (res == NULL)
+        goto error;
+    Py_DECREF(res);
+    PyErr_Restore(type, value, tb);
+    return;
+
+  error:
+    Py_XDECREF(type);
+    Py_XDECREF(value);
+    Py_XDECREF(tb);
+}
+
+static PyObject *
+stream_scanner_decode(PyStreamScannerObject *s, PyObject *pystr)
+{
+    /* Decode pystr, which must be the text of one value */
+    PyObject *rval;
+    Py_ssize_t next_idx = -1;
+
+    if (PyScanner_CheckExact(s->scan_once)) {
+        PyScannerObject *scanner = (PyScannerObject *)s->scan_once;
+        rval = scan_once_unicode(scanner, pystr, 0, &next_idx);
+        PyDict_Clear(scanner->memo);
+    }
+    else {
+        PyObject *res = PyObject_CallFunction(s->scan_once, "On", pystr,
+                                              (Py_ssize_t)0);
+        if (res == NULL) {
+            rval = NULL;
+        }
+        else if (!PyTuple_Check(res) || PyTuple_GET_SIZE(res) != 2) {
+            PyErr_SetString(PyExc_TypeError,
+                            "scan_once must return a 2-tuple");
+            Py_DECREF(res);
+            return NULL;
+        }
+        else {
+            rval = PyTuple_GET_ITEM(res, 0);
+            Py_INCREF(rval);
+            next_idx = PyLong_AsSsize_t(PyTuple_GET_ITEM(res, 1));
+            Py_DECREF(res);
+            if (next_idx == -1 && PyErr_Occurred()) {
+                Py_DECREF(rval);
+                return NULL;
+            }
+        }
+    }
+    if (rval == NULL) {
+        if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
+            PyErr_Clear();
+            raise_errmsg("Expecting value", pystr, 0);
+        }
+        return NULL;
+    }
+    if (next_idx != PyUnicode_GET_LENGTH(pystr)) {
+        raise_errmsg("Extra data", pystr, next_idx);
+        Py_DECREF(rval);
+        return NULL;
+    }
+    return rval;
+}
+
+static int
+stream_scanner_end_value(PyStreamScannerObject *s, PyObject *pystr,
+                         Py_ssize_t start, Py_ssize_t end, PyObject *values)
+{
+    /* The current value ends at pystr[end]: decode it, append it to
+       values, and expect the next one */
+    PyObject *text, *rval;
+    int res;
+
+    text = PyUnicode_Substring(pystr, start, end);
+    if (text == NULL)
+        return -1;
+    if (PyList_GET_SIZE(s->pending)) {
+        res = PyList_Append(s->pending, text);
+        Py_DECREF(text);
+        if (res < 0)
+            return -1;
+        text = join_list_unicode(s->pending);
+        if (text == NULL)
+            return -1;
+        if (PyList_SetSlice(s->pending, 0, PY_SSIZE_T_MAX, NULL) < 0) {
+            Py_DECREF(text);
+            return -1;
+        }
+    }
+    rval = stream_scanner_decode(s, text);
+    Py_DECREF(text);
+    if (rval == NULL) {
+        stream_scanner_error_position(s->value_offset, s->value_lineno,
+                                      s->value_linestart);
+        return -1;
+    }
+    res = PyList_Append(values, rval);
+    Py_DECREF(rval);
+    s->state = s->array ? STREAM_ARRAY_NEXT : STREAM_VALUE_END;
+    return res;
+}
+
+PyDoc_STRVAR(stream_scanner_feed_doc,
+"feed(string) -> list\n"
+"\n"
+"Scan the next part of the stream, and return the list of the values which\n"
+"it completes.");
+
+static PyObject *
+stream_scanner_feed(PyObject *self, PyObject *pystr)
+{
+    PyStreamScannerObject *s;
+    PyObject *values;
+    void *str;
+    int kind;
+    Py_ssize_t len, idx, start = 0;
+    Py_ssize_t part_lineno, part_linestart;
+    Py_UCS4 c;
+
+    assert(PyStreamScanner_Check(self));
+    s = (PyStreamScannerObject *)self;
+    if (!PyUnicode_Check(pystr)) {
+        PyErr_Format(PyExc_TypeError,
+                     "first argument must be a string, not %.80s",
+                     Py_TYPE(pystr)->tp_name);
+        return NULL;
+    }
+    if (PyUnicode_READY(pystr) == -1)
+        return NULL;
+    str = PyUnicode_DATA(pystr);
+    kind = PyUnicode_KIND(pystr);
+    len = PyUnicode_GET_LENGTH(pystr);
+
+    values = PyList_New(0);
+    if (values == NULL)
+        return NULL;
+
+    /* Position of the start of the part, for the errors in it */
+    part_lineno = s->lineno;
+    part_linestart = s->linestart;
+    for (idx = 0; idx < len; idx++) {
+        c = PyUnicode_READ(kind, str, idx);
+        switch (s->state) {
+        case STREAM_CONTAINER:
+            if (s->in_string) {
+                if (s->escape)
+                    s->escape = 0;
+                else if (c == '\\')
+                    s->escape = 1;
+                else if (c == '"')
+                    s->in_string = 0;
+            }
+            else if (c == '"') {
+                s->in_string = 1;
+            }
+            else if (c == '{' || c == '[') {
+                s->depth++;
+            }
+            else if (c == '}' || c == ']') {
+                if (--s->depth == 0 &&
+                    stream_scanner_end_value(s, pystr, start, idx + 1,
+                                             values) < 0)
+                    goto bail;
+            }
+            continue;
+        case STREAM_STRING:
+            if (s->escape)
+                s->escape = 0;
+            else if (c == '\\')
+                s->escape = 1;
+            else if (c == '"' &&
+                     stream_scanner_end_value(s, pystr, start, idx + 1,
+                                              values) < 0)
+                goto bail;
+            continue;
+        case STREAM_SCALAR:
+            if (IS_WHITESPACE(c) || c == ',' || c == ']' || c == '}' ||
+                c == '[' || c == '{' || c == '"') {
+                if (stream_scanner_end_value(s, pystr, start, idx,
+                                             values) < 0)
+                    goto bail;
+                /* scan c again after the value */
+                idx--;
+            }
+            continue;
+        case STREAM_VALUE_END:
+            /* Documents are separated by whitespace */
+            if (!IS_WHITESPACE(c)) {
+                raise_errmsg("Extra data", pystr, idx);
+                goto part_error;
+            }
+            s->state = STREAM_VALUE;
+            continue;
+        }
+
+        /* Between values */
+        if (IS_WHITESPACE(c))
+            continue;
+        switch (s->state) {
+        case STREAM_ARRAY_START:
+            if (c != '[') {
+                raise_errmsg("Expecting '['", pystr, idx);
+                goto part_error;
+            }
+            s->state = STREAM_ARRAY_FIRST;
+            continue;
+        case STREAM_ARRAY_FIRST:
+            if (c == ']') {
+                s->state = STREAM_ARRAY_END;
+                continue;
+            }
+            break;
+        case STREAM_ARRAY_NEXT:
+            if (c == ',') {
+                s->state = STREAM_ARRAY_ELEMENT;
+            }
+            else if (c == ']') {
+                s->state = STREAM_ARRAY_END;
+            }
+            else {
+                raise_errmsg("Expecting ',' delimiter", pystr, idx);
+                goto part_error;
+            }
+            continue;
+        case STREAM_ARRAY_END:
+            raise_errmsg("Extra data", pystr, idx);
+            goto part_error;
+        }
+
+        /* Start of a value */
+        if (c == ']' || c == '}' || c == ',' || c == ':') {
+            raise_errmsg("Expecting value", pystr, idx);
+            goto part_error;
+        }
+        start = idx;
+        stream_scanner_advance(s, kind, str, idx);
+        s->value_offset = s->offset + idx;
+        s->value_lineno = s->lineno;
+        s->value_linestart = s->linestart;
+        if (c == '{' || c == '[') {
+            s->state = STREAM_CONTAINER;
+            s->depth = 1;
+            s->in_string = 0;
+            s->escape = 0;
+        }
+        else if (c == '"') {
+            s->state = STREAM_STRING;
+            s->escape = 0;
+        }
+        else {
+            s->state = STREAM_SCALAR;
+        }
+    }
+
+    if (s->state >= STREAM_CONTAINER) {
+        /* Keep the start of the current value for the next call */
+        PyObject *part = PyUnicode_Substring(pystr, start, len);
+        if (part == NULL)
+            goto bail;
+        if (PyList_Append(s->pending, part) < 0) {
+            Py_DECREF(part);
+            goto bail;
+        }
+        Py_DECREF(part);
+    }
+    stream_scanner_advance(s, kind, str, len);
+    s->offset += len;
+    s->counted = 0;
+    return values;
+
+part_error:
+    stream_scanner_error_position(s->offset, part_lineno, part_linestart);
+bail:
+    /* Start again from scratch at the next part after an error */
+    PyList_SetSlice(s->pending, 0, PY_SSIZE_T_MAX, NULL);
+    stream_scanner_reset(s);
+    stream_scanner_advance(s, kind, str, len);
+    s->offset += len;
+    s->counted = 0;
+    Py_DECREF(values);
+    return NULL;
+}
+
+PyDoc_STRVAR(stream_scanner_close_doc,
+"close() -> list\n"
+"\n"
+"End the stream, and return the list of the values which it completes.\n"
+"The scanner can then scan a new stream.");
+
+static PyObject *
+stream_scanner_close(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyStreamScannerObject *s;
+    PyObject *values, *text = NULL, *empty;
+    int state;
+
+    assert(PyStreamScanner_Check(self));
+    s = (PyStreamScannerObject *)self;
+    values = PyList_New(0);
+    if (values == NULL)
+        return NULL;
+
+    if (s->state >= STREAM_CONTAINER) {
+        /* Only a scalar can end with the stream, the scanner reports why
+           other values are incomplete. */
+        text = join_list_unicode(s->pending);
+        if (text == NULL)
+            goto bail;
+        if (PyList_SetSlice(s->pending, 0, PY_SSIZE_T_MAX, NULL) < 0)
+            goto bail;
+        if (stream_scanner_end_value(s, text, 0, PyUnicode_GET_LENGTH(text),
+                                     values) < 0)
+            goto bail;
+        Py_CLEAR(text);
+    }
+
+    state = s->state;
+    if (state != STREAM_VALUE && state != STREAM_VALUE_END &&
+        state != STREAM_ARRAY_END) {
+        empty = PyUnicode_New(0, 0);
+        if (empty == NULL)
+            goto bail;
+        raise_errmsg(state == STREAM_ARRAY_NEXT ? "Expecting ',' delimiter"
+                                                : "Expecting value",
+                     empty, 0);
+        Py_DECREF(empty);
+        stream_scanner_error_position(s->offset, s->lineno, s->linestart);
+        goto bail;
+    }
+    stream_scanner_reset(s);
+    stream_scanner_reset_position(s);
+    return values;
+
+bail:
+    Py_XDECREF(text);
+    PyList_SetSlice(s->pending, 0, PY_SSIZE_T_MAX, NULL);
+    stream_scanner_reset(s);
+    stream_scanner_reset_position(s);
+    Py_DECREF(values);
+    return NULL;
+}
+
+static void
+stream_scanner_dealloc(PyObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    stream_scanner_clear(self);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int
+stream_scanner_traverse(PyObject *self, visitproc visit, void *arg)
+{
+    PyStreamScannerObject *s;
+    assert(PyStreamScanner_Check(self));
+    s = (PyStreamScannerObject *)self;
+    Py_VISIT(s->scan_once);
+    Py_VISIT(s->pending);
+    return 0;
+}
+
+static int
+stream_scanner_clear(PyObject *self)
+{
+    PyStreamScannerObject *s;
+    assert(PyStreamScanner_Check(self));
+    s = (PyStreamScannerObject *)self;
+    Py_CLEAR(s->scan_once);
+    Py_CLEAR(s->pending);
+    return 0;
+}
+
+static PyObject *
+stream_scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyStreamScannerObject *s;
+    PyObject *ctx;
+    int array = 0;
+    static char *kwlist[] = {"context", "array", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|p:make_stream_scanner",
+                                     kwlist, &ctx, &array))
+        return NULL;
+
+    s = (PyStreamScannerObject *)type->tp_alloc(type, 0);
+    if (s == NULL) {
+        return NULL;
+    }
+    s->array = (char)array;
+    stream_scanner_reset(s);
+    stream_scanner_reset_position(s);
+
+    s->pending = PyList_New(0);
+    if (s->pending == NULL)
+        goto bail;
+    s->scan_once = PyObject_GetAttrString(ctx, "scan_once");
+    if (s->scan_once == NULL)
+        goto bail;
+
+    return (PyObject *)s;
+
+bail:
+    Py_DECREF(s);
+    return NULL;
+}
+
+static PyMethodDef stream_scanner_methods[] = {
+    {"feed", (PyCFunction)stream_scanner_feed, METH_O,
+     stream_scanner_feed_doc},
+    {"close", (PyCFunction)stream_scanner_close, METH_NOARGS,
+     stream_scanner_close_doc},
+    {NULL, NULL}
+};
+
+PyDoc_STRVAR(stream_scanner_doc, "JSON stream scanner object");
+
+static
+PyTypeObject PyStreamScannerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_json.StreamScanner",  /* tp_name */
+    sizeof(PyStreamScannerObject), /* tp_basicsize */
+    0,                    /* tp_itemsize */
+    stream_scanner_dealloc, /* tp_dealloc */
+    0,                    /* tp_vectorcall_offset */
+    0,                    /* tp_getattr */
+    0,                    /* tp_setattr */
+    0,                    /* tp_as_async */
+    0,                    /* tp_repr */
+    0,                    /* tp_as_number */
+    0,                    /* tp_as_sequence */
+    0,                    /* tp_as_mapping */
+    0,                    /* tp_hash */
+    0,                    /* tp_call */
+    0,                    /* tp_str */
+    0,                    /* tp_getattro */
+    0,                    /* tp_setattro */
+    0,                    /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,   /* tp_flags */
+    stream_scanner_doc,   /* tp_doc */
+    stream_scanner_traverse, /* tp_traverse */
+    stream_scanner_clear, /* tp_clear */
     0,                    /* tp_richcompare */
     0,                    /* tp_weaklistoffset */
     0,                    /* tp_iter */
     0,                    /* tp_iternext */
-    0,                    /* tp_methods */
-    scanner_members,                    /* tp_members */
+    stream_scanner_methods, /* tp_methods */
+    stream_scanner_members, /* tp_members */
     0,                    /* tp_getset */
     0,                    /* tp_base */
     0,                    /* tp_dict */
@@ -1288,9 +2479,9 @@ PyTypeObject PyScannerType = {
     0,                    /* tp_descr_set */
     0,                    /* tp_dictoffset */
     0,                    /* tp_init */
-    0,/* PyType_GenericAlloc, */        /* tp_alloc */
-    scanner_new,          /* tp_new */
-    0,/* PyObject_GC_Del, */              /* tp_free */
+    0,                    /* tp_alloc */
+    stream_scanner_new,   /* tp_new */
+    0,                    /* tp_free */
 };
 
 static PyObject *
@@ -1351,24 +2542,70 @@ static PyObject *
 encoder_call(PyObject *self, PyObject *args, PyObject *kwds)
 {
     /* Python callable interface to encode_listencode_obj */
-    static char *kwlist[] = {"obj", "_current_indent_level", NULL};
+    static char *kwlist[] = {"obj", "_current_indent_level", "write", NULL};
     PyObject *obj;
+    PyObject *write = Py_None;
+    PyObject *result, *res;
     Py_ssize_t indent_level;
     PyEncoderObject *s;
-    _PyAccu acc;
+    EncoderWriter w;
 
     assert(PyEncoder_Check(self));
     s = (PyEncoderObject *)self;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:_iterencode", kwlist,
-        &obj, &indent_level))
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On|O:_iterencode", kwlist,
+        &obj, &indent_level, &write))
         return NULL;
-    if (_PyAccu_Init(&acc))
+    _PyUnicodeWriter_Init(&w.writer);
+    w.writer.overallocate = 1;
+    w.write = (write != Py_None) ? write : NULL;
+    if (encoder_listencode_obj(s, &w, obj, indent_level)) {
+        _PyUnicodeWriter_Dealloc(&w.writer);
         return NULL;
-    if (encoder_listencode_obj(s, &acc, obj, indent_level)) {
-        _PyAccu_Destroy(&acc);
+    }
+    result = _PyUnicodeWriter_Finish(&w.writer);
+    if (result == NULL)
         return NULL;
+    if (w.write == NULL) {
+        /* A single chunk, which ''.join() returns without copying it */
+        res = PyList_New(1);
+        if (res == NULL) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(res, 0, result);
+        return res;
+    }
+    if (PyUnicode_GET_LENGTH(result) == 0) {
+        Py_DECREF(result);
+        Py_RETURN_NONE;
     }
-    return _PyAccu_FinishAsList(&acc);
+    res = _PyObject_CallOneArg(w.write, result);
+    Py_DECREF(result);
+    if (res == NULL)
+        return NULL;
+    Py_DECREF(res);
+    Py_RETURN_NONE;
+}
+
+static int
+encoder_flush(EncoderWriter *w)
+{
+    /* Pass the output to write() once it is long enough */
+    PyObject *chunk, *res;
+
+    if (w->write == NULL || w->writer.pos < ENCODER_CHUNK_SIZE)
+        return 0;
+    chunk = _PyUnicodeWriter_Finish(&w->writer);
+    _PyUnicodeWriter_Init(&w->writer);
+    w->writer.overallocate = 1;
+    if (chunk == NULL)
+        return -1;
+    res = _PyObject_CallOneArg(w->write, chunk);
+    Py_DECREF(chunk);
+    if (res == NULL)
+        return -1;
+    Py_DECREF(res);
+    return 0;
 }
 
 static PyObject *
@@ -1452,58 +2689,150 @@ encoder_encode_string(PyEncoderObject *s, PyObject *obj)
 }
 
 static int
-_steal_accumulate(_PyAccu *acc, PyObject *stolen)
+_steal_write(_PyUnicodeWriter *writer, PyObject *stolen)
 {
-    /* Append stolen and then decrement its reference count */
-    int rval = _PyAccu_Accumulate(acc, stolen);
+    /* Write stolen and then decrement its reference count */
+    int rval;
+    if (stolen == NULL)
+        return -1;
+    rval = _PyUnicodeWriter_WriteStr(writer, stolen);
     Py_DECREF(stolen);
     return rval;
 }
 
 static int
-encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
+encoder_write_string(PyEncoderObject *s, _PyUnicodeWriter *writer,
+                     PyObject *obj)
+{
+    /* Write the JSON representation of a string.  The builtin encoders
+       write it in place, and plain strings are just copied. */
+    Py_ssize_t i, len, size;
+    const void *data;
+    int kind;
+    Py_UCS1 *out;
+
+    if (s->fast_encode == NULL)
+        return _steal_write(writer, encoder_encode_string(s, obj));
+    if (PyUnicode_READY(obj) == -1)
+        return -1;
+    len = PyUnicode_GET_LENGTH(obj);
+    if (s->fast_encode == (PyCFunction)py_encode_basestring) {
+        data = PyUnicode_DATA(obj);
+        kind = PyUnicode_KIND(obj);
+        for (i = 0; i < len; i++) {
+            Py_UCS4 c = PyUnicode_READ(kind, data, i);
+            if (c == '"' || c == '\\' || c <= 0x1f)
+                return _steal_write(writer, escape_unicode(obj));
+        }
+        if (_PyUnicodeWriter_WriteChar(writer, '"') < 0 ||
+            _PyUnicodeWriter_WriteStr(writer, obj) < 0)
+            return -1;
+        return _PyUnicodeWriter_WriteChar(writer, '"');
+    }
+
+    size = ascii_escape_size(obj);
+    if (size < 0)
+        return -1;
+    if (_PyUnicodeWriter_Prepare(writer, size, 127) < 0)
+        return -1;
+    if (writer->kind != PyUnicode_1BYTE_KIND)
+        return _steal_write(writer, ascii_escape_unicode(obj));
+    out = (Py_UCS1 *)writer->data + writer->pos;
+    if (size == len + 2) {
+        /* Only ASCII characters which need no escape */
+        out[0] = '"';
+        memcpy(out + 1, PyUnicode_1BYTE_DATA(obj), len);
+        out[len + 1] = '"';
+    }
+    else {
+        ascii_escape_fill(obj, out);
+    }
+    writer->pos += size;
+    return 0;
+}
+
+static int
+encoder_write_long(_PyUnicodeWriter *writer, PyObject *obj)
+{
+    /* Write the decimal representation of an int, like int.__repr__() */
+    char buf[24], *p = buf + sizeof(buf);
+    unsigned long long u;
+    int overflow;
+    long long x = PyLong_AsLongLongAndOverflow(obj, &overflow);
+
+    if (overflow)
+        return _PyLong_FormatWriter(writer, obj, 10, 0);
+    if (x == -1 && PyErr_Occurred())
+        return -1;
+    u = x < 0 ? 0ULL - (unsigned long long)x : (unsigned long long)x;
+    do {
+        *--p = '0' + (char)(u % 10);
+        u /= 10;
+    } while (u);
+    if (x < 0)
+        *--p = '-';
+    return _PyUnicodeWriter_WriteASCIIString(writer, p, buf + sizeof(buf) - p);
+}
+
+static int
+encoder_write_float(PyEncoderObject *s, _PyUnicodeWriter *writer,
+                    PyObject *obj)
+{
+    /* Write the JSON representation of a PyFloat, without creating the
+       string of float.__repr__() */
+    double x = PyFloat_AS_DOUBLE(obj);
+    char *buf;
+    int rv;
+
+    if (!Py_IS_FINITE(x))
+        return _steal_write(writer, encoder_encode_float(s, obj));
+    buf = PyOS_double_to_string(x, 'r', 0, Py_DTSF_ADD_DOT_0, NULL);
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    rv = _PyUnicodeWriter_WriteASCIIString(writer, buf, strlen(buf));
+    PyMem_Free(buf);
+    return rv;
+}
+
+static int
+encoder_listencode_obj(PyEncoderObject *s, EncoderWriter *w,
                        PyObject *obj, Py_ssize_t indent_level)
 {
     /* Encode Python object obj to a JSON term */
     PyObject *newobj;
     int rv;
 
-    if (obj == Py_None || obj == Py_True || obj == Py_False) {
-        PyObject *cstr = _encoded_const(obj);
-        if (cstr == NULL)
-            return -1;
-        return _steal_accumulate(acc, cstr);
+    if (obj == Py_None) {
+        return _PyUnicodeWriter_WriteASCIIString(&w->writer, "null", 4);
     }
-    else if (PyUnicode_Check(obj))
-    {
-        PyObject *encoded = encoder_encode_string(s, obj);
-        if (encoded == NULL)
-            return -1;
-        return _steal_accumulate(acc, encoded);
+    else if (obj == Py_True) {
+        return _PyUnicodeWriter_WriteASCIIString(&w->writer, "true", 4);
+    }
+    else if (obj == Py_False) {
+        return _PyUnicodeWriter_WriteASCIIString(&w->writer, "false", 5);
+    }
+    else if (PyUnicode_Check(obj)) {
+        return encoder_write_string(s, &w->writer, obj);
     }
     else if (PyLong_Check(obj)) {
-        PyObject *encoded = PyLong_Type.tp_repr(obj);
-        if (encoded == NULL)
-            return -1;
-        return _steal_accumulate(acc, encoded);
+        return encoder_write_long(&w->writer, obj);
     }
     else if (PyFloat_Check(obj)) {
-        PyObject *encoded = encoder_encode_float(s, obj);
-        if (encoded == NULL)
-            return -1;
-        return _steal_accumulate(acc, encoded);
+        return encoder_write_float(s, &w->writer, obj);
     }
     else if (PyList_Check(obj) || PyTuple_Check(obj)) {
         if (Py_EnterRecursiveCall(" while encoding a JSON object"))
             return -1;
-        rv = encoder_listencode_list(s, acc, obj, indent_level);
+        rv = encoder_listencode_list(s, w, obj, indent_level);
         Py_LeaveRecursiveCall();
         return rv;
     }
     else if (PyDict_Check(obj)) {
         if (Py_EnterRecursiveCall(" while encoding a JSON object"))
             return -1;
-        rv = encoder_listencode_dict(s, acc, obj, indent_level);
+        rv = encoder_listencode_dict(s, w, obj, indent_level);
         Py_LeaveRecursiveCall();
         return rv;
     }
@@ -1537,7 +2866,7 @@ encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
             Py_XDECREF(ident);
             return -1;
         }
-        rv = encoder_listencode_obj(s, acc, newobj, indent_level);
+        rv = encoder_listencode_obj(s, w, newobj, indent_level);
         Py_LeaveRecursiveCall();
 
         Py_DECREF(newobj);
@@ -1557,13 +2886,10 @@ encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
 }
 
 static int
-encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
+encoder_listencode_dict(PyEncoderObject *s, EncoderWriter *w,
                         PyObject *dct, Py_ssize_t indent_level)
 {
     /* Encode Python dict dct a JSON term */
-    static PyObject *open_dict = NULL;
-    static PyObject *close_dict = NULL;
-    static PyObject *empty_dict = NULL;
     PyObject *kstr = NULL;
     PyObject *ident = NULL;
     PyObject *it = NULL;
@@ -1571,15 +2897,8 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
     PyObject *item = NULL;
     Py_ssize_t idx;
 
-    if (open_dict == NULL || close_dict == NULL || empty_dict == NULL) {
-        open_dict = PyUnicode_InternFromString("{");
-        close_dict = PyUnicode_InternFromString("}");
-        empty_dict = PyUnicode_InternFromString("{}");
-        if (open_dict == NULL || close_dict == NULL || empty_dict == NULL)
-            return -1;
-    }
     if (PyDict_GET_SIZE(dct) == 0)  /* Fast path */
-        return _PyAccu_Accumulate(acc, empty_dict);
+        return _PyUnicodeWriter_WriteASCIIString(&w->writer, "{}", 2);
 
     if (s->markers != Py_None) {
         int has_key;
@@ -1597,7 +2916,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         }
     }
 
-    if (_PyAccu_Accumulate(acc, open_dict))
+    if (_PyUnicodeWriter_WriteChar(&w->writer, '{'))
         goto bail;
 
     if (s->indent != Py_None) {
@@ -1623,7 +2942,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         goto bail;
     idx = 0;
     while ((item = PyIter_Next(it)) != NULL) {
-        PyObject *encoded, *key, *value;
+        PyObject *key, *value;
         if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
             PyErr_SetString(PyExc_ValueError, "items must return 2-tuples");
             goto bail;
@@ -1663,27 +2982,23 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         }
 
         if (idx) {
-            if (_PyAccu_Accumulate(acc, s->item_separator))
+            if (_PyUnicodeWriter_WriteStr(&w->writer, s->item_separator))
                 goto bail;
         }
 
-        encoded = encoder_encode_string(s, kstr);
-        Py_CLEAR(kstr);
-        if (encoded == NULL)
-            goto bail;
-        if (_PyAccu_Accumulate(acc, encoded)) {
-            Py_DECREF(encoded);
+        if (encoder_write_string(s, &w->writer, kstr))
             goto bail;
-        }
-        Py_DECREF(encoded);
-        if (_PyAccu_Accumulate(acc, s->key_separator))
+        Py_CLEAR(kstr);
+        if (_PyUnicodeWriter_WriteStr(&w->writer, s->key_separator))
             goto bail;
 
         value = PyTuple_GET_ITEM(item, 1);
-        if (encoder_listencode_obj(s, acc, value, indent_level))
+        if (encoder_listencode_obj(s, w, value, indent_level))
             goto bail;
         idx += 1;
-        Py_DECREF(item);
+        Py_CLEAR(item);
+        if (encoder_flush(w))
+            goto bail;
     }
     if (PyErr_Occurred())
         goto bail;
@@ -1700,7 +3015,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
 
         yield '\n' + (' ' * (_indent * _current_indent_level))
     }*/
-    if (_PyAccu_Accumulate(acc, close_dict))
+    if (_PyUnicodeWriter_WriteChar(&w->writer, '}'))
         goto bail;
     return 0;
 
@@ -1714,31 +3029,20 @@ bail:
 
 
 static int
-encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
+encoder_listencode_list(PyEncoderObject *s, EncoderWriter *w,
                         PyObject *seq, Py_ssize_t indent_level)
 {
     /* Encode Python list seq to a JSON term */
-    static PyObject *open_array = NULL;
-    static PyObject *close_array = NULL;
-    static PyObject *empty_array = NULL;
     PyObject *ident = NULL;
     PyObject *s_fast = NULL;
     Py_ssize_t i;
 
-    if (open_array == NULL || close_array == NULL || empty_array == NULL) {
-        open_array = PyUnicode_InternFromString("[");
-        close_array = PyUnicode_InternFromString("]");
-        empty_array = PyUnicode_InternFromString("[]");
-        if (open_array == NULL || close_array == NULL || empty_array == NULL)
-            return -1;
-    }
-    ident = NULL;
     s_fast = PySequence_Fast(seq, "_iterencode_list needs a sequence");
     if (s_fast == NULL)
         return -1;
     if (PySequence_Fast_GET_SIZE(s_fast) == 0) {
         Py_DECREF(s_fast);
-        return _PyAccu_Accumulate(acc, empty_array);
+        return _PyUnicodeWriter_WriteASCIIString(&w->writer, "[]", 2);
     }
 
     if (s->markers != Py_None) {
@@ -1757,7 +3061,7 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
         }
     }
 
-    if (_PyAccu_Accumulate(acc, open_array))
+    if (_PyUnicodeWriter_WriteChar(&w->writer, '['))
         goto bail;
     if (s->indent != Py_None) {
         /* TODO: DOES NOT RUN */
@@ -1771,10 +3075,12 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
     for (i = 0; i < PySequence_Fast_GET_SIZE(s_fast); i++) {
         PyObject *obj = PySequence_Fast_GET_ITEM(s_fast, i);
         if (i) {
-            if (_PyAccu_Accumulate(acc, s->item_separator))
+            if (_PyUnicodeWriter_WriteStr(&w->writer, s->item_separator))
                 goto bail;
         }
-        if (encoder_listencode_obj(s, acc, obj, indent_level))
+        if (encoder_listencode_obj(s, w, obj, indent_level))
+            goto bail;
+        if (encoder_flush(w))
             goto bail;
     }
     if (ident != NULL) {
@@ -1789,7 +3095,7 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
 
         yield '\n' + (' ' * (_indent * _current_indent_level))
     }*/
-    if (_PyAccu_Accumulate(acc, close_array))
+    if (_PyUnicodeWriter_WriteChar(&w->writer, ']'))
         goto bail;
     Py_DECREF(s_fast);
     return 0;
@@ -1840,7 +3146,11 @@ encoder_clear(PyObject *self)
     return 0;
 }
 
-PyDoc_STRVAR(encoder_doc, "_iterencode(obj, _current_indent_level) -> iterable");
+PyDoc_STRVAR(encoder_doc,
+"_iterencode(obj, _current_indent_level, write=None) -> iterable\n"
+"\n"
+"If write is given, the JSON representation of obj is passed to it in\n"
+"chunks, and None is returned.");
 
 static
 PyTypeObject PyEncoderType = {
@@ -1924,6 +3234,8 @@ PyInit__json(void)
         return NULL;
     if (PyType_Ready(&PyScannerType) < 0)
         goto fail;
+    if (PyType_Ready(&PyStreamScannerType) < 0)
+        goto fail;
     if (PyType_Ready(&PyEncoderType) < 0)
         goto fail;
     Py_INCREF((PyObject*)&PyScannerType);
@@ -1931,6 +3243,12 @@ PyInit__json(void)
         Py_DECREF((PyObject*)&PyScannerType);
         goto fail;
     }
+    Py_INCREF((PyObject*)&PyStreamScannerType);
+    if (PyModule_AddObject(m, "make_stream_scanner",
+                           (PyObject*)&PyStreamScannerType) < 0) {
+        Py_DECREF((PyObject*)&PyStreamScannerType);
+        goto fail;
+    }
     Py_INCREF((PyObject*)&PyEncoderType);
     if (PyModule_AddObject(m, "make_encoder", (PyObject*)&PyEncoderType) < 0) {
         Py_DECREF((PyObject*)&PyEncoderType);
@@ -131,7 +131,12 @@ enum {
 
     FRAME_SIZE_MIN = 4,
     FRAME_SIZE_TARGET = 64 * 1024,
-    FRAME_HEADER_SIZE = 9
+    FRAME_HEADER_SIZE = 9,
+
+    /* Minimum size of the BINBYTES8 and BYTEARRAY8 payloads returned as
+       views of the input when unpickling with zerocopy.  Smaller payloads
+       are often arguments of __reduce__() which expect real bytes. */
+    ZEROCOPY_MIN_SIZE = 64 * 1024
 };
 
 /*************************************************************************/
@@ -677,6 +682,9 @@ typedef struct UnpicklerObject {
     PyObject *readline;         /* readline() method of the input stream. */
     PyObject *peek;             /* peek() method of the input stream, or NULL */
     PyObject *buffers;          /* iterable of out-of-band buffers, or NULL */
+    PyObject *input_view;       /* memoryview of the input data when
+                                   unpickling with zerocopy, or NULL */
+    PyObject *input_rview;      /* read-only version of input_view */
 
     char *encoding;             /* Name of the encoding to be used for
                                    decoding strings pickled using Python
@@ -1224,6 +1232,43 @@ bad_readline(void)
     return -1;
 }
 
+/* Make the bytes and bytearray payloads views of `input` instead of copies
+   of it.  This must follow _Unpickler_SetStringInput().  Returns -1 (with an
+   exception set) on failure, 0 on success. */
+static int
+_Unpickler_SetZeroCopy(UnpicklerObject *self, PyObject *input)
+{
+    _Py_IDENTIFIER(cast);
+    _Py_IDENTIFIER(toreadonly);
+    PyObject *view;
+    Py_buffer *info;
+
+    view = PyMemoryView_FromObject(input);
+    if (view == NULL)
+        return -1;
+    /* Slices of the view are taken at byte offsets */
+    info = PyMemoryView_GET_BUFFER(view);
+    if (info->ndim != 1 || info->format == NULL ||
+        strcmp(info->format, "B") != 0) {
+        Py_SETREF(view, _PyObject_CallMethodId(view, &PyId_cast, "s", "B"));
+        if (view == NULL)
+            return -1;
+    }
+    Py_XSETREF(self->input_view, view);
+
+    if (PyMemoryView_GET_BUFFER(view)->readonly) {
+        Py_INCREF(view);
+        Py_XSETREF(self->input_rview, view);
+    }
+    else {
+        view = _PyObject_CallMethodIdNoArgs(view, &PyId_toreadonly);
+        if (view == NULL)
+            return -1;
+        Py_XSETREF(self->input_rview, view);
+    }
+    return 0;
+}
+
 /* Skip any consumed data that was only prefetched using peek() */
 static int
 _Unpickler_SkipConsumed(UnpicklerObject *self)
@@ -1423,6 +1468,24 @@ _Unpickler_ReadInto(UnpicklerObject *self, char *buf, Py_ssize_t n)
         (n))                                                 \
      : _Unpickler_ReadImpl(self, (s), (n)))
 
+/* Return a slice of `view` (input_view or input_rview) holding the next n
+   bytes of the input, or NULL on failure. */
+static PyObject *
+_Unpickler_ReadView(UnpicklerObject *self, PyObject *view, Py_ssize_t n)
+{
+    PyObject *result;
+    Py_ssize_t start = self->next_read_idx;
+
+    if (n > self->input_len - start) {
+        bad_readline();
+        return NULL;
+    }
+    result = PySequence_GetSlice(view, start, start + n);
+    if (result != NULL)
+        self->next_read_idx += n;
+    return result;
+}
+
 static Py_ssize_t
 _Unpickler_CopyLine(UnpicklerObject *self, char *line, Py_ssize_t len,
                     char **result)
@@ -1574,6 +1637,8 @@ _Unpickler_New(void)
     self->readline = NULL;
     self->peek = NULL;
     self->buffers = NULL;
+    self->input_view = NULL;
+    self->input_rview = NULL;
     self->encoding = NULL;
     self->errors = NULL;
     self->marks = NULL;
@@ -2102,6 +2167,7 @@ save_long(PicklerObject *self, PyObject *obj)
         size_t nbits;
         size_t nbytes;
         unsigned char *pdata;
+        unsigned char small[32];
         char header[5];
         int i;
         int sign = _PyLong_Sign(obj);
@@ -2136,10 +2202,16 @@ save_long(PicklerObject *self, PyObject *obj)
                             "int too large to pickle");
             goto error;
         }
-        repr = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)nbytes);
-        if (repr == NULL)
-            goto error;
-        pdata = (unsigned char *)PyBytes_AS_STRING(repr);
+        if (nbytes <= sizeof(small)) {
+            /* Spare the allocation for ints of up to 255 bits */
+            pdata = small;
+        }
+        else {
+            repr = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)nbytes);
+            if (repr == NULL)
+                goto error;
+            pdata = (unsigned char *)PyBytes_AS_STRING(repr);
+        }
         i = _PyLong_AsByteArray((PyLongObject *)obj,
                                 pdata, nbytes,
                                 1 /* little endian */ , 1 /* signed */ );
@@ -2949,6 +3021,75 @@ batch_list(PicklerObject *self, PyObject *iter)
     return -1;
 }
 
+/* Save an item of a list or dict pickled by batch_list_exact() or
+ * batch_dict_exact().  The plain ints, floats and strs most containers are
+ * made of skip the generic dispatch of save().  A str only referenced by
+ * the container is neither looked up in the memo nor memoized, since no
+ * other object can refer to it.
+ */
+static int
+save_batch_item(PicklerObject *self, PyObject *obj)
+{
+    PyTypeObject *type = Py_TYPE(obj);
+    char pdata[9];
+    Py_ssize_t len;
+
+    assert(self->bin);
+    if (self->pers_func != NULL)
+        return save(self, obj, 0);
+
+    if (type == &PyLong_Type) {
+        Py_ssize_t size = Py_SIZE(obj);
+        long val;
+
+        if (size < -1 || size > 1)
+            return save(self, obj, 0);
+        /* A single digit fits in BININT */
+        val = size ? size * (long)((PyLongObject *)obj)->ob_digit[0] : 0;
+        pdata[1] = (unsigned char)(val & 0xff);
+        pdata[2] = (unsigned char)((val >> 8) & 0xff);
+        pdata[3] = (unsigned char)((val >> 16) & 0xff);
+        pdata[4] = (unsigned char)((val >> 24) & 0xff);
+        if ((pdata[4] != 0) || (pdata[3] != 0)) {
+            pdata[0] = BININT;
+            len = 5;
+        }
+        else if (pdata[2] != 0) {
+            pdata[0] = BININT2;
+            len = 3;
+        }
+        else {
+            pdata[0] = BININT1;
+            len = 2;
+        }
+    }
+    else if (type == &PyFloat_Type) {
+        pdata[0] = BINFLOAT;
+        if (_PyFloat_Pack8(PyFloat_AS_DOUBLE(obj),
+                           (unsigned char *)&pdata[1], 0) < 0)
+            return -1;
+        len = 9;
+    }
+    else if (type == &PyUnicode_Type) {
+        if (_Pickler_OpcodeBoundary(self) < 0)
+            return -1;
+        if (Py_REFCNT(obj) == 1)
+            return write_unicode_binary(self, obj);
+        if (PyMemoTable_Get(self->memo, obj))
+            return memo_get(self, obj);
+        return save_unicode(self, obj);
+    }
+    else {
+        return save(self, obj, 0);
+    }
+
+    if (_Pickler_OpcodeBoundary(self) < 0)
+        return -1;
+    if (_Pickler_Write(self, pdata, len) < 0)
+        return -1;
+    return 0;
+}
+
 /* This is a variant of batch_list() above, specialized for lists (with no
  * support for list subclasses). Like batch_list(), we batch up chunks of
  *     MARK item item ... item APPENDS
@@ -2976,7 +3117,7 @@ batch_list_exact(PicklerObject *self, PyObject *obj)
 
     if (PyList_GET_SIZE(obj) == 1) {
         item = PyList_GET_ITEM(obj, 0);
-        if (save(self, item, 0) < 0)
+        if (save_batch_item(self, item) < 0)
             return -1;
         if (_Pickler_Write(self, &append_op, 1) < 0)
             return -1;
@@ -2991,7 +3132,7 @@ batch_list_exact(PicklerObject *self, PyObject *obj)
             return -1;
         while (total < PyList_GET_SIZE(obj)) {
             item = PyList_GET_ITEM(obj, total);
-            if (save(self, item, 0) < 0)
+            if (save_batch_item(self, item) < 0)
                 return -1;
             total++;
             if (++this_batch == BATCHSIZE)
@@ -3229,9 +3370,9 @@ batch_dict_exact(PicklerObject *self, PyObject *obj)
     /* Special-case len(d) == 1 to save space. */
     if (dict_size == 1) {
         PyDict_Next(obj, &ppos, &key, &value);
-        if (save(self, key, 0) < 0)
+        if (save_batch_item(self, key) < 0)
             return -1;
-        if (save(self, value, 0) < 0)
+        if (save_batch_item(self, value) < 0)
             return -1;
         if (_Pickler_Write(self, &setitem_op, 1) < 0)
             return -1;
@@ -3244,9 +3385,9 @@ batch_dict_exact(PicklerObject *self, PyObject *obj)
         if (_Pickler_Write(self, &mark_op, 1) < 0)
             return -1;
         while (PyDict_Next(obj, &ppos, &key, &value)) {
-            if (save(self, key, 0) < 0)
+            if (save_batch_item(self, key) < 0)
                 return -1;
-            if (save(self, value, 0) < 0)
+            if (save_batch_item(self, value) < 0)
                 return -1;
             if (++i == BATCHSIZE)
                 break;
@@ -5484,6 +5625,15 @@ load_counted_binbytes(UnpicklerObject *self, int nbytes)
         return -1;
     }
 
+    if (self->input_rview != NULL && nbytes == 8 &&
+        size >= ZEROCOPY_MIN_SIZE) {
+        bytes = _Unpickler_ReadView(self, self->input_rview, size);
+        if (bytes == NULL)
+            return -1;
+        PDATA_PUSH(self->stack, bytes, -1);
+        return 0;
+    }
+
     bytes = PyBytes_FromStringAndSize(NULL, size);
     if (bytes == NULL)
         return -1;
@@ -5515,6 +5665,15 @@ load_counted_bytearray(UnpicklerObject *self)
         return -1;
     }
 
+    if (self->input_view != NULL && size >= ZEROCOPY_MIN_SIZE) {
+        bytearray = _Unpickler_ReadView(self, self->input_view, size);
+        if (bytearray == NULL) {
+            return -1;
+        }
+        PDATA_PUSH(self->stack, bytearray, -1);
+        return 0;
+    }
+
     bytearray = PyByteArray_FromStringAndSize(NULL, size);
     if (bytearray == NULL) {
         return -1;
@@ -7135,6 +7294,8 @@ Unpickler_dealloc(UnpicklerObject *self)
     Py_XDECREF(self->stack);
     Py_XDECREF(self->pers_func);
     Py_XDECREF(self->buffers);
+    Py_XDECREF(self->input_view);
+    Py_XDECREF(self->input_rview);
     if (self->buffer.buf != NULL) {
         PyBuffer_Release(&self->buffer);
         self->buffer.buf = NULL;
@@ -7159,6 +7320,8 @@ Unpickler_traverse(UnpicklerObject *self, visitproc visit, void *arg)
     Py_VISIT(self->stack);
     Py_VISIT(self->pers_func);
     Py_VISIT(self->buffers);
+    Py_VISIT(self->input_view);
+    Py_VISIT(self->input_rview);
     return 0;
 }
 
@@ -7172,6 +7335,8 @@ Unpickler_clear(UnpicklerObject *self)
     Py_CLEAR(self->stack);
     Py_CLEAR(self->pers_func);
     Py_CLEAR(self->buffers);
+    Py_CLEAR(self->input_view);
+    Py_CLEAR(self->input_rview);
     if (self->buffer.buf != NULL) {
         PyBuffer_Release(&self->buffer);
         self->buffer.buf = NULL;
@@ -7825,6 +7990,7 @@ _pickle.loads
   encoding: str = 'ASCII'
   errors: str = 'strict'
   buffers: object = NULL
+  zerocopy: bool = False
 
 Read and return an object from the given pickle data.
 
@@ -7840,13 +8006,18 @@ map the old Python 2 names to the new names used in Python 3.  The
 instances pickled by Python 2; these default to 'ASCII' and 'strict',
 respectively.  The *encoding* can be 'bytes' to read these 8-bit
 string instances as bytes objects.
+
+If *zerocopy* is true, large bytes and bytearray objects serialized
+in-band with protocol 4 or higher (the payloads of the BINBYTES8 and
+BYTEARRAY8 opcodes) are returned as memoryviews of *data* rather than as
+copies of it.  Views of bytes objects are read-only.
 [clinic start generated code]*/
 
 static PyObject *
 _pickle_loads_impl(PyObject *module, PyObject *data, int fix_imports,
                    const char *encoding, const char *errors,
-                   PyObject *buffers)
-/*[clinic end generated code: output=82ac1e6b588e6d02 input=c6004393f8276867]*/
+                   PyObject *buffers, int zerocopy)
+/*[clinic end generated code: output=0dcc9dc13a6c20c4 input=c951b71a79a3129f]*/
 {
     PyObject *result;
     UnpicklerObject *unpickler = _Unpickler_New();
@@ -7857,6 +8028,9 @@ _pickle_loads_impl(PyObject *module, PyObject *data, int fix_imports,
     if (_Unpickler_SetStringInput(unpickler, data) < 0)
         goto error;
 
+    if (zerocopy && _Unpickler_SetZeroCopy(unpickler, data) < 0)
+        goto error;
+
     if (_Unpickler_SetInputEncoding(unpickler, encoding, errors) < 0)
         goto error;
 
@@ -196,7 +196,7 @@ static void
 data_stack_dealloc(SRE_STATE* state)
 {
     if (state->data_stack) {
-        PyMem_FREE(state->data_stack);
+        PyMem_RawFree(state->data_stack);
         state->data_stack = NULL;
     }
     state->data_stack_size = state->data_stack_base = 0;
@@ -212,7 +212,7 @@ data_stack_grow(SRE_STATE* state, Py_ssize_t size)
         void* stack;
         cursize = minsize+minsize/4+1024;
         TRACE(("allocate/grow stack %" PY_FORMAT_SIZE_T "d\n", cursize));
-        stack = PyMem_REALLOC(state->data_stack, cursize);
+        stack = PyMem_RawRealloc(state->data_stack, cursize);
         if (!stack) {
             data_stack_dealloc(state);
             return SRE_ERROR_MEMORY;
@@ -223,6 +223,24 @@ data_stack_grow(SRE_STATE* state, Py_ssize_t size)
     return 0;
 }
 
+/* Run pending signal handlers.  When the GIL was released for the match,
+   it is only taken back if a signal has actually arrived and this thread
+   is the one that handles signals. */
+static int
+sre_check_signals(SRE_STATE* state)
+{
+    int res;
+
+    if (state->tstate == NULL)
+        return PyErr_CheckSignals();
+    if (!state->main_thread || !_PyErr_SignalsPending())
+        return 0;
+    PyEval_RestoreThread(state->tstate);
+    res = PyErr_CheckSignals();
+    state->tstate = PyEval_SaveThread();
+    return res;
+}
+
 /* generate 8-bit version */
 
 #define SRE_CHAR Py_UCS1
@@ -575,6 +593,53 @@ sre_search(SRE_STATE* state, SRE_CODE* pattern)
     return sre_ucs4_search(state, pattern);
 }
 
+/* Matching a string of at least this many characters is done with the
+   GIL released, if the string cannot change while it is being matched. */
+#define SRE_GIL_MINSIZE 4096
+
+LOCAL(int)
+state_can_release_gil(SRE_STATE* state)
+{
+    if ((char*) state->end - (char*) state->start <
+        SRE_GIL_MINSIZE * state->charsize)
+        return 0;
+    /* Only str and bytes objects are known to be immutable.  A read-only
+       buffer can still be a view of mutable memory (for example
+       memoryview(bytearray).toreadonly()) which another thread could
+       change while the GIL is released. */
+    return PyUnicode_Check(state->string) || PyBytes_Check(state->string);
+}
+
+LOCAL(void)
+state_release_gil(SRE_STATE* state)
+{
+    state->main_thread = _PyOS_IsMainThread();
+    state->tstate = PyEval_SaveThread();
+}
+
+LOCAL(void)
+state_acquire_gil(SRE_STATE* state)
+{
+    PyEval_RestoreThread(state->tstate);
+    state->tstate = NULL;
+}
+
+/* Same as sre_match() and sre_search(), but release the GIL if possible.
+   The match must not create any Python objects, and the matcher only
+   takes the GIL back to run signal handlers. */
+LOCAL(Py_ssize_t)
+sre_match_nogil(SRE_STATE* state, SRE_CODE* pattern, int search)
+{
+    Py_ssize_t status;
+
+    if (!state_can_release_gil(state))
+        return search ? sre_search(state, pattern) : sre_match(state, pattern);
+    state_release_gil(state);
+    status = search ? sre_search(state, pattern) : sre_match(state, pattern);
+    state_acquire_gil(state);
+    return status;
+}
+
 /*[clinic input]
 _sre.SRE_Pattern.match
 
@@ -601,7 +666,7 @@ _sre_SRE_Pattern_match_impl(PatternObject *self, PyObject *string,
 
     TRACE(("|%p|%p|MATCH\n", PatternObject_GetCode(self), state.ptr));
 
-    status = sre_match(&state, PatternObject_GetCode(self));
+    status = sre_match_nogil(&state, PatternObject_GetCode(self), 0);
 
     TRACE(("|%p|%p|END\n", PatternObject_GetCode(self), state.ptr));
     if (PyErr_Occurred()) {
@@ -641,7 +706,7 @@ _sre_SRE_Pattern_fullmatch_impl(PatternObject *self, PyObject *string,
     TRACE(("|%p|%p|FULLMATCH\n", PatternObject_GetCode(self), state.ptr));
 
     state.match_all = 1;
-    status = sre_match(&state, PatternObject_GetCode(self));
+    status = sre_match_nogil(&state, PatternObject_GetCode(self), 0);
 
     TRACE(("|%p|%p|END\n", PatternObject_GetCode(self), state.ptr));
     if (PyErr_Occurred()) {
@@ -680,7 +745,7 @@ _sre_SRE_Pattern_search_impl(PatternObject *self, PyObject *string,
 
     TRACE(("|%p|%p|SEARCH\n", PatternObject_GetCode(self), state.ptr));
 
-    status = sre_search(&state, PatternObject_GetCode(self));
+    status = sre_match_nogil(&state, PatternObject_GetCode(self), 1);
 
     TRACE(("|%p|%p|END\n", PatternObject_GetCode(self), state.ptr));
 
@@ -721,6 +786,123 @@ call(const char* module, const char* function, PyObject* args)
     return result;
 }
 
+/* Find all matches with the GIL released.  Store the spans findall()
+   returns (the whole match if the pattern has no groups, every group
+   otherwise) in *pspans, which is allocated with PyMem_RawMalloc(). */
+static Py_ssize_t
+state_findall_spans(SRE_STATE* state, SRE_CODE* pattern, Py_ssize_t groups,
+                    Py_ssize_t** pspans, Py_ssize_t* pcount)
+{
+    Py_ssize_t width = 2 * (groups ? groups : 1);
+    Py_ssize_t *spans = NULL, *span;
+    Py_ssize_t count = 0, allocated = 0;
+    Py_ssize_t i, status = 0;
+
+    state_release_gil(state);
+    while (state->start <= state->end) {
+
+        state_reset(state);
+
+        state->ptr = state->start;
+
+        status = sre_search(state, pattern);
+        if (status <= 0)
+            break;
+
+        if (count == allocated) {
+            Py_ssize_t *newspans = NULL;
+            allocated += (allocated >> 1) + 16;
+            if ((size_t)allocated <= PY_SSIZE_T_MAX / sizeof(Py_ssize_t) / width)
+                newspans = PyMem_RawRealloc(spans,
+                                            allocated * width * sizeof(Py_ssize_t));
+            if (!newspans) {
+                status = SRE_ERROR_MEMORY;
+                break;
+            }
+            spans = newspans;
+        }
+        span = spans + count * width;
+        count++;
+
+        if (groups == 0) {
+            span[0] = STATE_OFFSET(state, state->start);
+            span[1] = STATE_OFFSET(state, state->ptr);
+        }
+        else {
+            /* same as state_getslice() with empty set */
+            for (i = 0; i < 2 * groups; i += 2) {
+                if (i >= state->lastmark || !state->mark[i] ||
+                    !state->mark[i+1])
+                    span[i] = span[i+1] = 0;
+                else {
+                    span[i] = STATE_OFFSET(state, state->mark[i]);
+                    span[i+1] = STATE_OFFSET(state, state->mark[i+1]);
+                }
+            }
+        }
+
+        state->must_advance = (state->ptr == state->start);
+        state->start = state->ptr;
+    }
+    state_acquire_gil(state);
+
+    *pspans = spans;
+    *pcount = count;
+    return status < 0 ? status : 0;
+}
+
+static PyObject *
+pattern_findall_nogil(PatternObject *self, SRE_STATE *state, PyObject *string)
+{
+    PyObject *list = NULL, *item;
+    Py_ssize_t *spans, *span;
+    Py_ssize_t count, status;
+    Py_ssize_t i, j;
+
+    status = state_findall_spans(state, PatternObject_GetCode(self),
+                                 self->groups, &spans, &count);
+    if (status < 0) {
+        pattern_error(status);
+        goto done;
+    }
+
+    list = PyList_New(count);
+    if (!list)
+        goto done;
+
+    for (i = 0; i < count; i++) {
+        span = spans + i * 2 * (self->groups ? self->groups : 1);
+        if (self->groups <= 1) {
+            item = getslice(state->isbytes, state->beginning,
+                            string, span[0], span[1]);
+            if (!item)
+                goto error;
+        }
+        else {
+            item = PyTuple_New(self->groups);
+            if (!item)
+                goto error;
+            for (j = 0; j < self->groups; j++) {
+                PyObject* o = getslice(state->isbytes, state->beginning,
+                                       string, span[2*j], span[2*j+1]);
+                if (!o) {
+                    Py_DECREF(item);
+                    goto error;
+                }
+                PyTuple_SET_ITEM(item, j, o);
+            }
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    goto done;
+
+error:
+    Py_CLEAR(list);
+done:
+    PyMem_RawFree(spans);
+    return list;
+}
+
 /*[clinic input]
 _sre.SRE_Pattern.findall
 
@@ -744,6 +926,12 @@ _sre_SRE_Pattern_findall_impl(PatternObject *self, PyObject *string,
     if (!state_init(&state, self, string, pos, endpos))
         return NULL;
 
+    if (state_can_release_gil(&state)) {
+        list = pattern_findall_nogil(self, &state, string);
+        state_fini(&state);
+        return list;
+    }
+
     list = PyList_New(0);
     if (!list) {
         state_fini(&state);
@@ -1646,8 +1834,8 @@ _validate_inner(SRE_CODE *code, SRE_CODE *end, Py_ssize_t groups)
             {
                 /* A minimal info field is
                    <INFO> <1=skip> <2=flags> <3=min> <4=max>;
-                   If SRE_INFO_PREFIX or SRE_INFO_CHARSET is in the flags,
-                   more follows. */
+                   If SRE_INFO_REQUIRED, SRE_INFO_PREFIX or SRE_INFO_CHARSET
+                   is in the flags, more follows. */
                 SRE_CODE flags, i;
                 SRE_CODE *newcode;
                 GET_SKIP;
@@ -1658,7 +1846,8 @@ _validate_inner(SRE_CODE *code, SRE_CODE *end, Py_ssize_t groups)
                 /* Check that only valid flags are present */
                 if ((flags & ~(SRE_INFO_PREFIX |
                                SRE_INFO_LITERAL |
-                               SRE_INFO_CHARSET)) != 0)
+                               SRE_INFO_CHARSET |
+                               SRE_INFO_REQUIRED)) != 0)
                     FAIL;
                 /* PREFIX and CHARSET are mutually exclusive */
                 if ((flags & SRE_INFO_PREFIX) &&
@@ -1668,6 +1857,19 @@ _validate_inner(SRE_CODE *code, SRE_CODE *end, Py_ssize_t groups)
                 if ((flags & SRE_INFO_LITERAL) &&
                     !(flags & SRE_INFO_PREFIX))
                     FAIL;
+                /* Validate the required literal */
+                if (flags & SRE_INFO_REQUIRED) {
+                    SRE_CODE required_len, required_lo;
+                    GET_ARG; required_len = arg;
+                    GET_ARG; required_lo = arg;
+                    GET_ARG;
+                    if (required_len == 0 || required_lo > arg)
+                        FAIL;
+                    /* Here comes the literal string */
+                    if (required_len > (uintptr_t)(newcode - code))
+                        FAIL;
+                    code += required_len;
+                }
                 /* Validate the prefix */
                 if (flags & SRE_INFO_PREFIX) {
                     SRE_CODE prefix_len;
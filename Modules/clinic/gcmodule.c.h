@@ -212,6 +212,92 @@ gc_get_threshold(PyObject *module, PyObject *Py_UNUSED(ignored))
     return gc_get_threshold_impl(module);
 }
 
+PyDoc_STRVAR(gc_set_incremental__doc__,
+"set_incremental($module, slice_size, full_passes=10, /)\n"
+"--\n"
+"\n"
+"Collect the oldest generation incrementally.\n"
+"\n"
+"Each automatic collection of the oldest generation examines only the next\n"
+"slice_size objects of it, with the objects they reference, instead of the\n"
+"whole generation.  Setting slice_size to zero disables incremental\n"
+"collections.  A full collection is done instead of every full_passes-th\n"
+"pass over the oldest generation, to find the cycles larger than a slice;\n"
+"zero disables these full collections.");
+
+#define GC_SET_INCREMENTAL_METHODDEF    \
+    {"set_incremental", (PyCFunction)(void(*)(void))gc_set_incremental, METH_FASTCALL, gc_set_incremental__doc__},
+
+static PyObject *
+gc_set_incremental_impl(PyObject *module, Py_ssize_t slice_size,
+                        int full_passes);
+
+static PyObject *
+gc_set_incremental(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t slice_size;
+    int full_passes = INCREMENTAL_FULL_PASSES;
+
+    if (!_PyArg_CheckPositional("set_incremental", nargs, 1, 2)) {
+        goto exit;
+    }
+    if (PyFloat_Check(args[0])) {
+        PyErr_SetString(PyExc_TypeError,
+                        "integer argument expected, got float" );
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = PyNumber_Index(args[0]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        slice_size = ival;
+    }
+    if (nargs < 2) {
+        goto skip_optional;
+    }
+    if (PyFloat_Check(args[1])) {
+        PyErr_SetString(PyExc_TypeError,
+                        "integer argument expected, got float" );
+        goto exit;
+    }
+    full_passes = _PyLong_AsInt(args[1]);
+    if (full_passes == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    return_value = gc_set_incremental_impl(module, slice_size, full_passes);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_incremental__doc__,
+"get_incremental($module, /)\n"
+"--\n"
+"\n"
+"Return the incremental collection settings.\n"
+"\n"
+"Return a tuple (slice_size, full_passes), see gc.set_incremental().");
+
+#define GC_GET_INCREMENTAL_METHODDEF    \
+    {"get_incremental", (PyCFunction)gc_get_incremental, METH_NOARGS, gc_get_incremental__doc__},
+
+static PyObject *
+gc_get_incremental_impl(PyObject *module);
+
+static PyObject *
+gc_get_incremental(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return gc_get_incremental_impl(module);
+}
+
 PyDoc_STRVAR(gc_get_count__doc__,
 "get_count($module, /)\n"
 "--\n"
@@ -373,4 +459,4 @@ gc_get_freeze_count(PyObject *module, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=e40d384b1f0d513c input=a9049054013a1b77]*/
+/*[clinic end generated code: output=9dbe27f27915fd19 input=a9049054013a1b77]*/
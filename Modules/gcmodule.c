@@ -125,6 +125,10 @@ static PyObject *gc_str = NULL;
 
 #define GEN_HEAD(state, n) (&(state)->generations[n].head)
 
+/* Default number of incremental passes over the oldest generation after
+   which a full collection is done, see gc.set_incremental(). */
+#define INCREMENTAL_FULL_PASSES 10
+
 void
 _PyGC_Initialize(struct _gc_runtime_state *state)
 {
@@ -146,6 +150,7 @@ _PyGC_Initialize(struct _gc_runtime_state *state)
            (uintptr_t)&state->permanent_generation.head}, 0, 0
     };
     state->permanent_generation = permanent_generation;
+    state->incremental_full_passes = INCREMENTAL_FULL_PASSES;
 }
 
 /*
@@ -342,12 +347,15 @@ validate_list(PyGC_Head *head, uintptr_t expected_mask)
 
 /* Set all gc_refs = ob_refcnt.  After this, gc_refs is > 0 and
  * PREV_MASK_COLLECTING bit is set for all objects in containers.
+ * Return the number of objects in containers.
  */
-static void
+static Py_ssize_t
 update_refs(PyGC_Head *containers)
 {
+    Py_ssize_t n = 0;
     PyGC_Head *gc = GC_NEXT(containers);
     for (; gc != containers; gc = GC_NEXT(gc)) {
+        n++;
         gc_reset_refs(gc, Py_REFCNT(FROM_GC(gc)));
         /* Python's cyclic gc should never see an incoming refcount
          * of 0:  if something decref'ed to 0, it should have been
@@ -369,6 +377,7 @@ update_refs(PyGC_Head *containers)
          */
         _PyObject_ASSERT(FROM_GC(gc), gc_get_refs(gc) != 0);
     }
+    return n;
 }
 
 /* A traversal callback for subtract_refs. */
@@ -955,6 +964,7 @@ clear_freelists(void)
     (void)PyTuple_ClearFreeList();
     (void)PyUnicode_ClearFreeList();
     (void)PyFloat_ClearFreeList();
+    (void)PyLong_ClearFreeList();
     (void)PyList_ClearFreeList();
     (void)PyDict_ClearFreeList();
     (void)PySet_ClearFreeList();
@@ -981,10 +991,101 @@ show_stats_each_generations(struct _gc_runtime_state *state)
         buf, gc_list_size(&state->permanent_generation.head));
 }
 
+/* Objects examined by an incremental collection, see build_increment(). */
+struct gc_increment {
+    PyGC_Head *head;
+    /* number of objects which can still be added by visit_increment() */
+    Py_ssize_t budget;
+};
+
+/* A traversal callback for build_increment. */
+static int
+visit_increment(PyObject *op, struct gc_increment *increment)
+{
+    if (increment->budget <= 0 || !PyObject_IS_GC(op)) {
+        return 0;
+    }
+
+    PyGC_Head *gc = AS_GC(op);
+    // Ignore untracked objects and objects already in the increment.
+    if (gc->_gc_next == 0 || gc_is_collecting(gc)) {
+        return 0;
+    }
+    gc->_gc_prev |= PREV_MASK_COLLECTING;
+    gc_list_move(gc, increment->head);
+    increment->budget--;
+    return 0;
+}
+
+/* Move the objects examined by the next incremental collection of the
+ * oldest generation into `head`: a slice taken from the head of the oldest
+ * generation, the objects transitively referenced by the slice (at most
+ * another slice of them) and all objects of the younger generations.
+ *
+ * Collecting any subset of the tracked objects is safe: the references
+ * from outside the subset keep their referents alive.  Adding what the
+ * slice references completes the cycles which go through it, so that they
+ * can be found as unreachable.  The survivors are appended to the tail of
+ * the oldest generation, so that successive increments walk through the
+ * whole generation: this is an incremental pass.
+ *
+ * The objects of the oldest generation moved into `head` have
+ * PREV_MASK_COLLECTING set, to tell them apart while they are added.
+ * The permanent generation must be empty: its objects would not be told
+ * apart from the oldest generation.
+ */
+static void
+build_increment(struct _gc_runtime_state *state, PyGC_Head *head)
+{
+    PyGC_Head *oldest = GEN_HEAD(state, NUM_GENERATIONS-1);
+    struct gc_increment increment = {head, state->incremental_slice};
+    PyGC_Head *gc;
+
+    assert(gc_list_is_empty(&state->permanent_generation.head));
+    if (state->incremental_remaining <= 0) {
+        /* Start a new pass.  It will examine the long lived objects,
+         * including the pending ones. */
+        state->incremental_remaining = (state->long_lived_total
+                                        + state->long_lived_pending);
+        state->incremental_survivors = 0;
+        state->long_lived_pending = 0;
+    }
+
+    for (Py_ssize_t i = 0; i < state->incremental_slice; i++) {
+        if (state->incremental_remaining <= 0 || gc_list_is_empty(oldest)) {
+            /* This is the last increment of the pass */
+            state->incremental_remaining = 0;
+            break;
+        }
+        gc = GC_NEXT(oldest);
+        gc->_gc_prev |= PREV_MASK_COLLECTING;
+        gc_list_move(gc, head);
+        state->incremental_remaining--;
+    }
+
+    /* Note that visit_increment() appends objects to head. */
+    for (gc = GC_NEXT(head);
+         gc != head && increment.budget > 0;
+         gc = GC_NEXT(gc))
+    {
+        traverseproc traverse = Py_TYPE(FROM_GC(gc))->tp_traverse;
+        (void) traverse(FROM_GC(gc),
+                        (visitproc)visit_increment,
+                        &increment);
+    }
+
+    for (int i = 0; i < NUM_GENERATIONS-1; i++) {
+        gc_list_merge(GEN_HEAD(state, i), head);
+    }
+}
+
 /* This is the main function.  Read this to understand how the
- * collection process works. */
+ * collection process works.
+ *
+ * If incremental is true, generation must be the oldest one and only an
+ * increment of it is collected, see build_increment(). */
 static Py_ssize_t
-collect(struct _gc_runtime_state *state, int generation,
+collect(struct _gc_runtime_state *state, int generation, int incremental,
         Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable, int nofail)
 {
     int i;
@@ -994,14 +1095,19 @@ collect(struct _gc_runtime_state *state, int generation,
     PyGC_Head *old; /* next older generation */
     PyGC_Head unreachable; /* non-problematic unreachable trash */
     PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
+    PyGC_Head increment;   /* objects examined by an incremental collection */
     PyGC_Head *gc;
-    _PyTime_t t1 = 0;   /* initialize to prevent a compiler warning */
+    Py_ssize_t examined;
+    _PyTime_t t1, t2, unreachable_time, finalize_time;
 
+    assert(!incremental || generation == NUM_GENERATIONS - 1);
     if (state->debug & DEBUG_STATS) {
-        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
+        PySys_WriteStderr("gc: collecting %sgeneration %d...\n",
+                          incremental ? "an increment of " : "",
+                          generation);
         show_stats_each_generations(state);
-        t1 = _PyTime_GetMonotonicClock();
     }
+    t1 = _PyTime_GetMonotonicClock();
 
     if (PyDTrace_GC_START_ENABLED())
         PyDTrace_GC_START(generation);
@@ -1012,26 +1118,35 @@ collect(struct _gc_runtime_state *state, int generation,
     for (i = 0; i <= generation; i++)
         state->generations[i].count = 0;
 
-    /* merge younger generations with one we are currently collecting */
-    for (i = 0; i < generation; i++) {
-        gc_list_merge(GEN_HEAD(state, i), GEN_HEAD(state, generation));
+    if (incremental) {
+        gc_list_init(&increment);
+        build_increment(state, &increment);
+        young = &increment;
+        old = GEN_HEAD(state, generation);
     }
+    else {
+        /* merge younger generations with one we are currently collecting */
+        for (i = 0; i < generation; i++) {
+            gc_list_merge(GEN_HEAD(state, i), GEN_HEAD(state, generation));
+        }
 
-    /* handy references */
-    young = GEN_HEAD(state, generation);
-    if (generation < NUM_GENERATIONS-1)
-        old = GEN_HEAD(state, generation+1);
-    else
-        old = young;
+        /* handy references */
+        young = GEN_HEAD(state, generation);
+        if (generation < NUM_GENERATIONS-1)
+            old = GEN_HEAD(state, generation+1);
+        else
+            old = young;
 
-    validate_list(young, 0);
+        validate_list(young, 0);
+    }
     validate_list(old, 0);
     /* Using ob_refcnt and gc_refs, calculate which objects in the
      * container set are reachable from outside the set (i.e., have a
      * refcount greater than 0 when all the references within the
      * set are taken into account).
      */
-    update_refs(young);  // gc_prev is used for gc_refs
+    t2 = _PyTime_GetMonotonicClock();
+    examined = update_refs(young);  // gc_prev is used for gc_refs
     subtract_refs(young);
 
     /* Leave everything reachable from outside young in young, and move
@@ -1043,10 +1158,23 @@ collect(struct _gc_runtime_state *state, int generation,
     gc_list_init(&unreachable);
     move_unreachable(young, &unreachable);  // gc_prev is pointer again
     validate_list(young, 0);
+    unreachable_time = _PyTime_GetMonotonicClock() - t2;
 
     untrack_tuples(young);
     /* Move reachable objects to next generation. */
-    if (young != old) {
+    if (incremental) {
+        /* Like full collections, increments examine each long lived object
+           once per pass: untracking dicts doesn't cause a quadratic
+           build-up either. */
+        untrack_dicts(young);
+        state->incremental_survivors += gc_list_size(young);
+        if (state->incremental_remaining == 0) {
+            state->long_lived_total = state->incremental_survivors;
+            state->incremental_passes++;
+        }
+        gc_list_merge(young, old);
+    }
+    else if (young != old) {
         if (generation == NUM_GENERATIONS - 2) {
             state->long_lived_pending += gc_list_size(young);
         }
@@ -1058,6 +1186,8 @@ collect(struct _gc_runtime_state *state, int generation,
         untrack_dicts(young);
         state->long_lived_pending = 0;
         state->long_lived_total = gc_list_size(young);
+        state->incremental_remaining = 0;
+        state->incremental_passes = 0;
     }
 
     /* All objects in unreachable are trash, but objects reachable from
@@ -1093,7 +1223,9 @@ collect(struct _gc_runtime_state *state, int generation,
     validate_list(&unreachable, PREV_MASK_COLLECTING);
 
     /* Call tp_finalize on objects which have one. */
+    t2 = _PyTime_GetMonotonicClock();
     finalize_garbage(&unreachable);
+    finalize_time = _PyTime_GetMonotonicClock() - t2;
 
     if (check_garbage(&unreachable)) { // clear PREV_MASK_COLLECTING here
         gc_list_merge(&unreachable, old);
@@ -1113,8 +1245,9 @@ collect(struct _gc_runtime_state *state, int generation,
         if (state->debug & DEBUG_UNCOLLECTABLE)
             debug_cycle("uncollectable", FROM_GC(gc));
     }
+    t2 = _PyTime_GetMonotonicClock();
     if (state->debug & DEBUG_STATS) {
-        double d = _PyTime_AsSecondsDouble(_PyTime_GetMonotonicClock() - t1);
+        double d = _PyTime_AsSecondsDouble(t2 - t1);
         PySys_FormatStderr(
             "gc: done, %zd unreachable, %zd uncollectable, %.4fs elapsed\n",
             n+m, n, d);
@@ -1128,8 +1261,9 @@ collect(struct _gc_runtime_state *state, int generation,
     validate_list(old, 0);
 
     /* Clear free list only during the collection of the highest
-     * generation */
-    if (generation == NUM_GENERATIONS-1) {
+     * generation, or at the end of an incremental pass over it */
+    if (generation == NUM_GENERATIONS-1
+        && !(incremental && state->incremental_remaining > 0)) {
         clear_freelists();
     }
 
@@ -1157,6 +1291,22 @@ collect(struct _gc_runtime_state *state, int generation,
     stats->collections++;
     stats->collected += m;
     stats->uncollectable += n;
+    stats->examined += examined;
+    stats->time += t2 - t1;
+    stats->unreachable_time += unreachable_time;
+    stats->finalize_time += finalize_time;
+    if (t2 - t1 > stats->max_time) {
+        stats->max_time = t2 - t1;
+    }
+    /* Bucket of the pause time in microseconds, see GC_PAUSE_BUCKETS */
+    uint64_t us = (uint64_t)_PyTime_AsMicroseconds(t2 - t1,
+                                                   _PyTime_ROUND_FLOOR);
+    i = 0;
+    while (us != 0 && i < GC_PAUSE_BUCKETS - 1) {
+        us >>= 1;
+        i++;
+    }
+    stats->pauses[i]++;
 
     if (PyDTrace_GC_DONE_ENABLED()) {
         PyDTrace_GC_DONE(n+m);
@@ -1214,12 +1364,14 @@ invoke_gc_callback(struct _gc_runtime_state *state, const char *phase,
  * progress callbacks.
  */
 static Py_ssize_t
-collect_with_callback(struct _gc_runtime_state *state, int generation)
+collect_with_callback(struct _gc_runtime_state *state, int generation,
+                      int incremental)
 {
     assert(!PyErr_Occurred());
     Py_ssize_t result, collected, uncollectable;
     invoke_gc_callback(state, "start", generation, 0, 0);
-    result = collect(state, generation, &collected, &uncollectable, 0);
+    result = collect(state, generation, incremental,
+                     &collected, &uncollectable, 0);
     invoke_gc_callback(state, "stop", generation, collected, uncollectable);
     assert(!PyErr_Occurred());
     return result;
@@ -1234,14 +1386,32 @@ collect_generations(struct _gc_runtime_state *state)
     Py_ssize_t n = 0;
     for (int i = NUM_GENERATIONS-1; i >= 0; i--) {
         if (state->generations[i].count > state->generations[i].threshold) {
-            /* Avoid quadratic performance degradation in number
-               of tracked objects. See comments at the beginning
-               of this file, and issue #4074.
-            */
-            if (i == NUM_GENERATIONS - 1
-                && state->long_lived_pending < state->long_lived_total / 4)
-                continue;
-            n = collect_with_callback(state, i);
+            int incremental = 0;
+            if (i == NUM_GENERATIONS - 1) {
+                /* The oldest generation is collected by increments if
+                   enabled, unless gc.freeze() was called. */
+                incremental = (state->incremental_slice > 0
+                               && gc_list_is_empty(
+                                   &state->permanent_generation.head));
+                /* Don't interrupt an incremental pass in progress. */
+                if (!incremental || state->incremental_remaining == 0) {
+                    /* Avoid quadratic performance degradation in number
+                       of tracked objects. See comments at the beginning
+                       of this file, and issue #4074.
+                    */
+                    if (state->long_lived_pending
+                        < state->long_lived_total / 4)
+                        continue;
+                    /* Cycles larger than a slice can be missed by the
+                       increments: do a full collection from time to
+                       time. */
+                    if (state->incremental_full_passes > 0
+                        && state->incremental_passes
+                           >= state->incremental_full_passes)
+                        incremental = 0;
+                }
+            }
+            n = collect_with_callback(state, i, incremental);
             break;
         }
     }
@@ -1323,7 +1493,7 @@ gc_collect_impl(PyObject *module, int generation)
     }
     else {
         state->collecting = 1;
-        n = collect_with_callback(state, generation);
+        n = collect_with_callback(state, generation, 0);
         state->collecting = 0;
     }
     return n;
@@ -1408,6 +1578,60 @@ gc_get_threshold_impl(PyObject *module)
                          state->generations[2].threshold);
 }
 
+/*[clinic input]
+gc.set_incremental
+
+    slice_size: Py_ssize_t
+    full_passes: int(c_default="INCREMENTAL_FULL_PASSES") = 10
+    /
+
+Collect the oldest generation incrementally.
+
+Each automatic collection of the oldest generation examines only the next
+slice_size objects of it, with the objects they reference, instead of the
+whole generation.  Setting slice_size to zero disables incremental
+collections.  A full collection is done instead of every full_passes-th
+pass over the oldest generation, to find the cycles larger than a slice;
+zero disables these full collections.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_incremental_impl(PyObject *module, Py_ssize_t slice_size,
+                        int full_passes)
+/*[clinic end generated code: output=158522ba5fc591cf input=282710ca2ac44a33]*/
+{
+    if (slice_size < 0) {
+        PyErr_SetString(PyExc_ValueError, "slice_size must be >= 0");
+        return NULL;
+    }
+    if (full_passes < 0) {
+        PyErr_SetString(PyExc_ValueError, "full_passes must be >= 0");
+        return NULL;
+    }
+    struct _gc_runtime_state *state = &_PyRuntime.gc;
+    state->incremental_slice = slice_size;
+    state->incremental_full_passes = full_passes;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_incremental
+
+Return the incremental collection settings.
+
+Return a tuple (slice_size, full_passes), see gc.set_incremental().
+[clinic start generated code]*/
+
+static PyObject *
+gc_get_incremental_impl(PyObject *module)
+/*[clinic end generated code: output=7dd3078b18c0e4ba input=6548a3ba8df05a34]*/
+{
+    struct _gc_runtime_state *state = &_PyRuntime.gc;
+    return Py_BuildValue("(ni)",
+                         state->incremental_slice,
+                         state->incremental_full_passes);
+}
+
 /*[clinic input]
 gc.get_count
 
@@ -1597,12 +1821,31 @@ gc_get_stats_impl(PyObject *module)
         return NULL;
 
     for (i = 0; i < NUM_GENERATIONS; i++) {
-        PyObject *dict;
+        PyObject *dict, *pauses;
         st = &stats[i];
-        dict = Py_BuildValue("{snsnsn}",
+        pauses = PyTuple_New(GC_PAUSE_BUCKETS);
+        if (pauses == NULL)
+            goto error;
+        for (int j = 0; j < GC_PAUSE_BUCKETS; j++) {
+            PyObject *count = PyLong_FromSsize_t(st->pauses[j]);
+            if (count == NULL) {
+                Py_DECREF(pauses);
+                goto error;
+            }
+            PyTuple_SET_ITEM(pauses, j, count);
+        }
+        dict = Py_BuildValue("{snsnsnsnsdsdsdsdsN}",
                              "collections", st->collections,
                              "collected", st->collected,
-                             "uncollectable", st->uncollectable
+                             "uncollectable", st->uncollectable,
+                             "examined", st->examined,
+                             "time", _PyTime_AsSecondsDouble(st->time),
+                             "unreachable_time",
+                             _PyTime_AsSecondsDouble(st->unreachable_time),
+                             "finalize_time",
+                             _PyTime_AsSecondsDouble(st->finalize_time),
+                             "max_time", _PyTime_AsSecondsDouble(st->max_time),
+                             "pauses", pauses
                             );
         if (dict == NULL)
             goto error;
@@ -1711,6 +1954,8 @@ PyDoc_STRVAR(gc__doc__,
 "get_debug() -- Get debugging flags.\n"
 "set_threshold() -- Set the collection thresholds.\n"
 "get_threshold() -- Return the current the collection thresholds.\n"
+"set_incremental() -- Collect the oldest generation incrementally.\n"
+"get_incremental() -- Return the incremental collection settings.\n"
 "get_objects() -- Return a list of all objects tracked by the collector.\n"
 "is_tracked() -- Returns true if a given object is tracked.\n"
 "get_referrers() -- Return the list of objects that refer to an object.\n"
@@ -1728,6 +1973,8 @@ static PyMethodDef GcMethods[] = {
     GC_GET_COUNT_METHODDEF
     {"set_threshold",  gc_set_threshold, METH_VARARGS, gc_set_thresh__doc__},
     GC_GET_THRESHOLD_METHODDEF
+    GC_SET_INCREMENTAL_METHODDEF
+    GC_GET_INCREMENTAL_METHODDEF
     GC_COLLECT_METHODDEF
     GC_GET_OBJECTS_METHODDEF
     GC_GET_STATS_METHODDEF
@@ -1812,7 +2059,7 @@ PyGC_Collect(void)
         PyObject *exc, *value, *tb;
         state->collecting = 1;
         PyErr_Fetch(&exc, &value, &tb);
-        n = collect_with_callback(state, NUM_GENERATIONS - 1);
+        n = collect_with_callback(state, NUM_GENERATIONS - 1, 0);
         PyErr_Restore(exc, value, tb);
         state->collecting = 0;
     }
@@ -1845,7 +2092,7 @@ _PyGC_CollectNoFail(void)
     }
     else {
         state->collecting = 1;
-        n = collect(state, NUM_GENERATIONS - 1, NULL, NULL, 1);
+        n = collect(state, NUM_GENERATIONS - 1, 0, NULL, NULL, 1);
         state->collecting = 0;
     }
     return n;
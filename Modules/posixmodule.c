@@ -469,6 +469,7 @@ PyOS_AfterFork_Child(void)
     _PyEval_ReInitThreads(runtime);
     _PyImport_ReInitLock();
     _PySignal_AfterFork();
+    _PySampler_AfterFork();
     _PyRuntimeState_ReInitThreads(runtime);
     _PyInterpreterState_DeleteExceptMain(runtime);
 
@@ -9539,6 +9540,121 @@ os_copy_file_range_impl(PyObject *module, int src, int dst, Py_ssize_t count,
 }
 #endif /* HAVE_COPY_FILE_RANGE*/
 
+#ifdef HAVE_SPLICE
+/*[clinic input]
+
+os.splice
+    src: int
+        Source file descriptor.
+    dst: int
+        Destination file descriptor.
+    count: Py_ssize_t
+        Number of bytes to move.
+    offset_src: object = None
+        Starting offset in src.
+    offset_dst: object = None
+        Starting offset in dst.
+    flags: unsigned_int = 0
+        Flags to modify the semantics of the call.
+
+Move count bytes from one file descriptor to another.
+
+The data does not go through user space.  One of src and dst must be a
+pipe, which cannot be given an offset.  If offset_src is None, then src
+is read from the current position; respectively for offset_dst.
+[clinic start generated code]*/
+
+static PyObject *
+os_splice_impl(PyObject *module, int src, int dst, Py_ssize_t count,
+               PyObject *offset_src, PyObject *offset_dst,
+               unsigned int flags)
+/*[clinic end generated code: output=d0386f25a8519dc5 input=e66478ea0a66842c]*/
+{
+    off_t offset_src_val, offset_dst_val;
+    off_t *p_offset_src = NULL;
+    off_t *p_offset_dst = NULL;
+    Py_ssize_t ret;
+    int async_err = 0;
+
+    if (count < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative value for 'count' not allowed");
+        return NULL;
+    }
+
+    if (offset_src != Py_None) {
+        if (!Py_off_t_converter(offset_src, &offset_src_val)) {
+            return NULL;
+        }
+        p_offset_src = &offset_src_val;
+    }
+
+    if (offset_dst != Py_None) {
+        if (!Py_off_t_converter(offset_dst, &offset_dst_val)) {
+            return NULL;
+        }
+        p_offset_dst = &offset_dst_val;
+    }
+
+    do {
+        Py_BEGIN_ALLOW_THREADS
+        ret = splice(src, p_offset_src, dst, p_offset_dst, count, flags);
+        Py_END_ALLOW_THREADS
+    } while (ret < 0 && errno == EINTR && !(async_err = PyErr_CheckSignals()));
+
+    if (ret < 0) {
+        return (!async_err) ? posix_error() : NULL;
+    }
+
+    return PyLong_FromSsize_t(ret);
+}
+#endif /* HAVE_SPLICE*/
+
+#ifdef HAVE_TEE
+/*[clinic input]
+
+os.tee
+    src: int
+        Source pipe.
+    dst: int
+        Destination pipe.
+    count: Py_ssize_t
+        Number of bytes to duplicate.
+    flags: unsigned_int = 0
+        Flags to modify the semantics of the call.
+
+Duplicate up to count bytes from one pipe to another.
+
+The data is not consumed from src, so it can be read again, e.g. by
+splice().  The data does not go through user space.
+[clinic start generated code]*/
+
+static PyObject *
+os_tee_impl(PyObject *module, int src, int dst, Py_ssize_t count,
+            unsigned int flags)
+/*[clinic end generated code: output=98f9abb5cf6ce4e4 input=9fdcdc505427a596]*/
+{
+    Py_ssize_t ret;
+    int async_err = 0;
+
+    if (count < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative value for 'count' not allowed");
+        return NULL;
+    }
+
+    do {
+        Py_BEGIN_ALLOW_THREADS
+        ret = tee(src, dst, count, flags);
+        Py_END_ALLOW_THREADS
+    } while (ret < 0 && errno == EINTR && !(async_err = PyErr_CheckSignals()));
+
+    if (ret < 0) {
+        return (!async_err) ? posix_error() : NULL;
+    }
+
+    return PyLong_FromSsize_t(ret);
+}
+#endif /* HAVE_TEE*/
+
 #ifdef HAVE_MKFIFO
 /*[clinic input]
 os.mkfifo
@@ -13519,6 +13635,8 @@ static PyMethodDef posix_methods[] = {
     OS_POSIX_SPAWNP_METHODDEF
     OS_READLINK_METHODDEF
     OS_COPY_FILE_RANGE_METHODDEF
+    OS_SPLICE_METHODDEF
+    OS_TEE_METHODDEF
     OS_RENAME_METHODDEF
     OS_REPLACE_METHODDEF
     OS_RMDIR_METHODDEF
@@ -13965,6 +14083,17 @@ all_ins(PyObject *m)
     if (PyModule_AddIntMacro(m, SF_SYNC)) return -1;
 #endif
 
+    /* constants for splice and tee */
+#ifdef SPLICE_F_MOVE
+    if (PyModule_AddIntMacro(m, SPLICE_F_MOVE)) return -1;
+#endif
+#ifdef SPLICE_F_NONBLOCK
+    if (PyModule_AddIntMacro(m, SPLICE_F_NONBLOCK)) return -1;
+#endif
+#ifdef SPLICE_F_MORE
+    if (PyModule_AddIntMacro(m, SPLICE_F_MORE)) return -1;
+#endif
+
     /* constants for posix_fadvise */
 #ifdef POSIX_FADV_NORMAL
     if (PyModule_AddIntMacro(m, POSIX_FADV_NORMAL)) return -1;
@@ -1631,6 +1631,17 @@ PyErr_CheckSignals(void)
 }
 
 
+/* Declared in cpython/pyerrors.h */
+/* Return nonzero if a signal arrived that PyErr_CheckSignals() has not
+   handled yet.  This only reads an atomic flag, so unlike
+   PyErr_CheckSignals() it can be called without holding the GIL. */
+int
+_PyErr_SignalsPending(void)
+{
+    return _Py_atomic_load(&is_tripped);
+}
+
+
 /* Declared in cpython/pyerrors.h */
 int
 _PyErr_CheckSignals(void)
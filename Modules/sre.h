@@ -83,6 +83,9 @@ typedef struct {
     size_t data_stack_base;
     /* current repeat context */
     SRE_REPEAT *repeat;
+    /* saved thread state while the GIL is released for matching */
+    PyThreadState *tstate;
+    int main_thread; /* whether signal handlers can run in this thread */
 } SRE_STATE;
 
 typedef struct {
@@ -584,7 +584,7 @@ entrance:
 
     for (;;) {
         ++sigcount;
-        if ((0 == (sigcount & 0xfff)) && PyErr_CheckSignals())
+        if ((0 == (sigcount & 0xfff)) && sre_check_signals(state))
             RETURN_ERROR(SRE_ERROR_INTERRUPTED);
 
         switch (*ctx->pattern++) {
@@ -988,11 +988,9 @@ entrance:
                    ctx->pattern[1], ctx->pattern[2]));
 
             /* install new repeat context */
-            ctx->u.rep = (SRE_REPEAT*) PyObject_MALLOC(sizeof(*ctx->u.rep));
-            if (!ctx->u.rep) {
-                PyErr_NoMemory();
-                RETURN_FAILURE;
-            }
+            ctx->u.rep = (SRE_REPEAT*) PyMem_RawMalloc(sizeof(*ctx->u.rep));
+            if (!ctx->u.rep)
+                RETURN_ERROR(SRE_ERROR_MEMORY);
             ctx->u.rep->count = -1;
             ctx->u.rep->pattern = ctx->pattern;
             ctx->u.rep->prev = state->repeat;
@@ -1002,7 +1000,7 @@ entrance:
             state->ptr = ctx->ptr;
             DO_JUMP(JUMP_REPEAT, jump_repeat, ctx->pattern+ctx->pattern[0]);
             state->repeat = ctx->u.rep->prev;
-            PyObject_FREE(ctx->u.rep);
+            PyMem_RawFree(ctx->u.rep);
 
             if (ret) {
                 RETURN_ON_ERROR(ret);
@@ -1367,6 +1365,70 @@ exit:
 #define RESET_CAPTURE_GROUP() \
     do { state->lastmark = state->lastindex = -1; } while (0)
 
+/* Find the first occurrence of the len characters of literal in the string
+   from ptr to end, or return NULL. */
+static SRE_CHAR*
+SRE(find_literal)(SRE_CHAR* ptr, SRE_CHAR* end, SRE_CODE* literal,
+                  Py_ssize_t len)
+{
+    SRE_CHAR c = (SRE_CHAR) literal[0];
+    Py_ssize_t i;
+
+#if SIZEOF_SRE_CHAR < 4
+    for (i = 0; i < len; i++)
+        if ((SRE_CODE)(SRE_CHAR) literal[i] != literal[i])
+            return NULL; /* literal can't match: doesn't fit in char width */
+#endif
+    if (end - ptr < len)
+        return NULL;
+    end -= len - 1;
+    while (ptr < end) {
+#if SIZEOF_SRE_CHAR == 1
+        ptr = (SRE_CHAR *)memchr(ptr, c, end - ptr);
+        if (ptr == NULL)
+            return NULL;
+#else
+        while (*ptr != c) {
+            if (++ptr >= end)
+                return NULL;
+        }
+#endif
+        for (i = 1; i < len && ptr[i] == (SRE_CHAR) literal[i]; i++)
+            ;
+        if (i == len)
+            return ptr;
+        ptr++;
+    }
+    return NULL;
+}
+
+/* A match starting at ptr must contain the literal required by the pattern
+   (<length> <min offset> <max offset> <literal data>) at an offset from ptr
+   between min and max.  Return the first position from ptr where this is
+   possible, or NULL if there is none.  *limit is set to the last position
+   the occurrence of the literal found is good for: callers only need to
+   call again when they pass it.  This is kept out of line, away from the
+   search loops. */
+static SRE_CHAR* _Py_NO_INLINE
+SRE(skip_to_required)(SRE_STATE* state, SRE_CHAR* ptr, SRE_CODE* required,
+                      SRE_CHAR** limit)
+{
+    SRE_CHAR* end = (SRE_CHAR *)state->end;
+    SRE_CODE min = required[1];
+    SRE_CODE max = required[2];
+    SRE_CHAR* literal;
+
+    if ((uintptr_t)(end - ptr) < min)
+        return NULL;
+    literal = SRE(find_literal)(ptr + min, end, required + 3, required[0]);
+    if (literal == NULL)
+        return NULL;
+    *limit = literal - min;
+    if (max != SRE_MAXREPEAT && literal - ptr > (Py_ssize_t)max)
+        ptr = literal - max;
+    return ptr;
+}
+
 LOCAL(Py_ssize_t)
 SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
 {
@@ -1378,6 +1440,8 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
     SRE_CODE* prefix = NULL;
     SRE_CODE* charset = NULL;
     SRE_CODE* overlap = NULL;
+    SRE_CODE* required = NULL;
+    SRE_CHAR* required_limit = NULL;
     int flags = 0;
 
     if (ptr > end)
@@ -1385,7 +1449,9 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
 
     if (pattern[0] == SRE_OP_INFO) {
         /* optimization info block */
-        /* <INFO> <1=skip> <2=flags> <3=min> <4=max> <5=prefix info>  */
+        /* <INFO> <1=skip> <2=flags> <3=min> <4=max>
+           <5=required literal info> <prefix info> */
+        SRE_CODE* info = pattern + 5;
 
         flags = pattern[2];
 
@@ -1402,17 +1468,24 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
                 end = ptr;
         }
 
+        if (flags & SRE_INFO_REQUIRED) {
+            /* pattern contains a known literal further than its start */
+            /* <length> <min offset> <max offset> <literal data> */
+            required = info;
+            info += 3 + info[0];
+        }
+
         if (flags & SRE_INFO_PREFIX) {
             /* pattern starts with a known prefix */
             /* <length> <skip> <prefix data> <overlap data> */
-            prefix_len = pattern[5];
-            prefix_skip = pattern[6];
-            prefix = pattern + 7;
+            prefix_len = info[0];
+            prefix_skip = info[1];
+            prefix = info + 2;
             overlap = prefix + prefix_len - 1;
         } else if (flags & SRE_INFO_CHARSET)
             /* pattern starts with a character from a known set */
             /* <charset> */
-            charset = pattern + 5;
+            charset = info;
 
         pattern += 1 + pattern[1];
     }
@@ -1421,6 +1494,13 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
            prefix, prefix_len, prefix_skip));
     TRACE(("charset = %p\n", charset));
 
+    if (required) {
+        /* no need to try matching if the literal isn't there */
+        ptr = SRE(skip_to_required)(state, ptr, required, &required_limit);
+        if (ptr == NULL || ptr > end)
+            return 0;
+    }
+
     if (prefix_len == 1) {
         /* pattern starts with a literal character */
         SRE_CHAR c = (SRE_CHAR) prefix[0];
@@ -1509,6 +1589,16 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
                 ptr++;
             if (ptr >= end)
                 return 0;
+            if (required && ptr > required_limit) {
+                SRE_CHAR* next = SRE(skip_to_required)(state, ptr, required,
+                                                       &required_limit);
+                if (next == NULL)
+                    return 0;
+                if (next != ptr) {
+                    ptr = next;
+                    continue;
+                }
+            }
             TRACE(("|%p|%p|SEARCH CHARSET\n", pattern, ptr));
             state->start = ptr;
             state->ptr = ptr;
@@ -1527,6 +1617,12 @@ SRE(search)(SRE_STATE* state, SRE_CODE* pattern)
         state->must_advance = 0;
         while (status == 0 && ptr < end) {
             ptr++;
+            if (required && ptr > required_limit) {
+                ptr = SRE(skip_to_required)(state, ptr, required,
+                                            &required_limit);
+                if (ptr == NULL || ptr > end)
+                    return 0;
+            }
             RESET_CAPTURE_GROUP();
             TRACE(("|%p|%p|SEARCH\n", pattern, ptr));
             state->start = state->ptr = ptr;
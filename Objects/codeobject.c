@@ -237,6 +237,7 @@ PyCode_NewWithPosOnlyArgs(int argcount, int posonlyargcount, int kwonlyargcount,
 
     co->co_opcache_map = NULL;
     co->co_opcache = NULL;
+    co->co_quickened = NULL;
     co->co_opcache_flag = 0;
     co->co_opcache_size = 0;
     return co;
@@ -272,8 +273,9 @@ _PyCode_InitOpcache(PyCodeObject *co)
         unsigned char opcode = _Py_OPCODE(opcodes[i]);
         i++;  // 'i' is now aligned to (next_instr - first_instr)
 
-        // TODO: LOAD_METHOD, LOAD_ATTR
-        if (opcode == LOAD_GLOBAL) {
+        if (opcode == LOAD_GLOBAL || opcode == LOAD_ATTR ||
+            opcode == STORE_ATTR || opcode == LOAD_METHOD)
+        {
             opts++;
             co->co_opcache_map[i] = (unsigned char)opts;
             if (opts > 254) {
@@ -299,6 +301,74 @@ _PyCode_InitOpcache(PyCodeObject *co)
     return 0;
 }
 
+/* Create the quickened copy of the bytecode, where the instructions which
+   can be specialized for the types of their operands are replaced by their
+   adaptive variant, and the first instruction of some common pairs by a
+   superinstruction executing both.  See the *_ADAPTIVE instructions and the
+   superinstructions in ceval.c. */
+int
+_PyCode_Quicken(PyCodeObject *co)
+{
+    Py_ssize_t size = PyBytes_GET_SIZE(co->co_code);
+    Py_ssize_t co_size = size / sizeof(_Py_CODEUNIT);
+    _Py_CODEUNIT *quickened;
+
+    assert(co->co_quickened == NULL);
+    quickened = (_Py_CODEUNIT *)PyMem_Malloc(size);
+    if (quickened == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memcpy(quickened, PyBytes_AS_STRING(co->co_code), size);
+
+    for (Py_ssize_t i = 0; i < co_size; i++) {
+        int opcode = _Py_OPCODE(quickened[i]);
+        int oparg = _Py_OPARG(quickened[i]);
+        /* The second instruction of a superinstruction is left unchanged:
+           it is still executed alone when it is a jump target, or when
+           tracing.  Since it directly follows the first one, it has no
+           EXTENDED_ARG prefix. */
+        int next = i + 1 < co_size ? _Py_OPCODE(quickened[i + 1]) : 0;
+
+        if (i > 0 && _Py_OPCODE(quickened[i - 1]) == EXTENDED_ARG) {
+            continue;
+        }
+        switch (opcode) {
+        case LOAD_FAST:
+            if (next == LOAD_FAST) {
+                opcode = LOAD_FAST__LOAD_FAST;
+            }
+            else if (next == LOAD_ATTR) {
+                opcode = LOAD_FAST__LOAD_ATTR;
+            }
+            else {
+                continue;
+            }
+            break;
+        case BINARY_ADD:
+            opcode = BINARY_ADD_ADAPTIVE;
+            break;
+        case BINARY_SUBSCR:
+            opcode = BINARY_SUBSCR_ADAPTIVE;
+            break;
+        case COMPARE_OP:
+            /* Only rich comparisons are specialized, and fused with a
+               following POP_JUMP_IF_FALSE by COMPARE_OP_ADAPTIVE */
+            if (oparg > Py_GE) {
+                continue;
+            }
+            opcode = COMPARE_OP_ADAPTIVE;
+            break;
+        default:
+            continue;
+        }
+        quickened[i] = _Py_MAKECODEUNIT(opcode, oparg);
+    }
+
+    co->co_quickened = quickened;
+    return 0;
+}
+
 PyCodeObject *
 PyCode_NewEmpty(const char *filename, const char *funcname, int firstlineno)
 {
@@ -530,6 +600,9 @@ code_dealloc(PyCodeObject *co)
     if (co->co_opcache_map != NULL) {
         PyMem_FREE(co->co_opcache_map);
     }
+    if (co->co_quickened != NULL) {
+        PyMem_FREE(co->co_quickened);
+    }
     co->co_opcache_flag = 0;
     co->co_opcache_size = 0;
 
@@ -586,6 +659,9 @@ code_sizeof(PyCodeObject *co, PyObject *Py_UNUSED(args))
         // co_opcache
         res += co->co_opcache_size * sizeof(_PyOpcache);
     }
+    if (co->co_quickened != NULL) {
+        res += PyBytes_GET_SIZE(co->co_code);
+    }
     return PyLong_FromSsize_t(res);
 }
 
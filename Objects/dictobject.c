@@ -1508,6 +1508,106 @@ _PyDict_LoadGlobal(PyDictObject *globals, PyDictObject *builtins, PyObject *key)
     return value;
 }
 
+/* Lookup with an entry index hint, used by the attribute opcode caches.
+ *
+ * hint is the index of the entry where key was found the last time (or -1).
+ * If that entry still holds key, its value is returned without hashing and
+ * probing; otherwise a regular lookup is done.
+ *
+ * Return the index of the entry and set *value on success. Return DKIX_EMPTY
+ * if the key doesn't exist, or DKIX_ERROR with an exception set.
+ */
+Py_ssize_t
+_PyDict_GetItemHint(PyDictObject *mp, PyObject *key,
+                    Py_ssize_t hint, PyObject **value)
+{
+    Py_ssize_t ix;
+    Py_hash_t hash;
+    PyObject *res = NULL;
+
+    assert(PyDict_Check(mp));
+    assert(PyUnicode_CheckExact(key));
+
+    if (hint >= 0 && hint < mp->ma_keys->dk_nentries) {
+        PyDictKeyEntry *ep = DK_ENTRIES(mp->ma_keys) + hint;
+        if (ep->me_key == key) {
+            if (_PyDict_HasSplitTable(mp)) {
+                res = mp->ma_values[hint];
+            }
+            else {
+                res = ep->me_value;
+            }
+            if (res != NULL) {
+                *value = res;
+                return hint;
+            }
+        }
+    }
+
+    if ((hash = ((PyASCIIObject *) key)->hash) == -1) {
+        hash = PyObject_Hash(key);
+        if (hash == -1)
+            return DKIX_ERROR;
+    }
+
+    ix = (mp->ma_keys->dk_lookup)(mp, key, hash, &res);
+    if (ix >= 0 && res == NULL) {
+        /* pending slot of a split table */
+        return DKIX_EMPTY;
+    }
+    *value = res;
+    return ix;
+}
+
+/* Set the value of key stored in the entry at index hint, as returned by
+ * _PyDict_GetItemHint(). Return 1 on success. Return 0 if the entry doesn't
+ * hold key anymore, or if the value cannot be stored there without changing
+ * the layout of the dict: the dict is left unchanged and the caller must fall
+ * back to PyDict_SetItem(). This function cannot fail.
+ */
+int
+_PyDict_SetItemHint(PyDictObject *mp, PyObject *key,
+                    Py_ssize_t hint, PyObject *value)
+{
+    PyDictKeyEntry *ep;
+    PyObject *old_value;
+
+    assert(PyDict_Check(mp));
+    assert(value != NULL);
+
+    if (hint < 0 || hint >= mp->ma_keys->dk_nentries) {
+        return 0;
+    }
+    ep = DK_ENTRIES(mp->ma_keys) + hint;
+    if (ep->me_key != key) {
+        return 0;
+    }
+    if (_PyDict_HasSplitTable(mp)) {
+        old_value = mp->ma_values[hint];
+        if (old_value == NULL) {
+            /* pending state: the value can only be added if this keeps the
+               insertion order of the shared keys */
+            if (mp->ma_used != hint) {
+                return 0;
+            }
+            mp->ma_used++;
+        }
+        Py_INCREF(value);
+        mp->ma_values[hint] = value;
+    }
+    else {
+        old_value = ep->me_value;
+        assert(old_value != NULL);
+        Py_INCREF(value);
+        ep->me_value = value;
+    }
+    MAINTAIN_TRACKING(mp, key, value);
+    mp->ma_version_tag = DICT_NEXT_VERSION();
+    ASSERT_CONSISTENT(mp);
+    Py_XDECREF(old_value); /* which **CAN** re-enter (see issue #22653) */
+    return 1;
+}
+
 /* CAUTION: PyDict_SetItem() must guarantee that it won't resize the
  * dictionary if it's merely replacing the value for an existing key.
  * This means that it's safe to loop over a dictionary with PyDict_Next()
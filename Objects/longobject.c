@@ -31,6 +31,33 @@ _Py_IDENTIFIER(big);
              (Py_SIZE(x) == 0 ? (sdigit)0 :                             \
               (sdigit)(x)->ob_digit[0]))
 
+/* Ints of at most 2 digits are "compact": their values, and the sum or the
+   difference of two of them, fit in an int64_t.  Arithmetic on them is done
+   with machine integers, see long_add(), long_sub() and long_mul(). */
+#define IS_COMPACT(x) (Py_ABS(Py_SIZE(x)) <= 2)
+
+static inline int64_t
+compact_value(PyLongObject *x)
+{
+    int64_t v;
+
+    assert(IS_COMPACT(x));
+    switch (Py_SIZE(x)) {
+    case 0:
+        return 0;
+    case 1:
+        return x->ob_digit[0];
+    case -1:
+        return -(int64_t)x->ob_digit[0];
+    }
+    v = ((int64_t)x->ob_digit[1] << PyLong_SHIFT) | x->ob_digit[0];
+    return Py_SIZE(x) < 0 ? -v : v;
+}
+
+/* The product of two compact values smaller than this in absolute value
+   fits in an int64_t */
+#define COMPACT_MUL_LIMIT ((int64_t)1 << 31)
+
 PyObject *_PyLong_Zero = NULL;
 PyObject *_PyLong_One = NULL;
 
@@ -106,6 +133,17 @@ _PyLong_Negate(PyLongObject **x_p)
 #define KARATSUBA_CUTOFF 70
 #define KARATSUBA_SQUARE_CUTOFF (2 * KARATSUBA_CUTOFF)
 
+/* For int multiplication, use Toom-Cook 3-way multiplication instead of
+ * Karatsuba when both operands contain at least TOOM3_CUTOFF digits.
+ */
+#define TOOM3_CUTOFF 500
+
+/* For int division, use Burnikel-Ziegler division instead of the school
+ * algorithm when both the divisor and the quotient contain more than
+ * BZ_DIV_CUTOFF digits.
+ */
+#define BZ_DIV_CUTOFF 40
+
 /* For exponentiation, use the binary left-to-right algorithm
  * unless the exponent contains more than FIVEARY_CUTOFF digits.
  * In that case, do 5 bits at a time.  The potential drawback is that
@@ -252,6 +290,20 @@ _PyLong_FromNbIndexOrNbInt(PyObject *integral)
 }
 
 
+/* Special free list
+   free_list is a singly-linked list of available int objects, linked via
+   abuse of their ob_type members.  Ints of at most LONG_FREELIST_DIGITS
+   digits are all allocated with room for that many digits, so that any of
+   them can be recycled.
+*/
+
+#ifndef PyLong_MAXFREELIST
+#define PyLong_MAXFREELIST    100
+#endif
+#define LONG_FREELIST_DIGITS 2
+static int numfree = 0;
+static PyLongObject *free_list = NULL;
+
 /* Allocate a new int object with size digits.
    Return NULL and set exception if we run out of memory. */
 
@@ -262,6 +314,22 @@ PyLongObject *
 _PyLong_New(Py_ssize_t size)
 {
     PyLongObject *result;
+    if (size <= LONG_FREELIST_DIGITS) {
+        result = free_list;
+        if (result != NULL) {
+            free_list = (PyLongObject *) Py_TYPE(result);
+            numfree--;
+        }
+        else {
+            result = PyObject_MALLOC(offsetof(PyLongObject, ob_digit) +
+                                     LONG_FREELIST_DIGITS*sizeof(digit));
+            if (!result) {
+                PyErr_NoMemory();
+                return NULL;
+            }
+        }
+        return (PyLongObject*)PyObject_INIT_VAR(result, &PyLong_Type, size);
+    }
     /* Number of bytes needed is: offsetof(PyLongObject, ob_digit) +
        sizeof(digit)*size.  Previous incarnations of this code used
        sizeof(PyVarObject) instead of the offsetof, but this risks being
@@ -304,6 +372,36 @@ _PyLong_Copy(PyLongObject *src)
     return (PyObject *)result;
 }
 
+/* Create a new int object from a compact value, or any int64_t value. */
+
+static PyObject *
+compact_long(int64_t ival)
+{
+    PyLongObject *v;
+    uint64_t abs_ival;
+
+    CHECK_SMALL_INT(ival);
+    abs_ival = ival < 0 ? 0U - (uint64_t)ival : (uint64_t)ival;
+    if (abs_ival >> (2 * PyLong_SHIFT)) {
+        return PyLong_FromLongLong(ival);
+    }
+    if (abs_ival >> PyLong_SHIFT) {
+        v = _PyLong_New(2);
+        if (v == NULL)
+            return NULL;
+        v->ob_digit[1] = (digit)(abs_ival >> PyLong_SHIFT);
+        Py_SIZE(v) = ival < 0 ? -2 : 2;
+    }
+    else {
+        v = _PyLong_New(1);
+        if (v == NULL)
+            return NULL;
+        Py_SIZE(v) = ival < 0 ? -1 : 1;
+    }
+    v->ob_digit[0] = (digit)(abs_ival & PyLong_MASK);
+    return (PyObject *)v;
+}
+
 /* Create a new int object from a C long int */
 
 PyObject *
@@ -1738,6 +1836,77 @@ divrem1(PyLongObject *a, digit n, digit *prem)
     return long_normalize(z);
 }
 
+/* Convert the size_a digits of pin to an array of base
+   _PyLong_DECIMAL_BASE digits in pout, following Knuth (TAOCP, Volume 2 (3rd
+   edn), section 4.4, Method 1b).  Return the number of digits of pout, or
+   -1 if interrupted by a signal.  pout must be large enough. */
+static Py_ssize_t
+digits_to_decimal_base(const digit *pin, Py_ssize_t size_a, digit *pout)
+{
+    Py_ssize_t size = 0, i, j;
+
+    for (i = size_a; --i >= 0; ) {
+        digit hi = pin[i];
+        for (j = 0; j < size; j++) {
+            twodigits z = (twodigits)pout[j] << PyLong_SHIFT | hi;
+            hi = (digit)(z / _PyLong_DECIMAL_BASE);
+            pout[j] = (digit)(z - (twodigits)hi *
+                              _PyLong_DECIMAL_BASE);
+        }
+        while (hi) {
+            pout[size++] = hi % _PyLong_DECIMAL_BASE;
+            hi /= _PyLong_DECIMAL_BASE;
+        }
+        /* check for keyboard interrupt */
+        SIGCHECK({
+                return -1;
+            });
+    }
+    return size;
+}
+
+/* Return the int whose base _PyLong_DECIMAL_BASE digits are the size digits
+   of pin. */
+static PyLongObject *
+decimal_base_to_long(const digit *pin, Py_ssize_t size)
+{
+    PyLongObject *z;
+    Py_ssize_t i, j;
+
+    /* _PyLong_DECIMAL_BASE < PyLong_BASE: each digit of pin adds at most
+       one digit to z */
+    z = _PyLong_New(size + 1);
+    if (z == NULL) {
+        return NULL;
+    }
+    Py_SIZE(z) = 0;
+    for (i = size; --i >= 0; ) {
+        twodigits c = pin[i];
+        for (j = 0; j < Py_SIZE(z); j++) {
+            c += (twodigits)z->ob_digit[j] * _PyLong_DECIMAL_BASE;
+            z->ob_digit[j] = (digit)(c & PyLong_MASK);
+            c >>= PyLong_SHIFT;
+        }
+        if (c) {
+            assert(c < PyLong_BASE);
+            z->ob_digit[Py_SIZE(z)++] = (digit)c;
+        }
+    }
+    return z;
+}
+
+/* Above these numbers of digits, the conversions between ints and decimal
+   strings use the divide-and-conquer algorithms defined after k_mul(),
+   rather than the quadratic ones.  The first is a number of int digits, the
+   second a number of decimal digits. */
+#define DECIMAL_DC_TO_DECIMAL_CUTOFF 1200
+#define DECIMAL_DC_FROM_DECIMAL_CUTOFF 7000
+
+/* forward */
+static Py_ssize_t long_to_decimal_base_dc(PyLongObject *, digit *,
+                                          Py_ssize_t);
+static PyLongObject *long_from_decimal_base_dc(const digit *, Py_ssize_t);
+
 /* Convert an integer to a base 10 string.  Returns a new non-shared
    string.  (Return value is non-shared so that callers can modify the
    returned value if necessary.) */
@@ -1752,7 +1921,7 @@ long_to_decimal_string_internal(PyObject *aa,
     PyLongObject *scratch, *a;
     PyObject *str = NULL;
     Py_ssize_t size, strlen, size_a, i, j;
-    digit *pout, *pin, rem, tenpow;
+    digit *pout, rem, tenpow;
     int negative;
     int d;
     enum PyUnicode_Kind kind;
@@ -1787,29 +1956,18 @@ long_to_decimal_string_internal(PyObject *aa,
     if (scratch == NULL)
         return -1;
 
-    /* convert array of base _PyLong_BASE digits in pin to an array of
-       base _PyLong_DECIMAL_BASE digits in pout, following Knuth (TAOCP,
-       Volume 2 (3rd edn), section 4.4, Method 1b). */
-    pin = a->ob_digit;
+    /* convert array of base _PyLong_BASE digits in a to an array of
+       base _PyLong_DECIMAL_BASE digits in pout */
     pout = scratch->ob_digit;
-    size = 0;
-    for (i = size_a; --i >= 0; ) {
-        digit hi = pin[i];
-        for (j = 0; j < size; j++) {
-            twodigits z = (twodigits)pout[j] << PyLong_SHIFT | hi;
-            hi = (digit)(z / _PyLong_DECIMAL_BASE);
-            pout[j] = (digit)(z - (twodigits)hi *
-                              _PyLong_DECIMAL_BASE);
-        }
-        while (hi) {
-            pout[size++] = hi % _PyLong_DECIMAL_BASE;
-            hi /= _PyLong_DECIMAL_BASE;
-        }
-        /* check for keyboard interrupt */
-        SIGCHECK({
-                Py_DECREF(scratch);
-                return -1;
-            });
+    if (size_a > DECIMAL_DC_TO_DECIMAL_CUTOFF) {
+        size = long_to_decimal_base_dc(a, pout, size);
+    }
+    else {
+        size = digits_to_decimal_base(a->ob_digit, size_a, pout);
+    }
+    if (size < 0) {
+        Py_DECREF(scratch);
+        return -1;
     }
     /* pout should have at least one digit, so that the case when a = 0
        works correctly */
@@ -2268,6 +2426,54 @@ long_from_binary_base(const char **str, int base, PyLongObject **res)
     return 0;
 }
 
+/* Convert the digits decimal digits between str and end, which can be
+   separated by underscores, with the divide-and-conquer algorithm, and
+   return the int with the given sign.  Used by PyLong_FromString() for long
+   strings. */
+static PyLongObject *
+long_from_decimal_string(const char *str, const char *end, Py_ssize_t digits,
+                         int sign)
+{
+    Py_ssize_t size = (digits + _PyLong_DECIMAL_SHIFT - 1) /
+                      _PyLong_DECIMAL_SHIFT;
+    Py_ssize_t i = 0;
+    digit *pin, d = 0, tenpow = 1;
+    PyLongObject *z;
+
+    pin = PyMem_New(digit, size);
+    if (pin == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    /* Group the digits by _PyLong_DECIMAL_SHIFT, from the end */
+    while (end > str) {
+        char c = *--end;
+        if (c == '_') {
+            continue;
+        }
+        d += tenpow * (c - '0');
+        tenpow *= 10;
+        if (tenpow == _PyLong_DECIMAL_BASE) {
+            pin[i++] = d;
+            d = 0;
+            tenpow = 1;
+        }
+    }
+    if (tenpow != 1) {
+        pin[i++] = d;
+    }
+    assert(i == size);
+    z = long_from_decimal_base_dc(pin, size);
+    PyMem_Free(pin);
+    if (z == NULL) {
+        return NULL;
+    }
+    if (sign < 0) {
+        Py_SIZE(z) = -(Py_SIZE(z));
+    }
+    return maybe_small_long(long_normalize(z));
+}
+
 /* Parses an int from a bytestring. Leading and trailing whitespace will be
  * ignored.
  *
@@ -2488,6 +2694,23 @@ digit beyond the first.
             goto onError;
         }
 
+        /* Long decimal strings are converted in subquadratic time.  Invalid
+           ones are left to the code below, which reports the error. */
+        if (base == 10 && !error_if_nonzero &&
+            digits > DECIMAL_DC_FROM_DECIMAL_CUTOFF) {
+            const char *end = scan;
+            while (*end && Py_ISSPACE(Py_CHARMASK(*end))) {
+                end++;
+            }
+            if (*end == '\0') {
+                z = long_from_decimal_string(str, scan, digits, sign);
+                if (z != NULL && pend != NULL) {
+                    *pend = (char *)end;
+                }
+                return (PyObject *)z;
+            }
+        }
+
         /* Create an int object that can contain the largest possible
          * integer with this base and length.  Note that there's no
          * need to initialize z->ob_digit -- no slot is read up before
@@ -2700,6 +2923,8 @@ PyLong_FromUnicodeObject(PyObject *u, int base)
 /* forward */
 static PyLongObject *x_divrem
     (PyLongObject *, PyLongObject *, PyLongObject **);
+static PyLongObject *bz_divrem
+    (PyLongObject *, PyLongObject *, PyLongObject **);
 static PyObject *long_long(PyObject *v);
 
 /* Int division with remainder, top-level routine */
@@ -2739,6 +2964,11 @@ long_divrem(PyLongObject *a, PyLongObject *b,
             return -1;
         }
     }
+    else if (size_b > BZ_DIV_CUTOFF && size_a - size_b > BZ_DIV_CUTOFF) {
+        z = bz_divrem(a, b, prem);
+        if (z == NULL)
+            return -1;
+    }
     else {
         z = x_divrem(a, b, prem);
         if (z == NULL)
@@ -3243,8 +3473,8 @@ long_add(PyLongObject *a, PyLongObject *b)
 
     CHECK_BINOP(a, b);
 
-    if (Py_ABS(Py_SIZE(a)) <= 1 && Py_ABS(Py_SIZE(b)) <= 1) {
-        return PyLong_FromLong(MEDIUM_VALUE(a) + MEDIUM_VALUE(b));
+    if (IS_COMPACT(a) && IS_COMPACT(b)) {
+        return compact_long(compact_value(a) + compact_value(b));
     }
     if (Py_SIZE(a) < 0) {
         if (Py_SIZE(b) < 0) {
@@ -3277,8 +3507,8 @@ long_sub(PyLongObject *a, PyLongObject *b)
 
     CHECK_BINOP(a, b);
 
-    if (Py_ABS(Py_SIZE(a)) <= 1 && Py_ABS(Py_SIZE(b)) <= 1) {
-        return PyLong_FromLong(MEDIUM_VALUE(a) - MEDIUM_VALUE(b));
+    if (IS_COMPACT(a) && IS_COMPACT(b)) {
+        return compact_long(compact_value(a) - compact_value(b));
     }
     if (Py_SIZE(a) < 0) {
         if (Py_SIZE(b) < 0)
@@ -3422,6 +3652,7 @@ kmul_split(PyLongObject *n,
 }
 
 static PyLongObject *k_lopsided_mul(PyLongObject *a, PyLongObject *b);
+static PyLongObject *toom3_mul(PyLongObject *a, PyLongObject *b);
 
 /* Karatsuba multiplication.  Ignores the input signs, and returns the
  * absolute value of the product (or NULL if error).
@@ -3480,6 +3711,12 @@ k_mul(PyLongObject *a, PyLongObject *b)
     if (2 * asize <= bsize)
         return k_lopsided_mul(a, b);
 
+    /* Above TOOM3_CUTOFF, split in three pieces instead of two: see
+     * toom3_mul().  That needs three non-empty pieces of a.
+     */
+    if (asize >= TOOM3_CUTOFF && asize > 2 * ((bsize + 2) / 3))
+        return toom3_mul(a, b);
+
     /* Split a & b into hi & lo pieces. */
     shift = bsize >> 1;
     if (kmul_split(a, shift, &ah, &al) < 0) goto fail;
@@ -3702,6 +3939,486 @@ k_lopsided_mul(PyLongObject *a, PyLongObject *b)
     return NULL;
 }
 
+/* Toom-Cook 3-way multiplication, used by k_mul() when both inputs have at
+ * least TOOM3_CUTOFF digits and a can be split in three non-empty pieces.
+ * Ignores the input signs, and returns the absolute value of the product
+ * (or NULL if error).
+ *
+ * a and b are split at multiples of X = BASE**shift, with shift about a
+ * third of b's size, giving the polynomials
+ *     a(x) = a2*x**2 + a1*x + a0    and    b(x) = b2*x**2 + b1*x + b0
+ * whose product c(x) = c4*x**4 + ... + c0 is evaluated at x = 0, 1, -1, -2
+ * and infinity by 5 recursive multiplications of numbers of a third of the
+ * size, instead of 9.  The coefficients are then interpolated with the
+ * sequence of Bodrato and Zanoni ("What about Toom-Cook matrices
+ * optimality?", 2006), and c(X) is the product.  The values at -1 and -2
+ * are signed: unlike Karatsuba, the intermediate results are ints, not
+ * digit arrays.
+ */
+
+/* Return x * y, with the sign of the product. */
+static PyLongObject *
+toom3_signed_mul(PyLongObject *x, PyLongObject *y)
+{
+    PyLongObject *z = k_mul(x, y);
+    if (z != NULL && (Py_SIZE(x) ^ Py_SIZE(y)) < 0) {
+        _PyLong_Negate(&z);
+    }
+    return z;
+}
+
+/* Return x / n, for an int x divisible by the digit n. */
+static PyLongObject *
+toom3_divexact(PyLongObject *x, digit n)
+{
+    digit rem;
+    PyLongObject *z = divrem1(x, n, &rem);
+    assert(z == NULL || rem == 0);
+    if (z != NULL && Py_SIZE(x) < 0) {
+        _PyLong_Negate(&z);
+    }
+    return z;
+}
+
+/* Store the values of x2*t**2 + x1*t + x0 at t = 1, -1 and -2 in v[0],
+   v[1] and v[2].  Return 0 on success, -1 on failure. */
+static int
+toom3_evaluate(PyLongObject *x0, PyLongObject *x1, PyLongObject *x2,
+               PyLongObject *v[3])
+{
+    PyObject *t, *u;
+
+    v[0] = v[1] = v[2] = NULL;
+    t = long_add(x0, x2);
+    if (t == NULL) {
+        return -1;
+    }
+    v[0] = (PyLongObject *)long_add((PyLongObject *)t, x1);
+    v[1] = (PyLongObject *)long_sub((PyLongObject *)t, x1);
+    Py_DECREF(t);
+    if (v[0] == NULL || v[1] == NULL) {
+        goto error;
+    }
+    /* (v[1] + x2) * 2 - x0 */
+    t = long_add(v[1], x2);
+    if (t == NULL) {
+        goto error;
+    }
+    u = long_add((PyLongObject *)t, (PyLongObject *)t);
+    Py_DECREF(t);
+    if (u == NULL) {
+        goto error;
+    }
+    v[2] = (PyLongObject *)long_sub((PyLongObject *)u, x0);
+    Py_DECREF(u);
+    if (v[2] == NULL) {
+        goto error;
+    }
+    return 0;
+
+  error:
+    Py_CLEAR(v[0]);
+    Py_CLEAR(v[1]);
+    return -1;
+}
+
+static PyLongObject *
+toom3_mul(PyLongObject *a, PyLongObject *b)
+{
+    const Py_ssize_t asize = Py_ABS(Py_SIZE(a));
+    const Py_ssize_t bsize = Py_ABS(Py_SIZE(b));
+    const Py_ssize_t shift = (bsize + 2) / 3;
+    PyLongObject *ah = NULL, *bh = NULL;
+    PyLongObject *a0 = NULL, *a1 = NULL, *a2 = NULL;
+    PyLongObject *b0 = NULL, *b1 = NULL, *b2 = NULL;
+    PyLongObject *va[3] = {NULL, NULL, NULL};
+    PyLongObject *vb[3] = {NULL, NULL, NULL};
+    /* c[0] and c[4] are c(0) and c(infinity); c[1], c[2] and c[3] hold c(1),
+       c(-1) and c(-2) before the interpolation */
+    PyLongObject *c[5] = {NULL, NULL, NULL, NULL, NULL};
+    PyLongObject *ret = NULL;
+    PyObject *t;
+    int i;
+
+    assert(asize <= bsize);
+    assert(asize > 2 * shift);
+
+    /* Split a & b into three pieces of shift digits, except the top ones. */
+    if (kmul_split(a, shift, &ah, &a0) < 0) goto fail;
+    if (kmul_split(ah, shift, &a2, &a1) < 0) goto fail;
+    assert(Py_SIZE(a2) > 0);
+    if (toom3_evaluate(a0, a1, a2, va) < 0) goto fail;
+    if (a == b) {
+        b0 = a0;
+        b1 = a1;
+        b2 = a2;
+        Py_INCREF(b0);
+        Py_INCREF(b1);
+        Py_INCREF(b2);
+        for (i = 0; i < 3; i++) {
+            vb[i] = va[i];
+            Py_INCREF(vb[i]);
+        }
+    }
+    else {
+        if (kmul_split(b, shift, &bh, &b0) < 0) goto fail;
+        if (kmul_split(bh, shift, &b2, &b1) < 0) goto fail;
+        if (toom3_evaluate(b0, b1, b2, vb) < 0) goto fail;
+    }
+
+    /* The 5 recursive multiplications.  When a == b, they're squares, which
+       k_mul() computes faster. */
+    if ((c[0] = k_mul(a0, b0)) == NULL) goto fail;
+    if ((c[4] = k_mul(a2, b2)) == NULL) goto fail;
+    if ((c[1] = k_mul(va[0], vb[0])) == NULL) goto fail;
+    if ((c[2] = toom3_signed_mul(va[1], vb[1])) == NULL) goto fail;
+    if ((c[3] = toom3_signed_mul(va[2], vb[2])) == NULL) goto fail;
+
+    /* Interpolation:
+     *     c3 = (c(-2) - c(1)) / 3
+     *     c1 = (c(1) - c(-1)) / 2
+     *     c2 = c(-1) - c(0)
+     *     c3 = (c2 - c3) / 2 + 2 * c4
+     *     c2 = c2 + c1 - c4
+     *     c1 = c1 - c3
+     */
+    t = long_sub(c[3], c[1]);
+    if (t == NULL) goto fail;
+    Py_SETREF(c[3], toom3_divexact((PyLongObject *)t, 3));
+    Py_DECREF(t);
+    if (c[3] == NULL) goto fail;
+
+    t = long_sub(c[1], c[2]);
+    if (t == NULL) goto fail;
+    Py_SETREF(c[1], toom3_divexact((PyLongObject *)t, 2));
+    Py_DECREF(t);
+    if (c[1] == NULL) goto fail;
+
+    Py_SETREF(c[2], (PyLongObject *)long_sub(c[2], c[0]));
+    if (c[2] == NULL) goto fail;
+
+    t = long_sub(c[2], c[3]);
+    if (t == NULL) goto fail;
+    Py_SETREF(c[3], toom3_divexact((PyLongObject *)t, 2));
+    Py_DECREF(t);
+    if (c[3] == NULL) goto fail;
+    for (i = 0; i < 2; i++) {
+        Py_SETREF(c[3], (PyLongObject *)long_add(c[3], c[4]));
+        if (c[3] == NULL) goto fail;
+    }
+
+    Py_SETREF(c[2], (PyLongObject *)long_add(c[2], c[1]));
+    if (c[2] == NULL) goto fail;
+    Py_SETREF(c[2], (PyLongObject *)long_sub(c[2], c[4]));
+    if (c[2] == NULL) goto fail;
+
+    Py_SETREF(c[1], (PyLongObject *)long_sub(c[1], c[3]));
+    if (c[1] == NULL) goto fail;
+
+    /* Add the coefficients into the result.  They're >= 0, being sums of
+     * products of pieces of a and b, and c[i] * X**i <= a*b, so each one
+     * fits in the digits of the result above i*shift.
+     */
+    ret = _PyLong_New(asize + bsize);
+    if (ret == NULL) goto fail;
+    memset(ret->ob_digit, 0, Py_SIZE(ret) * sizeof(digit));
+    for (i = 0; i < 5; i++) {
+        assert(Py_SIZE(c[i]) >= 0);
+        if (Py_SIZE(c[i]) > 0) {
+            assert(i * shift + Py_SIZE(c[i]) <= Py_SIZE(ret));
+            (void)v_iadd(ret->ob_digit + i * shift,
+                         Py_SIZE(ret) - i * shift,
+                         c[i]->ob_digit, Py_SIZE(c[i]));
+        }
+    }
+    ret = long_normalize(ret);
+
+  fail:
+    Py_XDECREF(ah);
+    Py_XDECREF(a0);
+    Py_XDECREF(a1);
+    Py_XDECREF(a2);
+    Py_XDECREF(bh);
+    Py_XDECREF(b0);
+    Py_XDECREF(b1);
+    Py_XDECREF(b2);
+    for (i = 0; i < 3; i++) {
+        Py_XDECREF(va[i]);
+        Py_XDECREF(vb[i]);
+    }
+    for (i = 0; i < 5; i++) {
+        Py_XDECREF(c[i]);
+    }
+    return ret;
+}
+
+/* Burnikel-Ziegler division, used by long_divrem() when both the divisor
+ * and the quotient have more than BZ_DIV_CUTOFF digits.
+ *
+ * See C. Burnikel and J. Ziegler, "Fast Recursive Division", MPI-I-98-1-022,
+ * 1998.  A division of 2n digits by n digits is done by two divisions of 3
+ * halves by 2 halves, each of which does one recursive division of n digits
+ * by n/2 digits and one multiplication of n/2 digits.  The cost is thus
+ * O(M(n) * log(n)), M(n) being the cost of a multiplication of n digits,
+ * instead of O(n**2).  The divisions work on ints split at digit boundaries,
+ * and the divisor is normalized like in x_divrem().
+ */
+
+/* Return hi * BASE**n + lo, for ints 0 <= hi and 0 <= lo < BASE**n.  lo may
+   be NULL for 0. */
+static PyLongObject *
+bz_join(PyLongObject *hi, PyLongObject *lo, Py_ssize_t n)
+{
+    const Py_ssize_t size_lo = lo == NULL ? 0 : Py_SIZE(lo);
+    PyLongObject *z;
+
+    assert(Py_SIZE(hi) >= 0 && size_lo >= 0 && size_lo <= n);
+    z = _PyLong_New(n + Py_SIZE(hi));
+    if (z == NULL)
+        return NULL;
+    if (size_lo > 0)
+        memcpy(z->ob_digit, lo->ob_digit, size_lo * sizeof(digit));
+    memset(z->ob_digit + size_lo, 0, (n - size_lo) * sizeof(digit));
+    memcpy(z->ob_digit + n, hi->ob_digit, Py_SIZE(hi) * sizeof(digit));
+    return long_normalize(z);
+}
+
+static int bz_div2n1n(PyLongObject *a, PyLongObject *b, Py_ssize_t n,
+                      PyLongObject **pq, PyLongObject **pr);
+
+/* Compute *pq, *pr = divmod(a12 * BASE**n + a3, b), where b = b1 * BASE**n +
+   b2 has 2n digits and is normalized, 0 <= a3 < BASE**n, and
+   a12 * BASE**n + a3 < b * BASE**n.  Return 0 on success, -1 on failure. */
+static int
+bz_div3n2n(PyLongObject *a12, PyLongObject *a3, PyLongObject *b,
+           PyLongObject *b1, PyLongObject *b2, Py_ssize_t n,
+           PyLongObject **pq, PyLongObject **pr)
+{
+    PyLongObject *q = NULL, *r = NULL, *hi, *lo;
+    PyObject *t;
+    int cmp;
+
+    if (kmul_split(a12, n, &hi, &lo) < 0)
+        return -1;
+    Py_DECREF(lo);
+    cmp = long_compare(hi, b1);
+    Py_DECREF(hi);
+    if (cmp == 0) {
+        /* The quotient of a12 by b1 would have n+1 digits: take the
+           largest one of n digits, q = BASE**n - 1, and r = a12 - q*b1. */
+        q = _PyLong_New(n);
+        if (q == NULL)
+            return -1;
+        for (Py_ssize_t i = 0; i < n; i++)
+            q->ob_digit[i] = PyLong_MASK;
+        t = (PyObject *)bz_join(b1, NULL, n);
+        if (t == NULL)
+            goto error;
+        r = (PyLongObject *)long_sub(a12, (PyLongObject *)t);
+        Py_DECREF(t);
+        if (r == NULL)
+            goto error;
+        Py_SETREF(r, (PyLongObject *)long_add(r, b1));
+        if (r == NULL)
+            goto error;
+    }
+    else if (bz_div2n1n(a12, b1, n, &q, &r) < 0) {
+        return -1;
+    }
+
+    /* r = r * BASE**n + a3 - q * b2.  q may be too large by 2 at most, since
+       b is normalized: then r < 0, and is corrected. */
+    Py_SETREF(r, bz_join(r, a3, n));
+    if (r == NULL)
+        goto error;
+    t = (PyObject *)k_mul(q, b2);
+    if (t == NULL)
+        goto error;
+    Py_SETREF(r, (PyLongObject *)long_sub(r, (PyLongObject *)t));
+    Py_DECREF(t);
+    if (r == NULL)
+        goto error;
+    while (Py_SIZE(r) < 0) {
+        Py_SETREF(q, (PyLongObject *)long_sub(q, (PyLongObject *)_PyLong_One));
+        if (q == NULL)
+            goto error;
+        Py_SETREF(r, (PyLongObject *)long_add(r, b));
+        if (r == NULL)
+            goto error;
+    }
+    *pq = q;
+    *pr = r;
+    return 0;
+
+  error:
+    Py_XDECREF(q);
+    Py_XDECREF(r);
+    return -1;
+}
+
+/* Compute *pq, *pr = divmod(a, b), where b has n digits and is normalized,
+   and 0 <= a < b * BASE**n.  Return 0 on success, -1 on failure. */
+static int
+bz_div2n1n(PyLongObject *a, PyLongObject *b, Py_ssize_t n,
+           PyLongObject **pq, PyLongObject **pr)
+{
+    PyLongObject *a12 = NULL, *a3 = NULL, *a4 = NULL, *b1 = NULL, *b2 = NULL;
+    PyLongObject *q1 = NULL, *q2 = NULL, *r = NULL, *t;
+    Py_ssize_t half;
+    int res = -1;
+
+    assert(Py_SIZE(a) >= 0 && Py_SIZE(b) == n);
+    if (n <= BZ_DIV_CUTOFF || Py_SIZE(a) - n <= BZ_DIV_CUTOFF) {
+        /* Small enough for x_divrem() */
+        return long_divrem(a, b, pq, pr);
+    }
+    if (n & 1) {
+        /* Shift a and b by one digit to make n even, and the remainder
+           back.  b stays normalized. */
+        PyLongObject *q, *hi, *lo;
+        if ((a12 = bz_join(a, NULL, 1)) == NULL)
+            return -1;
+        if ((b1 = bz_join(b, NULL, 1)) == NULL)
+            goto done;
+        if (bz_div2n1n(a12, b1, n + 1, &q, &r) < 0)
+            goto done;
+        if (kmul_split(r, 1, &hi, &lo) < 0) {
+            Py_DECREF(q);
+            goto done;
+        }
+        Py_DECREF(lo);
+        *pq = q;
+        *pr = hi;
+        res = 0;
+        goto done;
+    }
+
+    half = n / 2;
+    if (kmul_split(b, half, &b1, &b2) < 0)
+        return -1;
+    if (kmul_split(a, half, &t, &a4) < 0)
+        goto done;
+    if (kmul_split(t, half, &a12, &a3) < 0) {
+        Py_DECREF(t);
+        goto done;
+    }
+    Py_DECREF(t);
+    if (bz_div3n2n(a12, a3, b, b1, b2, half, &q1, &r) < 0)
+        goto done;
+    if (bz_div3n2n(r, a4, b, b1, b2, half, &q2, &t) < 0)
+        goto done;
+    Py_SETREF(r, t);
+    t = bz_join(q1, q2, half);
+    if (t == NULL)
+        goto done;
+    *pq = t;
+    *pr = r;
+    r = NULL;
+    res = 0;
+
+  done:
+    Py_XDECREF(a12);
+    Py_XDECREF(a3);
+    Py_XDECREF(a4);
+    Py_XDECREF(b1);
+    Py_XDECREF(b2);
+    Py_XDECREF(q1);
+    Py_XDECREF(q2);
+    Py_XDECREF(r);
+    return res;
+}
+
+/* Unsigned int division with remainder, like x_divrem().  The dividend is
+   split in pieces of the size of the divisor, which are divided from the
+   top one with bz_div2n1n(). */
+static PyLongObject *
+bz_divrem(PyLongObject *v1, PyLongObject *w1, PyLongObject **prem)
+{
+    PyLongObject *v, *w, *q, *r, *rq, *rr, *piece;
+    Py_ssize_t size_v, size_w, npieces, i;
+    int d;
+    digit carry;
+
+    /* normalize: shift w1 left so that its top digit is >= PyLong_BASE/2,
+       and v1 by the same amount, like x_divrem(). */
+    size_v = Py_ABS(Py_SIZE(v1));
+    size_w = Py_ABS(Py_SIZE(w1));
+    assert(size_v >= size_w && size_w >= 2);
+    *prem = NULL;
+    v = _PyLong_New(size_v + 1);
+    if (v == NULL)
+        return NULL;
+    w = _PyLong_New(size_w);
+    if (w == NULL) {
+        Py_DECREF(v);
+        return NULL;
+    }
+    d = PyLong_SHIFT - bits_in_digit(w1->ob_digit[size_w-1]);
+    carry = v_lshift(w->ob_digit, w1->ob_digit, size_w, d);
+    assert(carry == 0);
+    carry = v_lshift(v->ob_digit, v1->ob_digit, size_v, d);
+    v->ob_digit[size_v] = carry;
+    v = long_normalize(v);
+    size_v = Py_SIZE(v);
+
+    npieces = (size_v + size_w - 1) / size_w;
+    q = _PyLong_New(npieces * size_w);
+    if (q == NULL) {
+        Py_DECREF(v);
+        Py_DECREF(w);
+        return NULL;
+    }
+    memset(q->ob_digit, 0, Py_SIZE(q) * sizeof(digit));
+    r = (PyLongObject *)_PyLong_Zero;
+    Py_INCREF(r);
+    piece = _PyLong_New(size_w);
+    if (piece == NULL)
+        goto error;
+    for (i = npieces - 1; i >= 0; i--) {
+        /* Divide r * BASE**size_w + the i-th piece of v by w: r < w, so the
+           quotient has size_w digits at most. */
+        const Py_ssize_t lo = i * size_w;
+        const Py_ssize_t size = Py_MIN(size_w, size_v - lo);
+        PyLongObject *t;
+        memcpy(piece->ob_digit, v->ob_digit + lo, size * sizeof(digit));
+        Py_SIZE(piece) = size;
+        t = bz_join(r, long_normalize(piece), size_w);
+        if (t == NULL)
+            goto error;
+        Py_SETREF(r, t);
+        if (bz_div2n1n(r, w, size_w, &rq, &rr) < 0)
+            goto error;
+        Py_SETREF(r, rr);
+        assert(Py_SIZE(rq) <= size_w);
+        memcpy(q->ob_digit + lo, rq->ob_digit, Py_SIZE(rq) * sizeof(digit));
+        Py_DECREF(rq);
+    }
+    Py_DECREF(piece);
+    Py_DECREF(v);
+    Py_DECREF(w);
+
+    /* unshift the remainder */
+    *prem = _PyLong_New(Py_SIZE(r));
+    if (*prem == NULL) {
+        Py_DECREF(q);
+        Py_DECREF(r);
+        return NULL;
+    }
+    carry = v_rshift((*prem)->ob_digit, r->ob_digit, Py_SIZE(r), d);
+    assert(carry == 0);
+    Py_DECREF(r);
+    *prem = long_normalize(*prem);
+    return long_normalize(q);
+
+  error:
+    Py_XDECREF(piece);
+    Py_DECREF(v);
+    Py_DECREF(w);
+    Py_DECREF(q);
+    Py_DECREF(r);
+    return NULL;
+}
+
 static PyObject *
 long_mul(PyLongObject *a, PyLongObject *b)
 {
@@ -3709,10 +4426,14 @@ long_mul(PyLongObject *a, PyLongObject *b)
 
     CHECK_BINOP(a, b);
 
-    /* fast path for single-digit multiplication */
-    if (Py_ABS(Py_SIZE(a)) <= 1 && Py_ABS(Py_SIZE(b)) <= 1) {
-        stwodigits v = (stwodigits)(MEDIUM_VALUE(a)) * MEDIUM_VALUE(b);
-        return PyLong_FromLongLong((long long)v);
+    /* fast path for compact values whose product fits in an int64_t */
+    if (IS_COMPACT(a) && IS_COMPACT(b)) {
+        int64_t x = compact_value(a);
+        int64_t y = compact_value(b);
+        if (-COMPACT_MUL_LIMIT < x && x < COMPACT_MUL_LIMIT &&
+            -COMPACT_MUL_LIMIT < y && y < COMPACT_MUL_LIMIT) {
+            return compact_long(x * y);
+        }
     }
 
     z = k_mul(a, b);
@@ -3725,6 +4446,363 @@ long_mul(PyLongObject *a, PyLongObject *b)
     return (PyObject *)z;
 }
 
+/* Divide-and-conquer conversions between ints and decimal strings.
+
+   Like the quadratic algorithms, both conversions go through an array of
+   base _PyLong_DECIMAL_BASE digits.  The array is split in a low part of
+   DECIMAL_DC_LEAF * 2**k digits and a high part, whose values are combined
+   with, or separated by, the power
+
+       P[k] = _PyLong_DECIMAL_BASE ** (DECIMAL_DC_LEAF * 2**k)
+
+   recursively, down to parts of DECIMAL_DC_LEAF digits converted by the
+   quadratic algorithms.  The high part is multiplied by P[k] with k_mul(),
+   and divisions by P[k] multiply by an approximation of its reciprocal
+   computed with Newton's method.  Both conversions thus cost
+   O(M(n) * log(n)) instead of O(n**2), M(n) being the cost of a Karatsuba
+   multiplication of n digits. */
+
+/* Number of base _PyLong_DECIMAL_BASE digits converted by the quadratic
+   algorithms */
+#define DECIMAL_DC_LEAF 64
+
+/* Number of bits of the powers whose reciprocals are computed by an exact
+   division, rather than by Newton's method */
+#define DECIMAL_DC_RECIP_CUTOFF (2 * KARATSUBA_CUTOFF * PyLong_SHIFT)
+
+/* Maximal number of powers: the arrays can't have more than 2**64 digits */
+#define DECIMAL_DC_MAX_POWERS 64
+
+typedef struct {
+    int npowers;
+    /* P[k] = _PyLong_DECIMAL_BASE ** (DECIMAL_DC_LEAF << k) */
+    PyLongObject *pow[DECIMAL_DC_MAX_POWERS];
+    /* Approximation of 2**(2*bits[k]) / P[k] computed by decimal_dc_recip(),
+       or NULL if not computed yet */
+    PyLongObject *recip[DECIMAL_DC_MAX_POWERS];
+    /* Number of bits of P[k] */
+    size_t bits[DECIMAL_DC_MAX_POWERS];
+} decimal_dc_powers;
+
+/* Compute the powers P[k] needed to convert size base _PyLong_DECIMAL_BASE
+   digits: up to the first one with more than size / 2 digits. */
+static int
+decimal_dc_init(decimal_dc_powers *dp, Py_ssize_t size)
+{
+    PyLongObject *p;
+    int i;
+
+    memset(dp, 0, sizeof(*dp));
+    p = (PyLongObject *)PyLong_FromLong(_PyLong_DECIMAL_BASE);
+    if (p == NULL) {
+        return -1;
+    }
+    for (i = 1; i < DECIMAL_DC_LEAF; i *= 2) {
+        Py_SETREF(p, k_mul(p, p));
+        if (p == NULL) {
+            return -1;
+        }
+    }
+    dp->pow[0] = p;
+    dp->npowers = 1;
+    while ((DECIMAL_DC_LEAF << (dp->npowers - 1)) < (size + 1) / 2) {
+        assert(dp->npowers < DECIMAL_DC_MAX_POWERS);
+        p = k_mul(p, p);
+        if (p == NULL) {
+            return -1;
+        }
+        dp->pow[dp->npowers++] = p;
+    }
+    for (i = 0; i < dp->npowers; i++) {
+        dp->bits[i] = _PyLong_NumBits((PyObject *)dp->pow[i]);
+    }
+    return 0;
+}
+
+static void
+decimal_dc_fini(decimal_dc_powers *dp)
+{
+    for (int i = 0; i < dp->npowers; i++) {
+        Py_XDECREF(dp->pow[i]);
+        Py_XDECREF(dp->recip[i]);
+    }
+}
+
+/* Return an approximation of 2**(2*b) / p, b being the number of bits of
+   p > 0, off by a few units at most.  Each step of Newton's method doubles
+   the number of exact bits of the reciprocal of the high half of p. */
+static PyLongObject *
+decimal_dc_recip(PyLongObject *p)
+{
+    size_t b = _PyLong_NumBits((PyObject *)p);
+    size_t h;
+    PyObject *pow2, *ph, *r, *t, *e;
+    int negative;
+
+    if (b == (size_t)-1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    pow2 = _PyLong_Lshift(_PyLong_One, 2 * b);
+    if (pow2 == NULL) {
+        return NULL;
+    }
+    if (b <= DECIMAL_DC_RECIP_CUTOFF) {
+        r = PyNumber_FloorDivide(pow2, (PyObject *)p);
+        Py_DECREF(pow2);
+        return (PyLongObject *)r;
+    }
+
+    /* r = recip(p >> (b - h)) << (b - h) has about h exact bits */
+    h = (b + 1) / 2 + 2;
+    ph = _PyLong_Rshift((PyObject *)p, b - h);
+    if (ph == NULL) {
+        goto error;
+    }
+    t = (PyObject *)decimal_dc_recip((PyLongObject *)ph);
+    Py_DECREF(ph);
+    if (t == NULL) {
+        goto error;
+    }
+    r = _PyLong_Lshift(t, b - h);
+    Py_DECREF(t);
+    if (r == NULL) {
+        goto error;
+    }
+
+    /* r += r * (2**(2*b) - p * r) / 2**(2*b) */
+    t = (PyObject *)k_mul(p, (PyLongObject *)r);
+    if (t == NULL) {
+        goto error_r;
+    }
+    e = long_sub((PyLongObject *)pow2, (PyLongObject *)t);
+    Py_DECREF(t);
+    if (e == NULL) {
+        goto error_r;
+    }
+    negative = Py_SIZE(e) < 0;
+    t = (PyObject *)k_mul((PyLongObject *)r, (PyLongObject *)e);
+    Py_DECREF(e);
+    if (t == NULL) {
+        goto error_r;
+    }
+    Py_SETREF(t, _PyLong_Rshift(t, 2 * b));
+    if (t == NULL) {
+        goto error_r;
+    }
+    if (negative) {
+        Py_SETREF(r, long_sub((PyLongObject *)r, (PyLongObject *)t));
+    }
+    else {
+        Py_SETREF(r, long_add((PyLongObject *)r, (PyLongObject *)t));
+    }
+    Py_DECREF(t);
+    Py_DECREF(pow2);
+    return (PyLongObject *)r;
+
+  error_r:
+    Py_DECREF(r);
+  error:
+    Py_DECREF(pow2);
+    return NULL;
+}
+
+/* Compute *pq, *pr = divmod(n, P[k]), for 0 <= n < P[k]**2, with the
+   approximate reciprocal of P[k]: the estimated quotient is off by a few
+   units at most, and then corrected. */
+static int
+decimal_dc_divmod(decimal_dc_powers *dp, int k, PyLongObject *n,
+                  PyLongObject **pq, PyLongObject **pr)
+{
+    PyLongObject *p = dp->pow[k];
+    size_t b = dp->bits[k];
+    PyObject *q, *r, *t;
+
+    if (dp->recip[k] == NULL) {
+        dp->recip[k] = decimal_dc_recip(p);
+        if (dp->recip[k] == NULL) {
+            return -1;
+        }
+    }
+
+    /* q = (n >> (b - 1)) * recip >> (b + 1) */
+    t = _PyLong_Rshift((PyObject *)n, b - 1);
+    if (t == NULL) {
+        return -1;
+    }
+    Py_SETREF(t, (PyObject *)k_mul((PyLongObject *)t, dp->recip[k]));
+    if (t == NULL) {
+        return -1;
+    }
+    q = _PyLong_Rshift(t, b + 1);
+    Py_DECREF(t);
+    if (q == NULL) {
+        return -1;
+    }
+    t = (PyObject *)k_mul((PyLongObject *)q, p);
+    if (t == NULL) {
+        Py_DECREF(q);
+        return -1;
+    }
+    r = long_sub(n, (PyLongObject *)t);
+    Py_DECREF(t);
+    if (r == NULL) {
+        Py_DECREF(q);
+        return -1;
+    }
+
+    while (Py_SIZE(r) < 0) {
+        Py_SETREF(r, long_add((PyLongObject *)r, p));
+        if (r == NULL) {
+            goto error;
+        }
+        Py_SETREF(q, long_sub((PyLongObject *)q,
+                              (PyLongObject *)_PyLong_One));
+        if (q == NULL) {
+            goto error;
+        }
+    }
+    while (long_compare((PyLongObject *)r, p) >= 0) {
+        Py_SETREF(r, long_sub((PyLongObject *)r, p));
+        if (r == NULL) {
+            goto error;
+        }
+        Py_SETREF(q, long_add((PyLongObject *)q,
+                              (PyLongObject *)_PyLong_One));
+        if (q == NULL) {
+            goto error;
+        }
+    }
+    *pq = (PyLongObject *)q;
+    *pr = (PyLongObject *)r;
+    return 0;
+
+  error:
+    Py_XDECREF(q);
+    Py_XDECREF(r);
+    return -1;
+}
+
+/* Store the base _PyLong_DECIMAL_BASE digits of 0 <= n < P[k+1] in pout,
+   followed by zeros up to width digits, and return their number, or -1 on
+   error.  P[-1] stands for _PyLong_DECIMAL_BASE ** DECIMAL_DC_LEAF. */
+static Py_ssize_t
+decimal_dc_to_decimal(decimal_dc_powers *dp, int k, PyLongObject *n,
+                      digit *pout, Py_ssize_t width)
+{
+    Py_ssize_t size;
+
+    if (k < 0) {
+        size = digits_to_decimal_base(n->ob_digit, Py_SIZE(n), pout);
+        if (size < 0) {
+            return -1;
+        }
+    }
+    else if (long_compare(n, dp->pow[k]) < 0) {
+        size = decimal_dc_to_decimal(dp, k - 1, n, pout, -1);
+        if (size < 0) {
+            return -1;
+        }
+    }
+    else {
+        PyLongObject *q, *r;
+        Py_ssize_t low = (Py_ssize_t)DECIMAL_DC_LEAF << k;
+
+        if (decimal_dc_divmod(dp, k, n, &q, &r) < 0) {
+            return -1;
+        }
+        size = decimal_dc_to_decimal(dp, k - 1, r, pout, low);
+        Py_DECREF(r);
+        if (size >= 0) {
+            size = decimal_dc_to_decimal(dp, k - 1, q, pout + low, -1);
+        }
+        Py_DECREF(q);
+        if (size < 0) {
+            return -1;
+        }
+        size += low;
+    }
+    while (size < width) {
+        pout[size++] = 0;
+    }
+    return size;
+}
+
+/* Store the base _PyLong_DECIMAL_BASE digits of |a| in pout, which must be
+   large enough, and return their number, or -1 on error. */
+static Py_ssize_t
+long_to_decimal_base_dc(PyLongObject *a, digit *pout, Py_ssize_t size)
+{
+    decimal_dc_powers dp;
+    PyLongObject *n;
+    Py_ssize_t res = -1;
+
+    if (decimal_dc_init(&dp, size) < 0) {
+        goto done;
+    }
+    n = (PyLongObject *)_PyLong_Copy(a);
+    if (n == NULL) {
+        goto done;
+    }
+    Py_SIZE(n) = Py_ABS(Py_SIZE(n));
+    res = decimal_dc_to_decimal(&dp, dp.npowers - 1, n, pout, -1);
+    Py_DECREF(n);
+  done:
+    decimal_dc_fini(&dp);
+    return res;
+}
+
+/* Return the value of the size base _PyLong_DECIMAL_BASE digits of pin,
+   for size <= DECIMAL_DC_LEAF << (k + 1). */
+static PyLongObject *
+decimal_dc_from_decimal(decimal_dc_powers *dp, int k,
+                        const digit *pin, Py_ssize_t size)
+{
+    PyLongObject *low, *high, *t;
+    PyObject *res;
+    Py_ssize_t nlow;
+
+    while (k >= 0 && size <= ((Py_ssize_t)DECIMAL_DC_LEAF << k)) {
+        k--;
+    }
+    if (k < 0) {
+        return decimal_base_to_long(pin, size);
+    }
+    nlow = (Py_ssize_t)DECIMAL_DC_LEAF << k;
+    low = decimal_dc_from_decimal(dp, k - 1, pin, nlow);
+    if (low == NULL) {
+        return NULL;
+    }
+    high = decimal_dc_from_decimal(dp, k - 1, pin + nlow, size - nlow);
+    if (high == NULL) {
+        Py_DECREF(low);
+        return NULL;
+    }
+    t = k_mul(high, dp->pow[k]);
+    Py_DECREF(high);
+    if (t == NULL) {
+        Py_DECREF(low);
+        return NULL;
+    }
+    res = long_add(t, low);
+    Py_DECREF(t);
+    Py_DECREF(low);
+    return (PyLongObject *)res;
+}
+
+/* Return the value of the size base _PyLong_DECIMAL_BASE digits of pin. */
+static PyLongObject *
+long_from_decimal_base_dc(const digit *pin, Py_ssize_t size)
+{
+    decimal_dc_powers dp;
+    PyLongObject *res = NULL;
+
+    if (decimal_dc_init(&dp, size) == 0) {
+        res = decimal_dc_from_decimal(&dp, dp.npowers - 1, pin, size);
+    }
+    decimal_dc_fini(&dp);
+    return res;
+}
+
 /* Fast modulo division for single-digit longs. */
 static PyObject *
 fast_mod(PyLongObject *a, PyLongObject *b)
@@ -4861,6 +5939,23 @@ long_or(PyObject *a, PyObject *b)
     return c;
 }
 
+static void
+long_dealloc(PyObject *self)
+{
+    /* Exact ints of at most LONG_FREELIST_DIGITS digits have room for that
+       many digits: see _PyLong_New() */
+    if (PyLong_CheckExact(self) &&
+        Py_ABS(Py_SIZE(self)) <= LONG_FREELIST_DIGITS &&
+        numfree < PyLong_MAXFREELIST) {
+        numfree++;
+        Py_TYPE(self) = (struct _typeobject *)free_list;
+        free_list = (PyLongObject *)self;
+    }
+    else {
+        Py_TYPE(self)->tp_free(self);
+    }
+}
+
 static PyObject *
 long_long(PyObject *v)
 {
@@ -5727,7 +6822,7 @@ PyTypeObject PyLong_Type = {
     "int",                                      /* tp_name */
     offsetof(PyLongObject, ob_digit),           /* tp_basicsize */
     sizeof(digit),                              /* tp_itemsize */
-    0,                                          /* tp_dealloc */
+    long_dealloc,                               /* tp_dealloc */
     0,                                          /* tp_vectorcall_offset */
     0,                                          /* tp_getattr */
     0,                                          /* tp_setattr */
@@ -5854,6 +6949,31 @@ _PyLong_Init(void)
     return 1;
 }
 
+int
+PyLong_ClearFreeList(void)
+{
+    PyLongObject *v = free_list, *next;
+    int i = numfree;
+    while (v) {
+        next = (PyLongObject *) Py_TYPE(v);
+        PyObject_FREE(v);
+        v = next;
+    }
+    free_list = NULL;
+    numfree = 0;
+    return i;
+}
+
+/* Print summary info about the state of the optimized allocator */
+void
+_PyLong_DebugMallocStats(FILE *out)
+{
+    _PyDebugAllocatorStats(out,
+                           "free PyLongObject",
+                           numfree, offsetof(PyLongObject, ob_digit) +
+                                    LONG_FREELIST_DIGITS*sizeof(digit));
+}
+
 void
 PyLong_Fini(void)
 {
@@ -5862,6 +6982,7 @@ PyLong_Fini(void)
        reinitializations will fail. */
     Py_CLEAR(_PyLong_One);
     Py_CLEAR(_PyLong_Zero);
+    (void)PyLong_ClearFreeList();
 #if NSMALLNEGINTS + NSMALLPOSINTS > 0
     int i;
     PyLongObject *v = small_ints;
@@ -1963,6 +1963,7 @@ _PyObject_DebugTypeStats(FILE *out)
     _PyFloat_DebugMallocStats(out);
     _PyFrame_DebugMallocStats(out);
     _PyList_DebugMallocStats(out);
+    _PyLong_DebugMallocStats(out);
     _PyTuple_DebugMallocStats(out);
 }
 
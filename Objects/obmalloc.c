@@ -161,6 +161,55 @@ _PyObject_ArenaMunmap(void *ctx, void *ptr, size_t size)
     munmap(ptr, size);
 }
 
+/* Huge page size on x86-64 (and the usual one on other architectures) */
+#define HUGE_PAGE_SIZE (2 << 20)
+
+/* Number of arenas backed by reserved huge pages (MAP_HUGETLB) and by
+   transparent huge pages (MADV_HUGEPAGE) */
+static size_t narenas_hugetlb = 0;
+static size_t narenas_thp = 0;
+
+/* Arena allocator used when huge pages are requested (see
+   _PyObject_SetArenaConfig()).  size is a multiple of HUGE_PAGE_SIZE. */
+static void *
+_PyObject_ArenaMmapHuge(void *ctx, size_t size)
+{
+    void *ptr;
+    assert(size % HUGE_PAGE_SIZE == 0);
+
+#ifdef MAP_HUGETLB
+    /* Only succeeds if the administrator reserved huge pages */
+    ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
+               MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        narenas_hugetlb++;
+        return ptr;
+    }
+#endif
+
+    /* Map a huge page aligned area, so that the kernel can back it with
+       transparent huge pages: over-allocate and unmap the excess. */
+    size_t mapped = size + HUGE_PAGE_SIZE;
+    ptr = mmap(NULL, mapped, PROT_READ|PROT_WRITE,
+               MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        return NULL;
+    uint8_t *start = _Py_ALIGN_UP(ptr, HUGE_PAGE_SIZE);
+    uint8_t *end = (uint8_t *)ptr + mapped;
+    if (start != (uint8_t *)ptr) {
+        munmap(ptr, start - (uint8_t *)ptr);
+    }
+    if (start + size != end) {
+        munmap(start + size, end - (start + size));
+    }
+#ifdef MADV_HUGEPAGE
+    if (madvise(start, size, MADV_HUGEPAGE) == 0) {
+        narenas_thp++;
+    }
+#endif
+    return start;
+}
+
 #else
 static void *
 _PyObject_ArenaMalloc(void *ctx, size_t size)
@@ -909,6 +958,15 @@ static int running_on_valgrind = -1;
  */
 #define ARENA_SIZE              (256 << 10)     /* 256KB */
 
+/*
+ * The arena size can be changed at startup by _PyObject_SetArenaConfig()
+ * (PYTHONMALLOCARENASIZE, -X pymalloc_arena_size): it must be a power of 2
+ * between MIN_ARENA_SIZE and MAX_ARENA_SIZE.  Larger arenas mean fewer
+ * mmap() calls and, with huge pages, fewer TLB misses.
+ */
+#define MIN_ARENA_SIZE          (64 << 10)      /* 64KB */
+#define MAX_ARENA_SIZE          (16 << 20)      /* 16MB */
+
 #ifdef WITH_MEMORY_LIMITS
 #define MAX_ARENAS              (SMALL_MEMORY_LIMIT / ARENA_SIZE)
 #endif
@@ -920,10 +978,13 @@ static int running_on_valgrind = -1;
 #define POOL_SIZE               SYSTEM_PAGE_SIZE        /* must be 2^N */
 #define POOL_SIZE_MASK          SYSTEM_PAGE_SIZE_MASK
 
-#define MAX_POOLS_IN_ARENA  (ARENA_SIZE / POOL_SIZE)
-#if MAX_POOLS_IN_ARENA * POOL_SIZE != ARENA_SIZE
+#define MAX_POOLS_IN_ARENA  (MAX_ARENA_SIZE / POOL_SIZE)
+#if (ARENA_SIZE / POOL_SIZE) * POOL_SIZE != ARENA_SIZE
 #   error "arena size not an exact multiple of pool size"
 #endif
+#if MIN_ARENA_SIZE % POOL_SIZE != 0
+#   error "minimum arena size not an exact multiple of pool size"
+#endif
 
 /*
  * -- End of tunable settings section --
@@ -958,6 +1019,11 @@ struct arena_object {
      */
     uintptr_t address;
 
+    /* The size of the arena in bytes: the value of arena_size when the arena
+     * was allocated.
+     */
+    size_t size;
+
     /* Pool-aligned pointer to the next pool to be carved off. */
     block* pool_address;
 
@@ -972,6 +1038,14 @@ struct arena_object {
     /* Singly-linked list of available pools. */
     struct pool_header* freepools;
 
+    /* Available pools whose memory was given back to the OS by
+     * _PyObject_TrimMemory().  Their header is lost with the rest of their
+     * memory, so they can't be linked through it:  this is an array of
+     * nreleased pools, allocated by PyMem_RawMalloc().
+     */
+    struct pool_header** released;
+    uint nreleased;
+
     /* Whenever this arena_object is not associated with an allocated
      * arena, the nextarena member is used to link all unassociated
      * arena_objects in the singly-linked `unused_arena_objects` list.
@@ -1194,6 +1268,11 @@ static struct arena_object* usable_arenas = NULL;
 /* nfp2lasta[nfp] is the last arena in usable_arenas with nfp free pools */
 static struct arena_object* nfp2lasta[MAX_POOLS_IN_ARENA + 1] = { NULL };
 
+/* Size of the arenas allocated from now on, see _PyObject_SetArenaConfig().
+ * Arenas allocated before keep their size.
+ */
+static size_t arena_size = ARENA_SIZE;
+
 /* How many arena_objects do we initially allocate?
  * 16 = can allocate 16 arenas = 16 * ARENA_SIZE = 4MB before growing the
  * `arenas` vector.
@@ -1210,10 +1289,62 @@ static size_t narenas_highwater = 0;
 
 static Py_ssize_t raw_allocated_blocks;
 
+/*==========================================================================
+Block cache.
+
+In front of usedpools, every size class has a small LIFO stack of free
+blocks.  pymalloc_free() pushes the block on the stack of its size class and
+pymalloc_alloc() pops from it, so a program which frees and allocates objects
+of the same size in a loop (the common case) doesn't write to the pool
+headers at all, and the block handed out is the one most recently freed
+(hence most likely still in the CPU cache).
+
+When the stack of a size class is empty, the block is taken from usedpools;
+when it is full, the block is given back to its pool.  Refilling or flushing
+the stack in batches was tried, but it made bursts of allocations (building
+a large list) or of deallocations (destroying it) slower: each block is then
+moved twice.
+
+For their pools, the cached blocks are still allocated: they keep their pool
+(and so their arena) alive.  The stacks are kept small to bound the memory
+held this way.
+
+Like the rest of pymalloc, the cache relies on the GIL.  Since the GIL
+serializes all the threads (and all the interpreters) anyway, a single cache
+is shared by everyone: a per-thread cache would only add a thread-local
+lookup to each allocation.
+*/
+
+#define BLOCK_CACHE_SIZE        16      /* max blocks cached per size class */
+
+struct block_cache {
+    uint count;                         /* number of cached blocks       */
+    block *blocks[BLOCK_CACHE_SIZE];    /* blocks[count-1] is the top    */
+};
+
+static struct block_cache blockcache[NB_SMALL_SIZE_CLASSES];
+
+/* Number of allocations which found the cache empty, and of deallocations
+ * which found it full. */
+static size_t nblockcache_misses = 0;
+static size_t nblockcache_overflows = 0;
+
+/* Number of blocks in the cache of all size classes */
+static size_t
+blockcache_total(void)
+{
+    size_t n = 0;
+    for (uint i = 0; i < NB_SMALL_SIZE_CLASSES; i++) {
+        n += blockcache[i].count;
+    }
+    return n;
+}
+
 Py_ssize_t
 _Py_GetAllocatedBlocks(void)
 {
-    Py_ssize_t n = raw_allocated_blocks;
+    /* cached blocks are counted as allocated by their pools */
+    Py_ssize_t n = raw_allocated_blocks - (Py_ssize_t)blockcache_total();
     /* add up allocated blocks for used pools */
     for (uint i = 0; i < maxarenas; ++i) {
         /* Skip arenas which are not allocated. */
@@ -1234,6 +1365,39 @@ _Py_GetAllocatedBlocks(void)
 }
 
 
+int
+_PyObject_SetArenaConfig(size_t size, int hugepages)
+{
+#ifdef ARENAS_USE_MMAP
+    if (hugepages) {
+        if (size == 0 || size < HUGE_PAGE_SIZE) {
+            size = HUGE_PAGE_SIZE;
+        }
+    }
+#endif
+    if (size == 0) {
+        size = ARENA_SIZE;
+    }
+    if (size < MIN_ARENA_SIZE || size > MAX_ARENA_SIZE
+        || (size & (size - 1)) != 0)
+    {
+        return -1;
+    }
+    arena_size = size;
+
+#ifdef ARENAS_USE_MMAP
+    /* Don't override an arena allocator set by PyObject_SetArenaAllocator() */
+    if (hugepages && _PyObject_Arena.alloc == _PyObject_ArenaMmap) {
+        _PyObject_Arena.alloc = _PyObject_ArenaMmapHuge;
+    }
+    else if (!hugepages && _PyObject_Arena.alloc == _PyObject_ArenaMmapHuge) {
+        _PyObject_Arena.alloc = _PyObject_ArenaMmap;
+    }
+#endif
+    return 0;
+}
+
+
 /* Allocate a new arena.  If we run out of memory, return NULL.  Else
  * allocate a new arena, and return the address of an arena_object
  * describing the new arena.  It's expected that the caller will set
@@ -1301,7 +1465,7 @@ new_arena(void)
     arenaobj = unused_arena_objects;
     unused_arena_objects = arenaobj->nextarena;
     assert(arenaobj->address == 0);
-    address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
+    address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, arena_size);
     if (address == NULL) {
         /* The allocation failed: return NULL after putting the
          * arenaobj back.
@@ -1311,16 +1475,19 @@ new_arena(void)
         return NULL;
     }
     arenaobj->address = (uintptr_t)address;
+    arenaobj->size = arena_size;
 
     ++narenas_currently_allocated;
     ++ntimes_arena_allocated;
     if (narenas_currently_allocated > narenas_highwater)
         narenas_highwater = narenas_currently_allocated;
     arenaobj->freepools = NULL;
+    arenaobj->released = NULL;
+    arenaobj->nreleased = 0;
     /* pool_address <- first pool-aligned address in the arena
        nfreepools <- number of whole pools that fit after alignment */
     arenaobj->pool_address = (block*)arenaobj->address;
-    arenaobj->nfreepools = MAX_POOLS_IN_ARENA;
+    arenaobj->nfreepools = (uint)(arena_size / POOL_SIZE);
     excess = (uint)(arenaobj->address & POOL_SIZE_MASK);
     if (excess != 0) {
         --arenaobj->nfreepools;
@@ -1345,7 +1512,11 @@ called on every alloc/realloc/free, micro-efficiency is important here).
 Tricky:  Let B be the arena base address associated with the pool, B =
 arenas[(POOL)->arenaindex].address.  Then P belongs to the arena if and only if
 
-    B <= P < B + ARENA_SIZE
+    B <= P < B + S
+
+where S = arenas[(POOL)->arenaindex].size is the size of the arena (ARENA_SIZE
+unless _PyObject_SetArenaConfig() changed it).  In the rest of this comment,
+ARENA_SIZE stands for S.
 
 Subtracting B throughout, this is true iff
 
@@ -1419,7 +1590,7 @@ address_in_range(void *p, poolp pool)
     // only once.
     uint arenaindex = *((volatile uint *)&pool->arenaindex);
     return arenaindex < maxarenas &&
-        (uintptr_t)p - arenas[arenaindex].address < ARENA_SIZE &&
+        (uintptr_t)p - arenas[arenaindex].address < arenas[arenaindex].size &&
         arenas[arenaindex].address != 0;
 }
 
@@ -1509,27 +1680,36 @@ allocate_from_new_pool(uint size)
         }
         else {
             /* nfreepools > 0:  it must be that freepools
-             * isn't NULL, or that we haven't yet carved
-             * off all the arena's pools for the first
-             * time.
+             * isn't NULL, that some pools were released, or
+             * that we haven't yet carved off all the arena's
+             * pools for the first time.
              */
             assert(usable_arenas->freepools != NULL ||
+                   usable_arenas->nreleased != 0 ||
                    usable_arenas->pool_address <=
                    (block*)usable_arenas->address +
-                       ARENA_SIZE - POOL_SIZE);
+                       usable_arenas->size - POOL_SIZE);
         }
     }
     else {
-        /* Carve off a new pool. */
         assert(usable_arenas->nfreepools > 0);
         assert(usable_arenas->freepools == NULL);
-        pool = (poolp)usable_arenas->pool_address;
-        assert((block*)pool <= (block*)usable_arenas->address +
-                                 ARENA_SIZE - POOL_SIZE);
+        if (usable_arenas->nreleased != 0) {
+            /* Reuse a released pool:  its header has to be
+             * initialized again, as if it was carved off.
+             */
+            pool = usable_arenas->released[--usable_arenas->nreleased];
+        }
+        else {
+            /* Carve off a new pool. */
+            pool = (poolp)usable_arenas->pool_address;
+            assert((block*)pool <= (block*)usable_arenas->address +
+                                     usable_arenas->size - POOL_SIZE);
+            usable_arenas->pool_address += POOL_SIZE;
+        }
         pool->arenaindex = (uint)(usable_arenas - arenas);
         assert(&arenas[pool->arenaindex] == usable_arenas);
         pool->szidx = DUMMY_SIZE_IDX;
-        usable_arenas->pool_address += POOL_SIZE;
         --usable_arenas->nfreepools;
 
         if (usable_arenas->nfreepools == 0) {
@@ -1578,6 +1758,36 @@ allocate_from_new_pool(uint size)
     return bp;
 }
 
+/* Allocate a block of size class `size` from usedpools, bypassing the block
+   cache.  Return NULL on error. */
+static inline block *
+pymalloc_pool_alloc(uint size)
+{
+    poolp pool = usedpools[size + size];
+    block *bp;
+
+    if (LIKELY(pool != pool->nextpool)) {
+        /*
+         * There is a used pool for this size class.
+         * Pick up the head block of its free list.
+         */
+        ++pool->ref.count;
+        bp = pool->freeblock;
+
+        if (UNLIKELY((pool->freeblock = *(block **)bp) == NULL)) {
+            // Reached the end of the free list, try to extend it.
+            pymalloc_pool_extend(pool, size);
+        }
+    }
+    else {
+        /* There isn't a pool of the right size class immediately
+         * available:  use a free pool.
+         */
+        bp = allocate_from_new_pool(size);
+    }
+    return bp;
+}
+
 /* pymalloc allocator
 
    Return 1 if pymalloc allocated memory and wrote the pointer into *ptr_p.
@@ -1606,27 +1816,15 @@ pymalloc_alloc(void *ctx, void **ptr_p, size_t nbytes)
     }
 
     uint size = (uint)(nbytes - 1) >> ALIGNMENT_SHIFT;
-    poolp pool = usedpools[size + size];
+    struct block_cache *cache = &blockcache[size];
     block *bp;
-    
-    if (LIKELY(pool != pool->nextpool)) {
-        /*
-         * There is a used pool for this size class.
-         * Pick up the head block of its free list.
-         */
-        ++pool->ref.count;
-        bp = pool->freeblock;
 
-        if (UNLIKELY((pool->freeblock = *(block **)bp) == NULL)) {
-            // Reached the end of the free list, try to extend it.
-            pymalloc_pool_extend(pool, size);
-        }
+    if (LIKELY(cache->count != 0)) {
+        bp = cache->blocks[--cache->count];
     }
     else {
-        /* There isn't a pool of the right size class immediately
-         * available:  use a free pool.
-         */
-        bp = allocate_from_new_pool(size);
+        nblockcache_misses++;
+        bp = pymalloc_pool_alloc(size);
         if (UNLIKELY(bp == NULL)) {
             return 0;
         }
@@ -1775,8 +1973,11 @@ insert_to_freepool(poolp pool)
 
         /* Free the entire arena. */
         _PyObject_Arena.free(_PyObject_Arena.ctx,
-                             (void *)ao->address, ARENA_SIZE);
+                             (void *)ao->address, ao->size);
         ao->address = 0;                        /* mark unassociated */
+        PyMem_RawFree(ao->released);
+        ao->released = NULL;
+        ao->nreleased = 0;
         --narenas_currently_allocated;
 
         return;
@@ -1853,26 +2054,10 @@ insert_to_freepool(poolp pool)
            || ao->prevarena->nextarena == ao);
 }
 
-/* Free a memory block allocated by pymalloc_alloc().
-   Return 1 if it was freed.
-   Return 0 if the block was not allocated by pymalloc_alloc(). */
-static inline int
-pymalloc_free(void *ctx, void *p)
+/* Give the block p back to its pool, bypassing the block cache. */
+static inline void
+pymalloc_pool_free(poolp pool, block *p)
 {
-    assert(p != NULL);
-
-#ifdef WITH_VALGRIND
-    if (UNLIKELY(running_on_valgrind > 0)) {
-        return 0;
-    }
-#endif
-
-    poolp pool = POOL_ADDR(p);
-    if (UNLIKELY(!address_in_range(p, pool))) {
-        return 0;
-    }
-    /* We allocated this address. */
-
     /* Link p to the start of the pool's freeblock list.  Since
      * the pool had at least the p block outstanding, the pool
      * wasn't empty (so it's already in a usedpools[] list, or
@@ -1882,7 +2067,7 @@ pymalloc_free(void *ctx, void *p)
     assert(pool->ref.count > 0);            /* else it was empty */
     block *lastfree = pool->freeblock;
     *(block **)p = lastfree;
-    pool->freeblock = (block *)p;
+    pool->freeblock = p;
     pool->ref.count--;
 
     if (UNLIKELY(lastfree == NULL)) {
@@ -1893,7 +2078,7 @@ pymalloc_free(void *ctx, void *p)
          * blocks of the same size class.
          */
         insert_to_usedpool(pool);
-        return 1;
+        return;
     }
 
     /* freeblock wasn't NULL, so the pool wasn't full,
@@ -1901,7 +2086,7 @@ pymalloc_free(void *ctx, void *p)
      */
     if (LIKELY(pool->ref.count != 0)) {
         /* pool isn't empty:  leave it in usedpools */
-        return 1;
+        return;
     }
 
     /* Pool is now empty:  unlink from usedpools, and
@@ -1910,6 +2095,36 @@ pymalloc_free(void *ctx, void *p)
      * (being not referenced, they are perhaps paged out).
      */
     insert_to_freepool(pool);
+}
+
+/* Free a memory block allocated by pymalloc_alloc().
+   Return 1 if it was freed.
+   Return 0 if the block was not allocated by pymalloc_alloc(). */
+static inline int
+pymalloc_free(void *ctx, void *p)
+{
+    assert(p != NULL);
+
+#ifdef WITH_VALGRIND
+    if (UNLIKELY(running_on_valgrind > 0)) {
+        return 0;
+    }
+#endif
+
+    poolp pool = POOL_ADDR(p);
+    if (UNLIKELY(!address_in_range(p, pool))) {
+        return 0;
+    }
+    /* We allocated this address. */
+    assert(pool->ref.count > 0);            /* else it was empty */
+
+    struct block_cache *cache = &blockcache[pool->szidx];
+    if (UNLIKELY(cache->count == BLOCK_CACHE_SIZE)) {
+        nblockcache_overflows++;
+        pymalloc_pool_free(pool, (block *)p);
+        return 1;
+    }
+    cache->blocks[cache->count++] = (block *)p;
     return 1;
 }
 
@@ -1930,6 +2145,113 @@ _PyObject_Free(void *ctx, void *p)
 }
 
 
+/* Give the blocks of the block cache back to their pools. */
+static void
+blockcache_flush(void)
+{
+    for (uint i = 0; i < NB_SMALL_SIZE_CLASSES; i++) {
+        struct block_cache *cache = &blockcache[i];
+        while (cache->count != 0) {
+            block *p = cache->blocks[--cache->count];
+            pymalloc_pool_free(POOL_ADDR(p), p);
+        }
+    }
+}
+
+#if defined(ARENAS_USE_MMAP) && defined(MADV_DONTNEED) && defined(__linux__)
+   /* The pages are freed at once */
+#  define POOL_RELEASE_ADVICE MADV_DONTNEED
+#elif defined(ARENAS_USE_MMAP) && defined(MADV_FREE)
+   /* MADV_DONTNEED is only a hint on BSD and macOS: the pages are freed
+      when the OS needs memory */
+#  define POOL_RELEASE_ADVICE MADV_FREE
+#endif
+
+#ifdef POOL_RELEASE_ADVICE
+static int
+pool_address_cmp(const void *a, const void *b)
+{
+    uintptr_t x = (uintptr_t)*(const poolp *)a;
+    uintptr_t y = (uintptr_t)*(const poolp *)b;
+    return (x > y) - (x < y);
+}
+
+/* Give the memory of the free pools of the arena back to the OS.
+   Return the number of released pools. */
+static uint
+arena_release_pools(struct arena_object *ao)
+{
+    uint nfree = 0;
+    for (poolp pool = ao->freepools; pool != NULL; pool = pool->nextpool) {
+        nfree++;
+    }
+    if (nfree == 0) {
+        return 0;
+    }
+
+    poolp *released = PyMem_RawRealloc(ao->released,
+                                       (ao->nreleased + nfree) * sizeof(poolp));
+    if (released == NULL) {
+        return 0;
+    }
+    ao->released = released;
+    released += ao->nreleased;
+
+    /* Move the pools from freepools to released.  The pool headers must be
+     * read before the memory is released.  Since free pools have a reference
+     * count of 0 and released memory reads as zeros (or keeps its content
+     * with MADV_FREE), code walking over all the pools of the arena still
+     * sees released pools as unused.
+     */
+    uint i = 0;
+    for (poolp pool = ao->freepools; pool != NULL; pool = pool->nextpool) {
+        assert(pool->ref.count == 0);
+        released[i++] = pool;
+    }
+    ao->freepools = NULL;
+    ao->nreleased += nfree;
+
+    /* Sort the pools to release adjacent pools in a single call */
+    qsort(released, nfree, sizeof(poolp), pool_address_cmp);
+    i = 0;
+    while (i < nfree) {
+        uint j = i + 1;
+        while (j < nfree
+               && (block *)released[j] == (block *)released[j - 1] + POOL_SIZE) {
+            j++;
+        }
+        (void)madvise(released[i], (j - i) * POOL_SIZE, POOL_RELEASE_ADVICE);
+        i = j;
+    }
+    return nfree;
+}
+#endif
+
+size_t
+_PyObject_TrimMemory(void)
+{
+    size_t nreleased = 0;
+
+    /* Cached blocks keep their pool in use */
+    blockcache_flush();
+
+#ifdef POOL_RELEASE_ADVICE
+    /* Only release arenas allocated by the default arena allocator: memory
+       from another allocator may not be mmap()ed, and huge pages can't be
+       released page by page. */
+    if (_PyObject_Arena.alloc != _PyObject_ArenaMmap) {
+        return 0;
+    }
+    for (struct arena_object *ao = usable_arenas; ao != NULL;
+         ao = ao->nextarena)
+    {
+        nreleased += arena_release_pools(ao);
+    }
+#endif
+    return nreleased * POOL_SIZE;
+}
+
+
 /* pymalloc realloc.
 
    If nbytes==0, then as the Python docs promise, we do not treat this like
@@ -2028,6 +2350,13 @@ _Py_GetAllocatedBlocks(void)
     return 0;
 }
 
+int
+_PyObject_SetArenaConfig(size_t size, int hugepages)
+{
+    /* no arenas */
+    return 0;
+}
+
 #endif /* WITH_PYMALLOC */
 
 
@@ -2608,6 +2937,17 @@ pool_is_in_list(const poolp target, poolp list)
     } while (list != NULL && list != origlist);
     return 0;
 }
+
+/* Is target one of the pools released by the arena? */
+static int
+pool_is_released(const poolp target, const struct arena_object *ao)
+{
+    for (uint i = 0; i < ao->nreleased; i++) {
+        if (ao->released[i] == target)
+            return 1;
+    }
+    return 0;
+}
 #endif
 
 /* Print summary info to "out" about the state of pymalloc's structures.
@@ -2632,10 +2972,14 @@ _PyObject_DebugMallocStats(FILE *out)
     size_t numfreeblocks[SMALL_REQUEST_THRESHOLD >> ALIGNMENT_SHIFT];
     /* total # of allocated bytes in used and full pools */
     size_t allocated_bytes = 0;
+    /* total # of bytes in the block cache */
+    size_t cached_bytes = 0;
     /* total # of available bytes in used pools */
     size_t available_bytes = 0;
     /* # of free pools + pools not yet carved out of current arena */
     uint numfreepools = 0;
+    /* # of free pools whose memory was given back to the OS */
+    uint numreleasedpools = 0;
     /* # of bytes for arena alignment padding */
     size_t arena_alignment = 0;
     /* # of bytes in used and full pools used for pool_headers */
@@ -2647,7 +2991,9 @@ _PyObject_DebugMallocStats(FILE *out)
     size_t quantization = 0;
     /* # of arenas actually allocated. */
     size_t narenas = 0;
-    /* running total -- should equal narenas * ARENA_SIZE */
+    /* # of bytes in allocated arenas */
+    size_t arena_bytes = 0;
+    /* running total -- should equal arena_bytes */
     size_t total;
     char buf[128];
 
@@ -2669,8 +3015,10 @@ _PyObject_DebugMallocStats(FILE *out)
         if (arenas[i].address == (uintptr_t)NULL)
             continue;
         narenas += 1;
+        arena_bytes += arenas[i].size;
 
         numfreepools += arenas[i].nfreepools;
+        numreleasedpools += arenas[i].nreleased;
 
         /* round up to pool alignment */
         if (base & (uintptr_t)POOL_SIZE_MASK) {
@@ -2690,7 +3038,8 @@ _PyObject_DebugMallocStats(FILE *out)
             if (p->ref.count == 0) {
                 /* currently unused */
 #ifdef Py_DEBUG
-                assert(pool_is_in_list(p, arenas[i].freepools));
+                assert(pool_is_in_list(p, arenas[i].freepools)
+                       || pool_is_released(p, &arenas[i]));
 #endif
                 continue;
             }
@@ -2707,25 +3056,31 @@ _PyObject_DebugMallocStats(FILE *out)
     assert(narenas == narenas_currently_allocated);
 
     fputc('\n', out);
-    fputs("class   size   num pools   blocks in use  avail blocks\n"
-          "-----   ----   ---------   -------------  ------------\n",
+    fputs("class   size   num pools   blocks in use  avail blocks  cached blocks\n"
+          "-----   ----   ---------   -------------  ------------  -------------\n",
           out);
 
     for (i = 0; i < numclasses; ++i) {
         size_t p = numpools[i];
         size_t b = numblocks[i];
         size_t f = numfreeblocks[i];
+        size_t c = blockcache[i].count;
         uint size = INDEX2SIZE(i);
         if (p == 0) {
-            assert(b == 0 && f == 0);
+            assert(b == 0 && f == 0 && c == 0);
             continue;
         }
+        /* the pools count the cached blocks as allocated */
+        assert(b >= c);
+        b -= c;
         fprintf(out, "%5u %6u "
                         "%11" PY_FORMAT_SIZE_T "u "
                         "%15" PY_FORMAT_SIZE_T "u "
-                        "%13" PY_FORMAT_SIZE_T "u\n",
-                i, size, p, b, f);
+                        "%13" PY_FORMAT_SIZE_T "u "
+                        "%14" PY_FORMAT_SIZE_T "u\n",
+                i, size, p, b, f, c);
         allocated_bytes += b * size;
+        cached_bytes += c * size;
         available_bytes += f * size;
         pool_header_bytes += p * POOL_OVERHEAD;
         quantization += p * ((POOL_SIZE - POOL_OVERHEAD) % size);
@@ -2742,18 +3097,37 @@ _PyObject_DebugMallocStats(FILE *out)
     (void)printone(out, "# arenas allocated current", narenas);
 
     PyOS_snprintf(buf, sizeof(buf),
-        "%" PY_FORMAT_SIZE_T "u arenas * %d bytes/arena",
-        narenas, ARENA_SIZE);
-    (void)printone(out, buf, narenas * ARENA_SIZE);
+        "%" PY_FORMAT_SIZE_T "u arenas, %" PY_FORMAT_SIZE_T "u bytes/arena",
+        narenas, arena_size);
+    (void)printone(out, buf, arena_bytes);
+#ifdef ARENAS_USE_MMAP
+    if (_PyObject_Arena.alloc == _PyObject_ArenaMmapHuge
+        || narenas_hugetlb || narenas_thp)
+    {
+        (void)printone(out, "# arenas mapped with MAP_HUGETLB",
+                       narenas_hugetlb);
+        (void)printone(out, "# arenas advised MADV_HUGEPAGE",
+                       narenas_thp);
+    }
+#endif
+
+    fputc('\n', out);
+
+    (void)printone(out, "# block cache misses", nblockcache_misses);
+    (void)printone(out, "# block cache overflows", nblockcache_overflows);
 
     fputc('\n', out);
 
     total = printone(out, "# bytes in allocated blocks", allocated_bytes);
     total += printone(out, "# bytes in available blocks", available_bytes);
+    total += printone(out, "# bytes in cached blocks", cached_bytes);
 
     PyOS_snprintf(buf, sizeof(buf),
         "%u unused pools * %d bytes", numfreepools, POOL_SIZE);
     total += printone(out, buf, (size_t)numfreepools * POOL_SIZE);
+    PyOS_snprintf(buf, sizeof(buf),
+        "  (%u released to the OS)", numreleasedpools);
+    (void)printone(out, buf, (size_t)numreleasedpools * POOL_SIZE);
 
     total += printone(out, "# bytes lost to pool headers", pool_header_bytes);
     total += printone(out, "# bytes lost to quantization", quantization);
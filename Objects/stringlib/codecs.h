@@ -250,6 +250,125 @@ InvalidContinuation3:
     goto Return;
 }
 
+#if defined(HAVE_AVX2_DISPATCH) && STRINGLIB_MAX_CHAR > 0x7F
+/* Decode UTF-8 data which is already known to be well-formed, and whose
+   characters all fit in STRINGLIB_CHAR, for utf8_decode_avx2().  Since
+   nothing can go wrong, no check is done: runs of ASCII characters are
+   widened 16 at a time, blocks made of 1 and 2 byte sequences are decoded
+   16 bytes at a time, and other sequences one by one from their length.
+   Return the number of characters written to dest. */
+__attribute__((target("avx2")))
+static Py_ssize_t
+STRINGLIB(utf8_decode_valid)(const char *start, const char *end,
+                             STRINGLIB_CHAR *dest)
+{
+    const unsigned char *s = (const unsigned char *)start;
+    const unsigned char *e = (const unsigned char *)end;
+    STRINGLIB_CHAR *p = dest;
+    const __m128i zero = _mm_setzero_si128();
+
+    while (s < e) {
+        /* The 2 byte blocks store 8 characters at a time even if fewer are
+           decoded: keep 32 bytes of input, hence at least 8 characters of
+           output, after the block. */
+        while (e - s >= 16 + 32) {
+            __m128i v = _mm_loadu_si128((const __m128i *)s);
+            int nonascii = _mm_movemask_epi8(v);
+            if (nonascii == 0) {
+#if STRINGLIB_SIZEOF_CHAR == 1
+                _mm_storeu_si128((__m128i *)p, v);
+#else
+                __m128i lo = _mm_unpacklo_epi8(v, zero);
+                __m128i hi = _mm_unpackhi_epi8(v, zero);
+# if STRINGLIB_SIZEOF_CHAR == 2
+                _mm_storeu_si128((__m128i *)p, lo);
+                _mm_storeu_si128((__m128i *)(p + 8), hi);
+# else
+                _mm_storeu_si128((__m128i *)p, _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128((__m128i *)(p + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128((__m128i *)(p + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128((__m128i *)(p + 12), _mm_unpackhi_epi16(hi, zero));
+# endif
+#endif
+                s += 16;
+                p += 16;
+                continue;
+            }
+            /* Lead bytes of 3 and 4 byte sequences */
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_subs_epu8(v, _mm_set1_epi8((char)0xDF)), zero)) != 0xFFFF)
+                break;
+
+            /* Decode a character at each byte, as if it was a lead byte,
+               and only keep the ones which are not at continuation bytes.
+               A sequence starting at the last byte is left for the next
+               block. */
+            int n = s[15] >= 0xC0 ? 15 : 16;
+            int cont = _mm_movemask_epi8(
+                _mm_cmplt_epi8(v, _mm_set1_epi8(-64)));
+            int starts = ~cont & ((1 << n) - 1);
+            __m128i next = _mm_srli_si128(v, 1);
+            __m128i chars[2];
+            for (int i = 0; i < 2; i++) {
+                __m128i ch = i ? _mm_unpackhi_epi8(v, zero)
+                               : _mm_unpacklo_epi8(v, zero);
+                __m128i ch2 = i ? _mm_unpackhi_epi8(next, zero)
+                                : _mm_unpacklo_epi8(next, zero);
+                __m128i two = _mm_or_si128(
+                    _mm_slli_epi16(_mm_and_si128(ch, _mm_set1_epi16(0x1F)), 6),
+                    _mm_and_si128(ch2, _mm_set1_epi16(0x3F)));
+                __m128i lead = _mm_cmpgt_epi16(ch, _mm_set1_epi16(0xBF));
+                ch = _mm_or_si128(_mm_and_si128(lead, two),
+                                  _mm_andnot_si128(lead, ch));
+                int mask = (starts >> (8 * i)) & 0xFF;
+                chars[i] = _mm_shuffle_epi8(
+                    ch, _mm_loadu_si128(
+                        (const __m128i *)utf8_compact_shuffle[mask]));
+#if STRINGLIB_SIZEOF_CHAR == 1
+                _mm_storel_epi64((__m128i *)p,
+                                 _mm_packus_epi16(chars[i], chars[i]));
+#elif STRINGLIB_SIZEOF_CHAR == 2
+                _mm_storeu_si128((__m128i *)p, chars[i]);
+#else
+                _mm_storeu_si128((__m128i *)p,
+                                 _mm_unpacklo_epi16(chars[i], zero));
+                _mm_storeu_si128((__m128i *)(p + 4),
+                                 _mm_unpackhi_epi16(chars[i], zero));
+#endif
+                p += __builtin_popcount(mask);
+            }
+            s += n;
+        }
+
+        /* Decode the sequences of the next 16 bytes one by one */
+        const unsigned char *stop = e - s > 16 ? s + 16 : e;
+        while (s < stop) {
+            Py_UCS4 ch = *s;
+            if (ch < 0x80) {
+                *p++ = (STRINGLIB_CHAR)ch;
+                s++;
+            }
+            else if (ch < 0xE0) {
+                *p++ = (STRINGLIB_CHAR)(((ch & 0x1F) << 6) | (s[1] & 0x3F));
+                s += 2;
+            }
+            else if (ch < 0xF0) {
+                *p++ = (STRINGLIB_CHAR)(((ch & 0x0F) << 12) |
+                                        ((s[1] & 0x3F) << 6) | (s[2] & 0x3F));
+                s += 3;
+            }
+            else {
+                *p++ = (STRINGLIB_CHAR)(((ch & 0x07) << 18) |
+                                        ((s[1] & 0x3F) << 12) |
+                                        ((s[2] & 0x3F) << 6) | (s[3] & 0x3F));
+                s += 4;
+            }
+        }
+    }
+    return p - dest;
+}
+#endif /* HAVE_AVX2_DISPATCH */
+
 #undef ASCII_CHAR_MASK
 
 
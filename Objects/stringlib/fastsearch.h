@@ -27,6 +27,41 @@
 #error "LONG_BIT is smaller than 32"
 #endif
 
+/* Horspool and the SIMD filter below switch to the two-way algorithm once
+   they have compared more than this many characters on top of one per
+   position: their worst case is quadratic, two-way is linear. */
+#define STRINGLIB_TWO_WAY_BUDGET 1024
+
+/* Longer needles are searched with Horspool, whose skips beat the SIMD
+   filter on most texts */
+#define STRINGLIB_SIMD_MAX_NEEDLE 64
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#  include <emmintrin.h>
+#  define STRINGLIB_HAVE_SSE2
+#endif
+
+#ifndef STRINGLIB_FASTSEARCH_CTZ
+#define STRINGLIB_FASTSEARCH_CTZ
+#ifdef STRINGLIB_HAVE_SSE2
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+/* Index of the least significant set bit of x, which is not 0 */
+Py_LOCAL_INLINE(int)
+stringlib_ctz(unsigned int x)
+{
+#  ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return (int)i;
+#  else
+    return __builtin_ctz(x);
+#  endif
+}
+#endif
+#endif
+
 #define STRINGLIB_BLOOM_ADD(mask, ch) \
     ((mask |= (1UL << ((ch) & (STRINGLIB_BLOOM_WIDTH -1)))))
 #define STRINGLIB_BLOOM(mask, ch)     \
@@ -160,6 +195,222 @@ STRINGLIB(rfind_char)(const STRINGLIB_CHAR* s, Py_ssize_t n, STRINGLIB_CHAR ch)
 
 #undef MEMCHR_CUT_OFF
 
+/* Compute a critical factorization of p, for STRINGLIB(_two_way).  Return
+   the start of the right half, and set *period to its period. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_factorize)(const STRINGLIB_CHAR *p, Py_ssize_t m,
+                      Py_ssize_t *period)
+{
+    Py_ssize_t ms[2], per[2];
+
+    /* The maximal suffixes for the two orderings of the alphabet: the
+       one which starts later gives a critical factorization */
+    for (int inverted = 0; inverted < 2; inverted++) {
+        Py_ssize_t suffix = -1, j = 0, k = 1, q = 1;
+        while (j + k < m) {
+            STRINGLIB_CHAR a = p[j + k];
+            STRINGLIB_CHAR b = p[suffix + k];
+            if (inverted ? b < a : a < b) {
+                /* The suffix is smaller, the period is the whole prefix */
+                j += k;
+                k = 1;
+                q = j - suffix;
+            }
+            else if (a == b) {
+                /* Go through the repetitions of the current period */
+                if (k != q) {
+                    k++;
+                }
+                else {
+                    j += q;
+                    k = 1;
+                }
+            }
+            else {
+                /* The suffix is larger, start again from here */
+                suffix = j;
+                j++;
+                k = q = 1;
+            }
+        }
+        ms[inverted] = suffix;
+        per[inverted] = q;
+    }
+    int i = ms[1] >= ms[0];
+    *period = per[i];
+    return ms[i] + 1;
+}
+
+/* Two-way string matching (Crochemore and Perrin, "Two-way string-matching",
+   1991), which runs in linear time with constant extra space.  p is split
+   in two halves at a critical factorization: the right half is compared
+   left to right, then the left half right to left, and the shifts on a
+   mismatch are such that no character of s is compared more than twice.
+   Like in glibc, a Horspool-like table on the low byte of the last
+   character of the window first skips the windows which cannot match.
+
+   count is the number of matches already found by the caller, which
+   switched to this function at s; the return value is like FASTSEARCH's. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_two_way)(const STRINGLIB_CHAR *s, Py_ssize_t n,
+                    const STRINGLIB_CHAR *p, Py_ssize_t m,
+                    Py_ssize_t maxcount, int mode, Py_ssize_t count)
+{
+    Py_ssize_t period, suffix, i, j, memory = 0, shift;
+    Py_ssize_t skip_table[256];
+    int periodic;
+
+    suffix = STRINGLIB(_factorize)(p, m, &period);
+    /* If the left half is repeated at the period, the whole needle is
+       periodic and the shift on a mismatch after the right half is only
+       the period: remember the matched prefix to not compare it again. */
+    periodic = (suffix + period <= m &&
+                memcmp(p, p + period,
+                       suffix * sizeof(STRINGLIB_CHAR)) == 0);
+    if (!periodic) {
+        period = Py_MAX(suffix, m - suffix) + 1;
+    }
+
+    for (i = 0; i < 256; i++) {
+        skip_table[i] = m;
+    }
+    for (i = 0; i < m - 1; i++) {
+        skip_table[p[i] & 0xFF] = m - 1 - i;
+    }
+    skip_table[p[m - 1] & 0xFF] = 0;
+
+    j = 0;
+    while (j <= n - m) {
+        shift = skip_table[s[j + m - 1] & 0xFF];
+        if (shift > 0) {
+            /* The last character does not match */
+            if (memory && shift < period) {
+                shift = m - period;
+            }
+            memory = 0;
+            j += shift;
+            continue;
+        }
+        /* Right half */
+        i = Py_MAX(suffix, memory);
+        while (i < m && p[i] == s[i + j]) {
+            i++;
+        }
+        if (i < m) {
+            j += i - suffix + 1;
+            memory = 0;
+            continue;
+        }
+        /* Left half */
+        i = suffix - 1;
+        while (i >= memory && p[i] == s[i + j]) {
+            i--;
+        }
+        if (i < memory) {
+            /* got a match! */
+            if (mode != FAST_COUNT) {
+                return j;
+            }
+            count++;
+            if (count == maxcount) {
+                return maxcount;
+            }
+            j += m;
+            memory = 0;
+            continue;
+        }
+        j += period;
+        if (periodic) {
+            memory = m - period;
+        }
+    }
+    if (mode != FAST_COUNT) {
+        return -1;
+    }
+    return count;
+}
+
+#if defined(STRINGLIB_HAVE_SSE2) && STRINGLIB_SIZEOF_CHAR <= 2
+/* Forward search for needles of at least 2 characters, with the filter of
+   Wojciech Mula's "SIMD-friendly algorithms for substring searching": the
+   positions of a block where both the first and the last characters of p
+   match are found with two vector compares, and only those are compared
+   with the rest of p. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_simd_find)(const STRINGLIB_CHAR *s, Py_ssize_t n,
+                      const STRINGLIB_CHAR *p, Py_ssize_t m,
+                      Py_ssize_t maxcount, int mode)
+{
+    /* Number of characters in a vector */
+    const Py_ssize_t lanes = 16 / STRINGLIB_SIZEOF_CHAR;
+    const Py_ssize_t w = n - m;
+    const Py_ssize_t mlast = m - 1;
+    Py_ssize_t i = 0, count = 0, cost = 0, next;
+#if STRINGLIB_SIZEOF_CHAR == 1
+    const __m128i first = _mm_set1_epi8((char)p[0]);
+    const __m128i last = _mm_set1_epi8((char)p[mlast]);
+#else
+    const __m128i first = _mm_set1_epi16((short)p[0]);
+    const __m128i last = _mm_set1_epi16((short)p[mlast]);
+#endif
+
+    while (i + lanes - 1 <= w) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + i + mlast));
+#if STRINGLIB_SIZEOF_CHAR == 1
+        unsigned int bits = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+#else
+        /* 2 bits per character: keep the first one */
+        unsigned int bits = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi16(a, first),
+                          _mm_cmpeq_epi16(b, last))) & 0x5555;
+#endif
+        next = i + lanes;
+        while (bits) {
+            Py_ssize_t k = i + stringlib_ctz(bits) / STRINGLIB_SIZEOF_CHAR;
+            bits &= bits - 1;
+            cost += m;
+            if (memcmp(s + k + 1, p + 1,
+                       (m - 2) * sizeof(STRINGLIB_CHAR)) == 0) {
+                /* got a match! */
+                if (mode != FAST_COUNT)
+                    return k;
+                count++;
+                if (count == maxcount)
+                    return maxcount;
+                /* Matches do not overlap */
+                next = k + m;
+                break;
+            }
+        }
+        i = next;
+        if (cost > i + STRINGLIB_TWO_WAY_BUDGET) {
+            Py_ssize_t res = STRINGLIB(_two_way)(s + i, n - i, p, m,
+                                                 maxcount, mode, count);
+            if (mode != FAST_COUNT && res >= 0)
+                res += i;
+            return res;
+        }
+    }
+    /* Positions left after the last full block */
+    for (; i <= w; i++) {
+        if (s[i] == p[0] && s[i + mlast] == p[mlast] &&
+            memcmp(s + i + 1, p + 1, (m - 2) * sizeof(STRINGLIB_CHAR)) == 0) {
+            if (mode != FAST_COUNT)
+                return i;
+            count++;
+            if (count == maxcount)
+                return maxcount;
+            i += mlast;
+        }
+    }
+    if (mode != FAST_COUNT)
+        return -1;
+    return count;
+}
+#endif
+
 Py_LOCAL_INLINE(Py_ssize_t)
 FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
            const STRINGLIB_CHAR* p, Py_ssize_t m,
@@ -194,6 +445,11 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
         }
     }
 
+#if defined(STRINGLIB_HAVE_SSE2) && STRINGLIB_SIZEOF_CHAR <= 2
+    if (mode != FAST_RSEARCH && m <= STRINGLIB_SIMD_MAX_NEEDLE)
+        return STRINGLIB(_simd_find)(s, n, p, m, maxcount, mode);
+#endif
+
     mlast = m - 1;
     skip = mlast - 1;
     mask = 0;
@@ -201,6 +457,7 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
     if (mode != FAST_RSEARCH) {
         const STRINGLIB_CHAR *ss = s + m - 1;
         const STRINGLIB_CHAR *pp = p + m - 1;
+        Py_ssize_t cost = 0;
 
         /* create compressed boyer-moore delta 1 table */
 
@@ -230,6 +487,16 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
                     i = i + mlast;
                     continue;
                 }
+                cost += j;
+                if (cost > i + STRINGLIB_TWO_WAY_BUDGET) {
+                    /* too many partial matches: go on in linear time */
+                    i++;
+                    j = STRINGLIB(_two_way)(s + i, n - i, p, m,
+                                            maxcount, mode, count);
+                    if (mode != FAST_COUNT && j >= 0)
+                        j += i;
+                    return j;
+                }
                 /* miss: check if next character is part of pattern */
                 if (!STRINGLIB_BLOOM(mask, ss[i+1]))
                     i = i + m;
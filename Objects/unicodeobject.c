@@ -53,6 +53,13 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <windows.h>
 #endif
 
+/* AVX2 code is compiled with the target attribute, and only used if the
+   CPU supports it */
+#if defined(__x86_64__) && (defined(__clang__) || __GNUC__ >= 5)
+#  include <immintrin.h>
+#  define HAVE_AVX2_DISPATCH
+#endif
+
 /* Uncomment to display statistics on interned strings at exit when
    using Valgrind or Insecure++. */
 /* #define INTERNED_STATS 1 */
@@ -4846,6 +4853,12 @@ PyUnicode_DecodeUTF8(const char *s,
     return PyUnicode_DecodeUTF8Stateful(s, size, errors, NULL);
 }
 
+#ifdef HAVE_AVX2_DISPATCH
+/* pshufb masks moving the 16-bit lanes selected by an 8-bit mask to the
+   start of a vector, for STRINGLIB(utf8_decode_valid) */
+static unsigned char utf8_compact_shuffle[256][16];
+#endif
+
 #include "stringlib/asciilib.h"
 #include "stringlib/codecs.h"
 #include "stringlib/undef.h"
@@ -4936,6 +4949,287 @@ ascii_decode(const char *start, const char *end, Py_UCS1 *dest)
     return p - start;
 }
 
+#ifdef HAVE_AVX2_DISPATCH
+/* Inputs shorter than this are left to the scalar decoder */
+#define UTF8_AVX2_MIN_SIZE 64
+
+/* Error classes of a pair of consecutive bytes, for utf8_check_avx2() */
+#define UTF8_TOO_SHORT      (1 << 0)    /* 11______ 0_______ */
+                                        /* 11______ 11______ */
+#define UTF8_TOO_LONG       (1 << 1)    /* 0_______ 10______ */
+#define UTF8_OVERLONG_3     (1 << 2)    /* 11100000 100_____ */
+#define UTF8_TOO_LARGE      (1 << 3)    /* 11110100 1001____ and above */
+#define UTF8_SURROGATE      (1 << 4)    /* 11101101 101_____ */
+#define UTF8_OVERLONG_2     (1 << 5)    /* 1100000_ 10______ */
+#define UTF8_TOO_LARGE_1000 (1 << 6)    /* 11110101 1000____ and above */
+#define UTF8_OVERLONG_4     (1 << 6)    /* 11110000 1000____ */
+#define UTF8_TWO_CONTS      (1 << 7)    /* 10______ 10______ */
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static int utf8_avx2_supported = -1;
+
+/* Return the 32 bytes ending n bytes before the end of input, taking the
+   first ones from the end of prev. */
+#define UTF8_PREV_BYTES(input, prev, n) \
+    _mm256_alignr_epi8((input), \
+                       _mm256_permute2x128_si256((prev), (input), 0x21), \
+                       16 - (n))
+
+/* Check that [start, end) is well-formed UTF-8, 32 bytes at a time, with the
+   lookup algorithm of John Keiser and Daniel Lemire ("Validating UTF-8 In
+   Less Than One Instruction Per Byte", 2021).  Looking up the nibbles of
+   each byte and of the byte before it in three tables flags every error
+   which shows in two consecutive bytes, the only remaining ones are the
+   missing or extra continuation bytes of 3 and 4 byte sequences, which are
+   found by looking at the bytes 2 and 3 positions before.
+
+   On success, return 1 and set *nchars to the number of decoded characters
+   and *maxbyte to the largest byte, which tells the kind of the result.
+   Return 0 on error without telling where: the caller runs the scalar
+   decoder to report it. */
+__attribute__((target("avx2")))
+static int
+utf8_check_avx2(const char *start, const char *end,
+                Py_ssize_t *nchars, unsigned char *maxbyte)
+{
+#define TABLE16(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+    const __m256i byte_1_high = TABLE16(
+        /* 0_______ ________ */
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+        /* 10______ ________ */
+        UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+        /* 1100____ ________ */
+        UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+        /* 1101____ ________ */
+        UTF8_TOO_SHORT,
+        /* 1110____ ________ */
+        UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+        /* 1111____ ________ */
+        UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+        | UTF8_OVERLONG_4);
+    const __m256i byte_1_low = TABLE16(
+        /* ____0000 ________ */
+        UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+        /* ____0001 ________ */
+        UTF8_CARRY | UTF8_OVERLONG_2,
+        /* ____001_ ________ */
+        UTF8_CARRY,
+        UTF8_CARRY,
+        /* ____0100 ________ */
+        UTF8_CARRY | UTF8_TOO_LARGE,
+        /* ____0101 ________ to ____1100 ________ */
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        /* ____1101 ________ */
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+        /* ____111_ ________ */
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+        UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000);
+    const __m256i byte_2_high = TABLE16(
+        /* ________ 0_______ */
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+        /* ________ 1000____ */
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3
+        | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+        /* ________ 1001____ */
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3
+        | UTF8_TOO_LARGE,
+        /* ________ 101_____ */
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE
+        | UTF8_TOO_LARGE,
+        UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE
+        | UTF8_TOO_LARGE,
+        /* ________ 11______ */
+        UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT);
+#undef TABLE16
+    /* A lead byte in the last 3 positions of a block which is too large
+       for the number of bytes left in the block */
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i error = zero;
+    __m256i prev_input = zero;
+    __m256i prev_incomplete = zero;
+    __m256i max = zero;
+    Py_ssize_t ncont = 0;
+    const char *p = start;
+
+    while (p < end) {
+        __m256i input;
+        if (end - p >= 32) {
+            input = _mm256_loadu_si256((const __m256i *)p);
+        }
+        else {
+            /* Pad the last block with ASCII zeros */
+            char tail[32];
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, p, end - p);
+            input = _mm256_loadu_si256((const __m256i *)tail);
+        }
+        p += 32;
+
+        if (_mm256_movemask_epi8(input) == 0) {
+            /* ASCII block: only check the end of the previous block */
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = zero;
+        }
+        else {
+            __m256i prev1 = UTF8_PREV_BYTES(input, prev_input, 1);
+            __m256i prev1_high = _mm256_and_si256(
+                _mm256_srli_epi16(prev1, 4), nibble_mask);
+            __m256i prev1_low = _mm256_and_si256(prev1, nibble_mask);
+            __m256i input_high = _mm256_and_si256(
+                _mm256_srli_epi16(input, 4), nibble_mask);
+            __m256i special = _mm256_and_si256(
+                _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, prev1_high),
+                                 _mm256_shuffle_epi8(byte_1_low, prev1_low)),
+                _mm256_shuffle_epi8(byte_2_high, input_high));
+
+            /* Bytes which follow a 3 or 4 byte lead by 2 or 3 positions
+               must be continuation bytes, the lookups flagged them as
+               UTF8_TWO_CONTS: these flags must match exactly. */
+            __m256i prev2 = UTF8_PREV_BYTES(input, prev_input, 2);
+            __m256i prev3 = UTF8_PREV_BYTES(input, prev_input, 3);
+            __m256i must23 = _mm256_or_si256(
+                _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80)));
+            must23 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+            max = _mm256_max_epu8(max, input);
+            /* Continuation bytes are the ones below -64 as signed chars */
+            ncont += __builtin_popcount((unsigned int)_mm256_movemask_epi8(
+                _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), input)));
+        }
+        prev_input = input;
+        if (!_mm256_testz_si256(error, error)) {
+            return 0;
+        }
+    }
+    if (!_mm256_testz_si256(prev_incomplete, prev_incomplete)) {
+        return 0;
+    }
+
+    unsigned char bytes[32];
+    _mm256_storeu_si256((__m256i *)bytes, max);
+    unsigned char m = 0;
+    for (int i = 0; i < 32; i++) {
+        m = Py_MAX(m, bytes[i]);
+    }
+    *nchars = (end - start) - ncont;
+    *maxbyte = m;
+    return 1;
+}
+
+#undef UTF8_PREV_BYTES
+#undef UTF8_TOO_SHORT
+#undef UTF8_TOO_LONG
+#undef UTF8_OVERLONG_3
+#undef UTF8_TOO_LARGE
+#undef UTF8_SURROGATE
+#undef UTF8_OVERLONG_2
+#undef UTF8_TOO_LARGE_1000
+#undef UTF8_OVERLONG_4
+#undef UTF8_TWO_CONTS
+#undef UTF8_CARRY
+
+/* Decode [s, end) with utf8_check_avx2() and the utf8_decode_valid()
+   functions, s being the first non-ASCII byte after the ASCII characters
+   already decoded from starts.  On success, replace *pu with the decoded
+   string and return the end of the decoded data, which is end unless the
+   stateful decoder (consumed != NULL) must leave an incomplete sequence
+   for later.  In this case *pu has room for the remaining bytes to be
+   decoded by the scalar decoder.  Return s if the data is not valid
+   UTF-8 or if AVX2 is not available, and NULL on memory error. */
+static const char *
+utf8_decode_avx2(const char *starts, const char *s, const char *end,
+                 Py_ssize_t *consumed, PyObject **pu, Py_ssize_t *outpos)
+{
+    if (end - s < UTF8_AVX2_MIN_SIZE) {
+        return s;
+    }
+    if (utf8_avx2_supported < 0) {
+        for (int mask = 0; mask < 256; mask++) {
+            int j = 0;
+            for (int i = 0; i < 8; i++) {
+                if (mask & (1 << i)) {
+                    utf8_compact_shuffle[mask][j++] = 2 * i;
+                    utf8_compact_shuffle[mask][j++] = 2 * i + 1;
+                }
+            }
+            while (j < 16) {
+                utf8_compact_shuffle[mask][j++] = 0x80;
+            }
+        }
+        utf8_avx2_supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    if (!utf8_avx2_supported) {
+        return s;
+    }
+
+    const char *valid_end = end;
+    if (consumed) {
+        /* Find the lead byte of the last sequence, and leave it for the
+           next call if the sequence is incomplete */
+        for (Py_ssize_t i = 1; i <= 3; i++) {
+            unsigned char ch = (unsigned char)end[-i];
+            if (ch < 0x80) {
+                break;
+            }
+            if (ch >= 0xC0) {
+                if (i < (ch >= 0xF0 ? 4 : ch >= 0xE0 ? 3 : 2)) {
+                    valid_end = end - i;
+                }
+                break;
+            }
+        }
+    }
+
+    Py_ssize_t nchars;
+    unsigned char maxbyte;
+    if (!utf8_check_avx2(s, valid_end, &nchars, &maxbyte)) {
+        return s;
+    }
+
+    Py_ssize_t pos = s - starts;
+    Py_UCS4 maxchar = maxbyte >= 0xF0 ? MAX_UNICODE :
+                      maxbyte >= 0xC4 ? 0xFFFF : 0xFF;
+    PyObject *v = PyUnicode_New(pos + nchars + (end - valid_end), maxchar);
+    if (v == NULL) {
+        return NULL;
+    }
+    void *data = PyUnicode_DATA(v);
+    Py_ssize_t len;
+    switch (PyUnicode_KIND(v)) {
+    case PyUnicode_1BYTE_KIND:
+        len = ucs1lib_utf8_decode_valid(starts, valid_end, data);
+        break;
+    case PyUnicode_2BYTE_KIND:
+        len = ucs2lib_utf8_decode_valid(starts, valid_end, data);
+        break;
+    default:
+        len = ucs4lib_utf8_decode_valid(starts, valid_end, data);
+        break;
+    }
+    assert(len == pos + nchars);
+    Py_SETREF(*pu, v);
+    *outpos = len;
+    return valid_end;
+}
+#endif /* HAVE_AVX2_DISPATCH */
+
 static PyObject *
 unicode_decode_utf8(const char *s, Py_ssize_t size,
                     _Py_error_handler error_handler, const char *errors,
@@ -4967,10 +5261,25 @@ unicode_decode_utf8(const char *s, Py_ssize_t size,
         return u;
     }
 
+    Py_ssize_t pos = s - starts;
+#ifdef HAVE_AVX2_DISPATCH
+    // Vectorized path for valid UTF-8, the writer below handles errors.
+    s = utf8_decode_avx2(starts, s, end, consumed, &u, &pos);
+    if (s == NULL) {
+        Py_DECREF(u);
+        return NULL;
+    }
+    if (s == end) {
+        if (consumed)
+            *consumed = size;
+        return u;
+    }
+#endif
+
     // Use _PyUnicodeWriter after fast path is failed.
     _PyUnicodeWriter writer;
     _PyUnicodeWriter_InitWithBuffer(&writer, u);
-    writer.pos = s - starts;
+    writer.pos = pos;
 
     Py_ssize_t startinpos, endinpos;
     const char *errmsg = "";
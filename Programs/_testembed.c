@@ -512,6 +512,9 @@ static int test_init_from_config(void)
     putenv("PYTHONMALLOCSTATS=0");
     config.malloc_stats = 1;
 
+    putenv("PYTHONMALLOCARENASIZE=512K");
+    config.pymalloc_arena_size = 1024 * 1024;
+
     putenv("PYTHONPYCACHEPREFIX=env_pycache_prefix");
     config_set_string(&config, &config.pycache_prefix, L"conf_pycache_prefix");
 
@@ -661,6 +664,8 @@ static void set_most_env_vars(void)
     putenv("PYTHONTRACEMALLOC=2");
     putenv("PYTHONPROFILEIMPORTTIME=1");
     putenv("PYTHONMALLOCSTATS=1");
+    putenv("PYTHONMALLOCARENASIZE=512K");
+    putenv("PYTHONMALLOCHUGEPAGES=1");
     putenv("PYTHONUTF8=1");
     putenv("PYTHONVERBOSE=1");
     putenv("PYTHONINSPECT=1");
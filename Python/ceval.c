@@ -21,6 +21,7 @@
 #include "code.h"
 #include "dictobject.h"
 #include "frameobject.h"
+#include "longintrepr.h"
 #include "opcode.h"
 #include "pydtrace.h"
 #include "setobject.h"
@@ -116,8 +117,167 @@ static size_t opcache_code_objects_extra_mem = 0;
 static size_t opcache_global_opts = 0;
 static size_t opcache_global_hits = 0;
 static size_t opcache_global_misses = 0;
+
+static size_t opcache_load_attr_opts = 0;
+static size_t opcache_load_attr_hits = 0;
+static size_t opcache_load_attr_misses = 0;
+static size_t opcache_load_attr_deopts = 0;
+
+static size_t opcache_store_attr_opts = 0;
+static size_t opcache_store_attr_hits = 0;
+static size_t opcache_store_attr_misses = 0;
+static size_t opcache_store_attr_deopts = 0;
+
+static size_t opcache_load_method_opts = 0;
+static size_t opcache_load_method_hits = 0;
+static size_t opcache_load_method_misses = 0;
+static size_t opcache_load_method_deopts = 0;
+
+static size_t opcache_specialize_success = 0;
+static size_t opcache_specialize_failure = 0;
+static size_t opcache_specialize_deopts = 0;
 #endif
 
+/* Helpers of the specialized instructions: value of an int made of at
+   most one digit, and result of a rich comparison of two C values */
+#define IS_MEDIUM_INT(x) (((size_t)Py_SIZE(x)) + 1U < 3U)
+#define MEDIUM_INT_VALUE(x) \
+    (Py_SIZE(x) == 0 ? (sdigit)0 : \
+     (sdigit)Py_SIZE(x) * (sdigit)((PyLongObject *)(x))->ob_digit[0])
+
+#define RICHCOMPARE_VALUES(a, b, op) \
+    ((op) == Py_LT ? (a) < (b) : \
+     (op) == Py_LE ? (a) <= (b) : \
+     (op) == Py_EQ ? (a) == (b) : \
+     (op) == Py_NE ? (a) != (b) : \
+     (op) == Py_GT ? (a) > (b) : \
+     (a) >= (b))
+
+/* Result of the rich comparison of two exact str objects: 1 if it is true,
+   0 if it is false, or -1 with an exception set on failure */
+static inline int
+unicode_richcompare_fast(PyObject *left, PyObject *right, int op)
+{
+    int cmp;
+    if (PyUnicode_READY(left) == -1 || PyUnicode_READY(right) == -1) {
+        return -1;
+    }
+    if (op == Py_EQ || op == Py_NE) {
+        /* 0 if the strings are equal */
+        cmp = !_PyUnicode_EQ(left, right);
+    }
+    else {
+        cmp = PyUnicode_Compare(left, right);
+        if (cmp == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+    }
+    return RICHCOMPARE_VALUES(cmp, 0, op);
+}
+
+/* Number of misses after which the cache of an attribute instruction
+   (LOAD_ATTR, STORE_ATTR, LOAD_METHOD) is disabled */
+#define OPCACHE_ATTR_MAX_TRIES 20
+
+/* Fill the cache of a LOAD_ATTR, STORE_ATTR or LOAD_METHOD instruction
+   after a successful generic access to the attribute name of owner.
+
+   The cache is keyed on the type of owner and is only valid while the
+   version tag of the type doesn't change.  Return 1 if the access can be
+   cached, 0 otherwise. */
+static int
+opcache_init_attr(_PyOpcache *co_opcache, int opcode,
+                  PyObject *owner, PyObject *name)
+{
+    _PyOpcache_LoadAttr *la = &co_opcache->u.la;
+    PyTypeObject *type = Py_TYPE(owner);
+    unsigned int tp_version_tag;
+    PyObject *descr;
+    Py_ssize_t hint = -1;
+    char kind;
+
+    if (opcode == STORE_ATTR) {
+        if (type->tp_setattro != PyObject_GenericSetAttr) {
+            return 0;
+        }
+    }
+    else if (type->tp_getattro != PyObject_GenericGetAttr) {
+        return 0;
+    }
+    if (!PyUnicode_CheckExact(name)) {
+        return 0;
+    }
+
+    descr = _PyType_Lookup(type, name);
+    if (!PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+        return 0;
+    }
+    tp_version_tag = type->tp_version_tag;
+
+    if (opcode == LOAD_METHOD) {
+        /* The instance dict is checked on each hit */
+        if (descr == NULL
+            || !PyType_HasFeature(Py_TYPE(descr), Py_TPFLAGS_METHOD_DESCRIPTOR)
+            || type->tp_dictoffset < 0)
+        {
+            return 0;
+        }
+        kind = _PyOpcache_ATTR_METHOD;
+    }
+    else if (descr == NULL
+             || (Py_TYPE(descr)->tp_descr_set == NULL
+                 && !PyType_HasFeature(Py_TYPE(descr), Py_TPFLAGS_HEAPTYPE)))
+    {
+        /* The instance dict takes precedence over a non-data descriptor
+           whose type cannot become a data descriptor */
+        PyObject *dict, *value = NULL;
+
+        if (type->tp_dictoffset <= 0) {
+            return 0;
+        }
+        dict = *(PyObject **)((char *)owner + type->tp_dictoffset);
+        if (dict == NULL || !PyDict_CheckExact(dict)) {
+            return 0;
+        }
+        Py_INCREF(dict);
+        hint = _PyDict_GetItemHint((PyDictObject *)dict, name, -1, &value);
+        Py_DECREF(dict);
+        if (hint < 0) {
+            PyErr_Clear();
+            return 0;
+        }
+        kind = _PyOpcache_ATTR_DICT;
+    }
+    else if (Py_TYPE(descr) == &PyMemberDescr_Type) {
+        PyMemberDef *member = ((PyMemberDescrObject *)descr)->d_member;
+
+        if (member->type != T_OBJECT_EX || member->flags != 0
+            || !PyObject_TypeCheck(owner, PyDescr_TYPE(descr)))
+        {
+            return 0;
+        }
+        hint = member->offset;
+        kind = _PyOpcache_ATTR_SLOT;
+    }
+    else {
+        return 0;
+    }
+
+    /* The dict lookup can run arbitrary code which may modify the type */
+    if (!PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)
+        || type->tp_version_tag != tp_version_tag)
+    {
+        return 0;
+    }
+
+    la->type = type;
+    la->tp_version_tag = tp_version_tag;
+    la->kind = kind;
+    la->hint = hint;
+    la->descr = descr;
+    return 1;
+}
+
 #define GIL_REQUEST _Py_atomic_load_relaxed(&ceval->gil_drop_request)
 
 /* This can set eval_breaker to 0 even though gil_drop_request became
@@ -129,6 +289,7 @@ static size_t opcache_global_misses = 0;
         GIL_REQUEST | \
         _Py_atomic_load_relaxed(&(ceval)->signals_pending) | \
         _Py_atomic_load_relaxed(&(ceval)->pending.calls_to_do) | \
+        _Py_atomic_load_relaxed(&(ceval)->sample_request) | \
         (ceval)->pending.async_exc)
 
 #define SET_GIL_DROP_REQUEST(ceval) \
@@ -168,6 +329,18 @@ static size_t opcache_global_misses = 0;
         COMPUTE_EVAL_BREAKER(ceval); \
     } while (0)
 
+#define SIGNAL_SAMPLE_REQUEST(ceval) \
+    do { \
+        _Py_atomic_store_relaxed(&(ceval)->sample_request, 1); \
+        _Py_atomic_store_relaxed(&(ceval)->eval_breaker, 1); \
+    } while (0)
+
+#define UNSIGNAL_SAMPLE_REQUEST(ceval) \
+    do { \
+        _Py_atomic_store_relaxed(&(ceval)->sample_request, 0); \
+        COMPUTE_EVAL_BREAKER(ceval); \
+    } while (0)
+
 #define SIGNAL_ASYNC_EXC(ceval) \
     do { \
         (ceval)->pending.async_exc = 1; \
@@ -243,6 +416,23 @@ exit_thread_if_finalizing(_PyRuntimeState *runtime, PyThreadState *tstate)
     }
 }
 
+#if OPCACHE_STATS
+static void
+opcache_print_attr_stats(const char *opname, size_t hits, size_t misses,
+                         size_t opts, size_t deopts)
+{
+    size_t total = hits + misses;
+
+    fprintf(stderr, "-- Opcode cache %-11s hits   = %zd (%d%%)\n",
+            opname, hits, total ? (int) (100.0 * hits / total) : 0);
+    fprintf(stderr, "-- Opcode cache %-11s misses = %zd (%d%%)\n",
+            opname, misses, total ? (int) (100.0 * misses / total) : 0);
+    fprintf(stderr, "-- Opcode cache %-11s opts   = %zd\n", opname, opts);
+    fprintf(stderr, "-- Opcode cache %-11s deopts = %zd\n", opname, deopts);
+    fprintf(stderr, "\n");
+}
+#endif
+
 void
 _PyEval_Fini(void)
 {
@@ -269,6 +459,31 @@ _PyEval_Fini(void)
             opcache_global_opts);
 
     fprintf(stderr, "\n");
+
+    opcache_print_attr_stats("LOAD_ATTR",
+                             opcache_load_attr_hits,
+                             opcache_load_attr_misses,
+                             opcache_load_attr_opts,
+                             opcache_load_attr_deopts);
+    opcache_print_attr_stats("STORE_ATTR",
+                             opcache_store_attr_hits,
+                             opcache_store_attr_misses,
+                             opcache_store_attr_opts,
+                             opcache_store_attr_deopts);
+    opcache_print_attr_stats("LOAD_METHOD",
+                             opcache_load_method_hits,
+                             opcache_load_method_misses,
+                             opcache_load_method_opts,
+                             opcache_load_method_deopts);
+
+    fprintf(stderr, "-- Specialized instructions        = %zd\n",
+            opcache_specialize_success);
+    fprintf(stderr, "-- Unspecialized instructions      = %zd\n",
+            opcache_specialize_failure);
+    fprintf(stderr, "-- Deoptimized instructions        = %zd\n",
+            opcache_specialize_deopts);
+
+    fprintf(stderr, "\n");
 #endif
 }
 
@@ -431,6 +646,14 @@ _PyEval_SignalReceived(struct _ceval_runtime_state *ceval)
     SIGNAL_PENDING_SIGNALS(ceval);
 }
 
+void
+_PyEval_RequestSample(struct _ceval_runtime_state *ceval)
+{
+    /* Called by the timer thread of the sampling profiler, which doesn't
+       hold the GIL: the eval loop takes the sample. */
+    SIGNAL_SAMPLE_REQUEST(ceval);
+}
+
 /* Push one item onto the queue while holding the lock. */
 static int
 _push_pending_call(struct _pending_calls *pending,
@@ -1062,14 +1285,166 @@ _PyEval_EvalFrameDefault(PyFrameObject *f, int throwflag)
         if (co->co_opcache != NULL) opcache_global_opts++; \
     } while (0)
 
+/* op is one of load_attr, store_attr or load_method */
+#define OPCACHE_STAT_ATTR_HIT(op) \
+    do { \
+        if (co->co_opcache != NULL) opcache_ ## op ## _hits++; \
+    } while (0)
+
+#define OPCACHE_STAT_ATTR_MISS(op) \
+    do { \
+        if (co->co_opcache != NULL) opcache_ ## op ## _misses++; \
+    } while (0)
+
+#define OPCACHE_STAT_ATTR_OPT(op) \
+    do { \
+        if (co->co_opcache != NULL) opcache_ ## op ## _opts++; \
+    } while (0)
+
+#define OPCACHE_STAT_ATTR_DEOPT(op) \
+    do { \
+        if (co->co_opcache != NULL) opcache_ ## op ## _deopts++; \
+    } while (0)
+
+#define OPCACHE_STAT_SPECIALIZE_SUCCESS() opcache_specialize_success++
+#define OPCACHE_STAT_SPECIALIZE_FAILURE() opcache_specialize_failure++
+#define OPCACHE_STAT_SPECIALIZE_DEOPT() opcache_specialize_deopts++
+
 #else /* OPCACHE_STATS */
 
+#define OPCACHE_STAT_SPECIALIZE_SUCCESS()
+#define OPCACHE_STAT_SPECIALIZE_FAILURE()
+#define OPCACHE_STAT_SPECIALIZE_DEOPT()
+
 #define OPCACHE_STAT_GLOBAL_HIT()
 #define OPCACHE_STAT_GLOBAL_MISS()
 #define OPCACHE_STAT_GLOBAL_OPT()
 
+#define OPCACHE_STAT_ATTR_HIT(op)
+#define OPCACHE_STAT_ATTR_MISS(op)
+#define OPCACHE_STAT_ATTR_OPT(op)
+#define OPCACHE_STAT_ATTR_DEOPT(op)
+
 #endif
 
+    /* macros for the caches of LOAD_ATTR, STORE_ATTR and LOAD_METHOD */
+#define OPCACHE_ATTR_TYPE_MATCH(la, tp) \
+    ((la)->type == (tp) && \
+     (la)->tp_version_tag == (tp)->tp_version_tag && \
+     PyType_HasFeature((tp), Py_TPFLAGS_VALID_VERSION_TAG))
+
+    /* Disable the cache of the current instruction for good */
+#define OPCACHE_DEOPT_ATTR(op) \
+    do { \
+        OPCACHE_STAT_ATTR_DEOPT(op); \
+        co->co_opcache_map[next_instr - first_instr] = 0; \
+        co_opcache = NULL; \
+    } while (0)
+
+#define OPCACHE_MAYBE_DEOPT_ATTR(op) \
+    do { \
+        OPCACHE_STAT_ATTR_MISS(op); \
+        if (--co_opcache->optimized <= 0) { \
+            OPCACHE_DEOPT_ATTR(op); \
+        } \
+    } while (0)
+
+    /* Fill the cache after a successful generic access, or disable it if
+       the access cannot be cached */
+#define OPCACHE_UPDATE_ATTR(op, opcode, owner, name) \
+    do { \
+        if (co_opcache != NULL) { \
+            if (opcache_init_attr(co_opcache, (opcode), (owner), (name))) { \
+                if (co_opcache->optimized == 0) { \
+                    OPCACHE_STAT_ATTR_OPT(op); \
+                    co_opcache->optimized = OPCACHE_ATTR_MAX_TRIES; \
+                } \
+            } \
+            else { \
+                OPCACHE_DEOPT_ATTR(op); \
+            } \
+        } \
+    } while (0)
+
+    /* macros for the specialized instructions of quickened code objects
+
+       The *_ADAPTIVE instructions of co_quickened rewrite themselves into
+       the variant specialized for the types of their operands, or into the
+       generic instruction.  A specialized instruction whose operands don't
+       have the expected types rewrites itself into the generic instruction
+       for good. */
+#define QUICKENED_TARGET(op) quickened_##op: ;
+
+    /* next_instr is const since co_code is immutable, but the instructions
+       of co_quickened can be rewritten */
+#define REWRITE_INSTR(op) \
+    (((_Py_CODEUNIT *)next_instr)[-1] = \
+        _Py_MAKECODEUNIT((op), _Py_OPARG(next_instr[-1])))
+
+#define SPECIALIZE(op) \
+    do { \
+        OPCACHE_STAT_SPECIALIZE_SUCCESS(); \
+        REWRITE_INSTR(op); \
+        goto quickened_##op; \
+    } while (0)
+
+#define SPECIALIZE_FAILURE(op) \
+    do { \
+        OPCACHE_STAT_SPECIALIZE_FAILURE(); \
+        REWRITE_INSTR(op); \
+        goto quickened_##op; \
+    } while (0)
+
+#define DEOPT(op) \
+    do { \
+        OPCACHE_STAT_SPECIALIZE_DEOPT(); \
+        REWRITE_INSTR(op); \
+        goto quickened_##op; \
+    } while (0)
+
+    /* The superinstructions of co_quickened, named FIRST__SECOND, replace
+       the first instruction of a pair: they execute FIRST, then execute
+       the SECOND instruction following them without dispatching it.  This
+       is only done when FAST_DISPATCH() would not call a tracing function
+       before SECOND: otherwise SECOND is dispatched as usual. */
+#ifdef LLTRACE
+#define CAN_FUSE() \
+    (!lltrace && !_Py_TracingPossible(ceval) && !PyDTrace_LINE_ENABLED())
+#else
+#define CAN_FUSE() \
+    (!_Py_TracingPossible(ceval) && !PyDTrace_LINE_ENABLED())
+#endif
+
+    /* Fetch the oparg of the second instruction of a superinstruction */
+#define NEXT_FUSED() \
+    do { \
+        f->f_lasti = INSTR_OFFSET(); \
+        NEXTOPARG(); \
+    } while (0)
+
+    /* End of the COMPARE_OP_*__POP_JUMP_IF_FALSE superinstructions: pop
+       the operands of the comparison, whose result is cond, and branch on
+       it without creating a bool */
+#define COMPARE_JUMP(left, right, cond) \
+    do { \
+        int cond_ = (cond); \
+        STACK_SHRINK(2); \
+        Py_DECREF(left); \
+        Py_DECREF(right); \
+        if (!CAN_FUSE()) { \
+            PyObject *res_ = cond_ ? Py_True : Py_False; \
+            Py_INCREF(res_); \
+            PUSH(res_); \
+            FAST_DISPATCH(); \
+        } \
+        NEXT_FUSED(); \
+        assert(opcode == POP_JUMP_IF_FALSE); \
+        if (!cond_) { \
+            JUMPTO(oparg); \
+        } \
+        FAST_DISPATCH(); \
+    } while (0)
+
 /* Start of code */
 
     /* push frame */
@@ -1124,7 +1499,12 @@ _PyEval_EvalFrameDefault(PyFrameObject *f, int throwflag)
     assert(PyBytes_GET_SIZE(co->co_code) <= INT_MAX);
     assert(PyBytes_GET_SIZE(co->co_code) % sizeof(_Py_CODEUNIT) == 0);
     assert(_Py_IS_ALIGNED(PyBytes_AS_STRING(co->co_code), sizeof(_Py_CODEUNIT)));
-    first_instr = (_Py_CODEUNIT *) PyBytes_AS_STRING(co->co_code);
+    if (co->co_quickened != NULL) {
+        first_instr = co->co_quickened;
+    }
+    else {
+        first_instr = (_Py_CODEUNIT *) PyBytes_AS_STRING(co->co_code);
+    }
     /*
        f->f_lasti refers to the index of the last instruction,
        unless it's -1 in which case next_instr should be first_instr.
@@ -1157,6 +1537,11 @@ _PyEval_EvalFrameDefault(PyFrameObject *f, int throwflag)
             if (_PyCode_InitOpcache(co) < 0) {
                 return NULL;
             }
+            if (_PyCode_Quicken(co) < 0) {
+                return NULL;
+            }
+            next_instr = co->co_quickened + (next_instr - first_instr);
+            first_instr = co->co_quickened;
 #if OPCACHE_STATS
             opcache_code_objects_extra_mem +=
                 PyBytes_Size(co->co_code) / sizeof(_Py_CODEUNIT) +
@@ -1229,6 +1614,10 @@ main_loop:
                     goto error;
                 }
             }
+            if (_Py_atomic_load_relaxed(&ceval->sample_request)) {
+                UNSIGNAL_SAMPLE_REQUEST(ceval);
+                _PySampler_Sample(tstate);
+            }
 
             if (_Py_atomic_load_relaxed(&ceval->gil_drop_request)) {
                 /* Give another thread a chance */
@@ -1339,6 +1728,52 @@ main_loop:
             FAST_DISPATCH();
         }
 
+        case TARGET(LOAD_FAST__LOAD_FAST): {
+            PyObject *value = GETLOCAL(oparg);
+            if (value == NULL) {
+                format_exc_check_arg(tstate, PyExc_UnboundLocalError,
+                                     UNBOUNDLOCAL_ERROR_MSG,
+                                     PyTuple_GetItem(co->co_varnames, oparg));
+                goto error;
+            }
+            Py_INCREF(value);
+            PUSH(value);
+            if (!CAN_FUSE()) {
+                FAST_DISPATCH();
+            }
+            /* The second instruction can be a superinstruction starting
+               with LOAD_FAST */
+            NEXT_FUSED();
+            value = GETLOCAL(oparg);
+            if (value == NULL) {
+                format_exc_check_arg(tstate, PyExc_UnboundLocalError,
+                                     UNBOUNDLOCAL_ERROR_MSG,
+                                     PyTuple_GetItem(co->co_varnames, oparg));
+                goto error;
+            }
+            Py_INCREF(value);
+            PUSH(value);
+            FAST_DISPATCH();
+        }
+
+        case TARGET(LOAD_FAST__LOAD_ATTR): {
+            PyObject *value = GETLOCAL(oparg);
+            if (value == NULL) {
+                format_exc_check_arg(tstate, PyExc_UnboundLocalError,
+                                     UNBOUNDLOCAL_ERROR_MSG,
+                                     PyTuple_GetItem(co->co_varnames, oparg));
+                goto error;
+            }
+            Py_INCREF(value);
+            PUSH(value);
+            if (!CAN_FUSE()) {
+                FAST_DISPATCH();
+            }
+            NEXT_FUSED();
+            assert(opcode == LOAD_ATTR);
+            goto quickened_LOAD_ATTR;
+        }
+
         case TARGET(LOAD_CONST): {
             PREDICTED(LOAD_CONST);
             PyObject *value = GETITEM(consts, oparg);
@@ -1537,15 +1972,13 @@ main_loop:
         }
 
         case TARGET(BINARY_ADD): {
+            QUICKENED_TARGET(BINARY_ADD);
             PyObject *right = POP();
             PyObject *left = TOP();
             PyObject *sum;
-            /* NOTE(haypo): Please don't try to micro-optimize int+int on
-               CPython using bytecode, it is simply worthless.
-               See http://bugs.python.org/issue21955 and
-               http://bugs.python.org/issue10044 for the discussion. In short,
-               no patch shown any impact on a realistic benchmark, only a minor
-               speedup on microbenchmarks. */
+            /* int+int and float+float are only special-cased by the
+               specialized instructions of quickened code objects, see
+               BINARY_ADD_ADAPTIVE. */
             if (PyUnicode_CheckExact(left) &&
                      PyUnicode_CheckExact(right)) {
                 sum = unicode_concatenate(tstate, left, right, f, next_instr);
@@ -1562,6 +1995,84 @@ main_loop:
             DISPATCH();
         }
 
+        case TARGET(BINARY_ADD_ADAPTIVE): {
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            if (Py_TYPE(left) == Py_TYPE(right)) {
+                if (PyLong_CheckExact(left)) {
+                    SPECIALIZE(BINARY_ADD_INT);
+                }
+                if (PyFloat_CheckExact(left)) {
+                    SPECIALIZE(BINARY_ADD_FLOAT);
+                }
+                if (PyUnicode_CheckExact(left)) {
+                    SPECIALIZE(BINARY_ADD_UNICODE);
+                }
+            }
+            SPECIALIZE_FAILURE(BINARY_ADD);
+        }
+
+        case TARGET(BINARY_ADD_INT): {
+            QUICKENED_TARGET(BINARY_ADD_INT);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            PyObject *sum;
+            if (!PyLong_CheckExact(left) || !PyLong_CheckExact(right)) {
+                DEOPT(BINARY_ADD);
+            }
+            if (IS_MEDIUM_INT(left) && IS_MEDIUM_INT(right)) {
+                sum = PyLong_FromLong((long)MEDIUM_INT_VALUE(left) +
+                                      MEDIUM_INT_VALUE(right));
+            }
+            else {
+                sum = PyLong_Type.tp_as_number->nb_add(left, right);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(right);
+            Py_DECREF(left);
+            SET_TOP(sum);
+            if (sum == NULL)
+                goto error;
+            DISPATCH();
+        }
+
+        case TARGET(BINARY_ADD_FLOAT): {
+            QUICKENED_TARGET(BINARY_ADD_FLOAT);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            PyObject *sum;
+            if (!PyFloat_CheckExact(left) || !PyFloat_CheckExact(right)) {
+                DEOPT(BINARY_ADD);
+            }
+            sum = PyFloat_FromDouble(PyFloat_AS_DOUBLE(left) +
+                                     PyFloat_AS_DOUBLE(right));
+            STACK_SHRINK(1);
+            Py_DECREF(right);
+            Py_DECREF(left);
+            SET_TOP(sum);
+            if (sum == NULL)
+                goto error;
+            DISPATCH();
+        }
+
+        case TARGET(BINARY_ADD_UNICODE): {
+            QUICKENED_TARGET(BINARY_ADD_UNICODE);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            PyObject *sum;
+            if (!PyUnicode_CheckExact(left) || !PyUnicode_CheckExact(right)) {
+                DEOPT(BINARY_ADD);
+            }
+            STACK_SHRINK(1);
+            sum = unicode_concatenate(tstate, left, right, f, next_instr);
+            /* unicode_concatenate consumed the ref to left */
+            Py_DECREF(right);
+            SET_TOP(sum);
+            if (sum == NULL)
+                goto error;
+            DISPATCH();
+        }
+
         case TARGET(BINARY_SUBTRACT): {
             PyObject *right = POP();
             PyObject *left = TOP();
@@ -1575,6 +2086,7 @@ main_loop:
         }
 
         case TARGET(BINARY_SUBSCR): {
+            QUICKENED_TARGET(BINARY_SUBSCR);
             PyObject *sub = POP();
             PyObject *container = TOP();
             PyObject *res = PyObject_GetItem(container, sub);
@@ -1586,6 +2098,110 @@ main_loop:
             DISPATCH();
         }
 
+        case TARGET(BINARY_SUBSCR_ADAPTIVE): {
+            PyObject *sub = TOP();
+            PyObject *container = SECOND();
+            if (PyList_CheckExact(container) && PyLong_CheckExact(sub)) {
+                SPECIALIZE(BINARY_SUBSCR_LIST_INT);
+            }
+            if (PyTuple_CheckExact(container) && PyLong_CheckExact(sub)) {
+                SPECIALIZE(BINARY_SUBSCR_TUPLE_INT);
+            }
+            if (PyDict_CheckExact(container)) {
+                SPECIALIZE(BINARY_SUBSCR_DICT);
+            }
+            SPECIALIZE_FAILURE(BINARY_SUBSCR);
+        }
+
+        case TARGET(BINARY_SUBSCR_LIST_INT): {
+            QUICKENED_TARGET(BINARY_SUBSCR_LIST_INT);
+            PyObject *sub = TOP();
+            PyObject *container = SECOND();
+            PyObject *res;
+            if (!PyList_CheckExact(container) || !PyLong_CheckExact(sub)) {
+                DEOPT(BINARY_SUBSCR);
+            }
+            res = NULL;
+            if (IS_MEDIUM_INT(sub)) {
+                Py_ssize_t i = MEDIUM_INT_VALUE(sub);
+                if (i < 0) {
+                    i += PyList_GET_SIZE(container);
+                }
+                if ((size_t)i < (size_t)PyList_GET_SIZE(container)) {
+                    res = PyList_GET_ITEM(container, i);
+                    Py_INCREF(res);
+                }
+            }
+            if (res == NULL) {
+                /* Large index or IndexError */
+                res = PyObject_GetItem(container, sub);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(container);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            if (res == NULL)
+                goto error;
+            DISPATCH();
+        }
+
+        case TARGET(BINARY_SUBSCR_TUPLE_INT): {
+            QUICKENED_TARGET(BINARY_SUBSCR_TUPLE_INT);
+            PyObject *sub = TOP();
+            PyObject *container = SECOND();
+            PyObject *res;
+            if (!PyTuple_CheckExact(container) || !PyLong_CheckExact(sub)) {
+                DEOPT(BINARY_SUBSCR);
+            }
+            res = NULL;
+            if (IS_MEDIUM_INT(sub)) {
+                Py_ssize_t i = MEDIUM_INT_VALUE(sub);
+                if (i < 0) {
+                    i += PyTuple_GET_SIZE(container);
+                }
+                if ((size_t)i < (size_t)PyTuple_GET_SIZE(container)) {
+                    res = PyTuple_GET_ITEM(container, i);
+                    Py_INCREF(res);
+                }
+            }
+            if (res == NULL) {
+                /* Large index or IndexError */
+                res = PyObject_GetItem(container, sub);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(container);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            if (res == NULL)
+                goto error;
+            DISPATCH();
+        }
+
+        case TARGET(BINARY_SUBSCR_DICT): {
+            QUICKENED_TARGET(BINARY_SUBSCR_DICT);
+            PyObject *sub = TOP();
+            PyObject *container = SECOND();
+            PyObject *res;
+            if (!PyDict_CheckExact(container)) {
+                DEOPT(BINARY_SUBSCR);
+            }
+            /* Exact dicts have no __missing__() method */
+            res = PyDict_GetItemWithError(container, sub);
+            if (res != NULL) {
+                Py_INCREF(res);
+            }
+            else if (!_PyErr_Occurred(tstate)) {
+                _PyErr_SetKeyError(sub);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(container);
+            Py_DECREF(sub);
+            SET_TOP(res);
+            if (res == NULL)
+                goto error;
+            DISPATCH();
+        }
+
         case TARGET(BINARY_LSHIFT): {
             PyObject *right = POP();
             PyObject *left = TOP();
@@ -2363,9 +2979,59 @@ main_loop:
             PyObject *name = GETITEM(names, oparg);
             PyObject *owner = TOP();
             PyObject *v = SECOND();
+            PyTypeObject *type = Py_TYPE(owner);
             int err;
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                _PyOpcache_LoadAttr *la = &co_opcache->u.la;
+                int miss = 1;
+
+                if (OPCACHE_ATTR_TYPE_MATCH(la, type)) {
+                    if (la->kind == _PyOpcache_ATTR_DICT) {
+                        PyObject *dict = *(PyObject **)
+                            ((char *)owner + type->tp_dictoffset);
+                        if (dict == NULL) {
+                            /* The first store creates the instance dict:
+                               not a miss */
+                            miss = 0;
+                        }
+                        else if (PyDict_CheckExact(dict) &&
+                                 _PyDict_SetItemHint((PyDictObject *)dict,
+                                                     name, la->hint, v))
+                        {
+                            OPCACHE_STAT_ATTR_HIT(store_attr);
+                            STACK_SHRINK(2);
+                            Py_DECREF(v);
+                            Py_DECREF(owner);
+                            DISPATCH();
+                        }
+                    }
+                    else {
+                        PyObject **addr;
+                        PyObject *old_value;
+
+                        assert(la->kind == _PyOpcache_ATTR_SLOT);
+                        addr = (PyObject **)((char *)owner + la->hint);
+                        old_value = *addr;
+                        OPCACHE_STAT_ATTR_HIT(store_attr);
+                        STACK_SHRINK(2);
+                        *addr = v;  /* steals the reference */
+                        Py_XDECREF(old_value);
+                        Py_DECREF(owner);
+                        DISPATCH();
+                    }
+                }
+                if (miss) {
+                    OPCACHE_MAYBE_DEOPT_ATTR(store_attr);
+                }
+            }
+
             STACK_SHRINK(2);
             err = PyObject_SetAttr(owner, name, v);
+            if (err == 0) {
+                OPCACHE_UPDATE_ATTR(store_attr, STORE_ATTR, owner, name);
+            }
             Py_DECREF(v);
             Py_DECREF(owner);
             if (err != 0)
@@ -2957,9 +3623,57 @@ main_loop:
         }
 
         case TARGET(LOAD_ATTR): {
+            QUICKENED_TARGET(LOAD_ATTR);
             PyObject *name = GETITEM(names, oparg);
             PyObject *owner = TOP();
-            PyObject *res = PyObject_GetAttr(owner, name);
+            PyTypeObject *type = Py_TYPE(owner);
+            PyObject *res;
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                _PyOpcache_LoadAttr *la = &co_opcache->u.la;
+
+                if (OPCACHE_ATTR_TYPE_MATCH(la, type)) {
+                    res = NULL;
+                    if (la->kind == _PyOpcache_ATTR_DICT) {
+                        PyObject *dict = *(PyObject **)
+                            ((char *)owner + type->tp_dictoffset);
+                        if (dict != NULL && PyDict_CheckExact(dict)) {
+                            /* The lookup can run arbitrary code which
+                               may replace or free the dict */
+                            Py_ssize_t hint;
+                            Py_INCREF(dict);
+                            hint = _PyDict_GetItemHint(
+                                (PyDictObject *)dict, name, la->hint, &res);
+                            Py_XINCREF(res);
+                            Py_DECREF(dict);
+                            if (hint >= 0) {
+                                la->hint = hint;
+                            }
+                            else if (_PyErr_Occurred(tstate)) {
+                                goto error;
+                            }
+                        }
+                    }
+                    else {
+                        assert(la->kind == _PyOpcache_ATTR_SLOT);
+                        res = *(PyObject **)((char *)owner + la->hint);
+                        Py_XINCREF(res);
+                    }
+                    if (res != NULL) {
+                        OPCACHE_STAT_ATTR_HIT(load_attr);
+                        SET_TOP(res);
+                        Py_DECREF(owner);
+                        DISPATCH();
+                    }
+                }
+                OPCACHE_MAYBE_DEOPT_ATTR(load_attr);
+            }
+
+            res = PyObject_GetAttr(owner, name);
+            if (res != NULL) {
+                OPCACHE_UPDATE_ATTR(load_attr, LOAD_ATTR, owner, name);
+            }
             Py_DECREF(owner);
             SET_TOP(res);
             if (res == NULL)
@@ -2968,6 +3682,7 @@ main_loop:
         }
 
         case TARGET(COMPARE_OP): {
+            QUICKENED_TARGET(COMPARE_OP);
             PyObject *right = POP();
             PyObject *left = TOP();
             PyObject *res = cmp_outcome(tstate, oparg, left, right);
@@ -2981,6 +3696,154 @@ main_loop:
             DISPATCH();
         }
 
+        case TARGET(COMPARE_OP_ADAPTIVE): {
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            assert(oparg <= Py_GE);
+            if (Py_TYPE(left) == Py_TYPE(right)) {
+                /* Most comparisons are followed by a conditional jump */
+                int fuse = _Py_OPCODE(*next_instr) == POP_JUMP_IF_FALSE;
+                if (PyLong_CheckExact(left)) {
+                    if (fuse) {
+                        SPECIALIZE(COMPARE_OP_INT__POP_JUMP_IF_FALSE);
+                    }
+                    SPECIALIZE(COMPARE_OP_INT);
+                }
+                if (PyFloat_CheckExact(left)) {
+                    if (fuse) {
+                        SPECIALIZE(COMPARE_OP_FLOAT__POP_JUMP_IF_FALSE);
+                    }
+                    SPECIALIZE(COMPARE_OP_FLOAT);
+                }
+                if (PyUnicode_CheckExact(left)) {
+                    if (fuse) {
+                        SPECIALIZE(COMPARE_OP_STR__POP_JUMP_IF_FALSE);
+                    }
+                    SPECIALIZE(COMPARE_OP_STR);
+                }
+            }
+            SPECIALIZE_FAILURE(COMPARE_OP);
+        }
+
+        case TARGET(COMPARE_OP_INT): {
+            QUICKENED_TARGET(COMPARE_OP_INT);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            PyObject *res;
+            if (!PyLong_CheckExact(left) || !PyLong_CheckExact(right)) {
+                DEOPT(COMPARE_OP);
+            }
+            if (IS_MEDIUM_INT(left) && IS_MEDIUM_INT(right)) {
+                sdigit a = MEDIUM_INT_VALUE(left);
+                sdigit b = MEDIUM_INT_VALUE(right);
+                res = RICHCOMPARE_VALUES(a, b, oparg) ? Py_True : Py_False;
+                Py_INCREF(res);
+            }
+            else {
+                res = PyLong_Type.tp_richcompare(left, right, oparg);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            SET_TOP(res);
+            if (res == NULL)
+                goto error;
+            PREDICT(POP_JUMP_IF_FALSE);
+            PREDICT(POP_JUMP_IF_TRUE);
+            DISPATCH();
+        }
+
+        case TARGET(COMPARE_OP_FLOAT): {
+            QUICKENED_TARGET(COMPARE_OP_FLOAT);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            PyObject *res;
+            double a, b;
+            if (!PyFloat_CheckExact(left) || !PyFloat_CheckExact(right)) {
+                DEOPT(COMPARE_OP);
+            }
+            a = PyFloat_AS_DOUBLE(left);
+            b = PyFloat_AS_DOUBLE(right);
+            res = RICHCOMPARE_VALUES(a, b, oparg) ? Py_True : Py_False;
+            Py_INCREF(res);
+            STACK_SHRINK(1);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            SET_TOP(res);
+            PREDICT(POP_JUMP_IF_FALSE);
+            PREDICT(POP_JUMP_IF_TRUE);
+            DISPATCH();
+        }
+
+        case TARGET(COMPARE_OP_STR): {
+            QUICKENED_TARGET(COMPARE_OP_STR);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            PyObject *res;
+            int cmp;
+            if (!PyUnicode_CheckExact(left) || !PyUnicode_CheckExact(right)) {
+                DEOPT(COMPARE_OP);
+            }
+            cmp = unicode_richcompare_fast(left, right, oparg);
+            if (cmp < 0) {
+                goto error;
+            }
+            res = cmp ? Py_True : Py_False;
+            Py_INCREF(res);
+            STACK_SHRINK(1);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            SET_TOP(res);
+            PREDICT(POP_JUMP_IF_FALSE);
+            PREDICT(POP_JUMP_IF_TRUE);
+            DISPATCH();
+        }
+
+        case TARGET(COMPARE_OP_INT__POP_JUMP_IF_FALSE): {
+            QUICKENED_TARGET(COMPARE_OP_INT__POP_JUMP_IF_FALSE);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            sdigit a, b;
+            if (!PyLong_CheckExact(left) || !PyLong_CheckExact(right)) {
+                DEOPT(COMPARE_OP);
+            }
+            if (!IS_MEDIUM_INT(left) || !IS_MEDIUM_INT(right)) {
+                /* Compare them and dispatch POP_JUMP_IF_FALSE */
+                goto quickened_COMPARE_OP_INT;
+            }
+            a = MEDIUM_INT_VALUE(left);
+            b = MEDIUM_INT_VALUE(right);
+            COMPARE_JUMP(left, right, RICHCOMPARE_VALUES(a, b, oparg));
+        }
+
+        case TARGET(COMPARE_OP_FLOAT__POP_JUMP_IF_FALSE): {
+            QUICKENED_TARGET(COMPARE_OP_FLOAT__POP_JUMP_IF_FALSE);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            double a, b;
+            if (!PyFloat_CheckExact(left) || !PyFloat_CheckExact(right)) {
+                DEOPT(COMPARE_OP);
+            }
+            a = PyFloat_AS_DOUBLE(left);
+            b = PyFloat_AS_DOUBLE(right);
+            COMPARE_JUMP(left, right, RICHCOMPARE_VALUES(a, b, oparg));
+        }
+
+        case TARGET(COMPARE_OP_STR__POP_JUMP_IF_FALSE): {
+            QUICKENED_TARGET(COMPARE_OP_STR__POP_JUMP_IF_FALSE);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            int cmp;
+            if (!PyUnicode_CheckExact(left) || !PyUnicode_CheckExact(right)) {
+                DEOPT(COMPARE_OP);
+            }
+            cmp = unicode_richcompare_fast(left, right, oparg);
+            if (cmp < 0) {
+                goto error;
+            }
+            COMPARE_JUMP(left, right, cmp);
+        }
+
         case TARGET(IMPORT_NAME): {
             PyObject *name = GETITEM(names, oparg);
             PyObject *fromlist = POP();
@@ -3405,15 +4268,63 @@ main_loop:
             /* Designed to work in tandem with CALL_METHOD. */
             PyObject *name = GETITEM(names, oparg);
             PyObject *obj = TOP();
+            PyTypeObject *type = Py_TYPE(obj);
             PyObject *meth = NULL;
+            int meth_found;
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                _PyOpcache_LoadAttr *la = &co_opcache->u.la;
+
+                if (OPCACHE_ATTR_TYPE_MATCH(la, type)) {
+                    PyObject *dict = NULL;
+                    PyObject *attr = NULL;
+
+                    assert(la->kind == _PyOpcache_ATTR_METHOD);
+                    meth = la->descr;
+                    Py_INCREF(meth);
+                    if (type->tp_dictoffset > 0) {
+                        dict = *(PyObject **)
+                            ((char *)obj + type->tp_dictoffset);
+                    }
+                    if (dict != NULL && PyDict_GET_SIZE(dict) != 0) {
+                        /* Check that the instance dict doesn't shadow
+                           the method */
+                        Py_INCREF(dict);
+                        (void)_PyDict_GetItemHint((PyDictObject *)dict,
+                                                  name, -1, &attr);
+                        Py_DECREF(dict);
+                        if (attr == NULL && _PyErr_Occurred(tstate)) {
+                            Py_DECREF(meth);
+                            goto error;
+                        }
+                    }
+                    if (attr == NULL) {
+                        OPCACHE_STAT_ATTR_HIT(load_method);
+                        SET_TOP(meth);
+                        PUSH(obj);  // self
+                        DISPATCH();
+                    }
+                    Py_DECREF(meth);
+                    meth = NULL;
+                }
+                OPCACHE_MAYBE_DEOPT_ATTR(load_method);
+            }
 
-            int meth_found = _PyObject_GetMethod(obj, name, &meth);
+            meth_found = _PyObject_GetMethod(obj, name, &meth);
 
             if (meth == NULL) {
                 /* Most likely attribute wasn't found. */
                 goto error;
             }
 
+            if (meth_found) {
+                OPCACHE_UPDATE_ATTR(load_method, LOAD_METHOD, obj, name);
+            }
+            else if (co_opcache != NULL) {
+                OPCACHE_DEOPT_ATTR(load_method);
+            }
+
             if (meth_found) {
                 /* We can bypass temporary bound method object.
                    meth is unbound method and obj is self.
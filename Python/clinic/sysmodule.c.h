@@ -900,6 +900,133 @@ sys__debugmallocstats(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__debugmallocstats_impl(module);
 }
 
+PyDoc_STRVAR(sys__trim_memory__doc__,
+"_trim_memory($module, /)\n"
+"--\n"
+"\n"
+"Give the memory of the unused pymalloc pools back to the OS.\n"
+"\n"
+"Return the number of bytes released.");
+
+#define SYS__TRIM_MEMORY_METHODDEF    \
+    {"_trim_memory", (PyCFunction)sys__trim_memory, METH_NOARGS, sys__trim_memory__doc__},
+
+static PyObject *
+sys__trim_memory_impl(PyObject *module);
+
+static PyObject *
+sys__trim_memory(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__trim_memory_impl(module);
+}
+
+PyDoc_STRVAR(sys__start_sampling__doc__,
+"_start_sampling($module, /, interval=0.001, size=1000000)\n"
+"--\n"
+"\n"
+"Start the sampling profiler.\n"
+"\n"
+"Every interval seconds, record the stack of the thread running Python\n"
+"code into a ring buffer of size frames.  The oldest samples are\n"
+"overwritten when it is full.");
+
+#define SYS__START_SAMPLING_METHODDEF    \
+    {"_start_sampling", (PyCFunction)(void(*)(void))sys__start_sampling, METH_FASTCALL|METH_KEYWORDS, sys__start_sampling__doc__},
+
+static PyObject *
+sys__start_sampling_impl(PyObject *module, PyObject *interval,
+                         Py_ssize_t size);
+
+static PyObject *
+sys__start_sampling(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"interval", "size", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "_start_sampling", 0};
+    PyObject *argsbuf[2];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    PyObject *interval = NULL;
+    Py_ssize_t size = 1000000;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 2, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[0]) {
+        interval = args[0];
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    if (PyFloat_Check(args[1])) {
+        PyErr_SetString(PyExc_TypeError,
+                        "integer argument expected, got float" );
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = PyNumber_Index(args[1]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        size = ival;
+    }
+skip_optional_pos:
+    return_value = sys__start_sampling_impl(module, interval, size);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__stop_sampling__doc__,
+"_stop_sampling($module, /)\n"
+"--\n"
+"\n"
+"Stop the sampling profiler.\n"
+"\n"
+"The samples are kept until the profiler is started again.");
+
+#define SYS__STOP_SAMPLING_METHODDEF    \
+    {"_stop_sampling", (PyCFunction)sys__stop_sampling, METH_NOARGS, sys__stop_sampling__doc__},
+
+static PyObject *
+sys__stop_sampling_impl(PyObject *module);
+
+static PyObject *
+sys__stop_sampling(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__stop_sampling_impl(module);
+}
+
+PyDoc_STRVAR(sys__get_sampled_stacks__doc__,
+"_get_sampled_stacks($module, /)\n"
+"--\n"
+"\n"
+"Return the samples of the sampling profiler as collapsed stacks.\n"
+"\n"
+"Return a dict mapping stacks to their number of samples.  A stack is\n"
+"made of the frames of a sample separated by semicolons, from the\n"
+"outermost to the innermost one.");
+
+#define SYS__GET_SAMPLED_STACKS_METHODDEF    \
+    {"_get_sampled_stacks", (PyCFunction)sys__get_sampled_stacks, METH_NOARGS, sys__get_sampled_stacks__doc__},
+
+static PyObject *
+sys__get_sampled_stacks_impl(PyObject *module);
+
+static PyObject *
+sys__get_sampled_stacks(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__get_sampled_stacks_impl(module);
+}
+
 PyDoc_STRVAR(sys__clear_type_cache__doc__,
 "_clear_type_cache($module, /)\n"
 "--\n"
@@ -989,4 +1116,4 @@ sys_getandroidapilevel(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=acef77d2bb8f6da9 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=806d1cdb16bb3099 input=a9049054013a1b77]*/
@@ -89,6 +89,8 @@ static const char usage_6[] =
 "PYTHONMALLOC: set the Python memory allocators and/or install debug hooks\n"
 "   on Python memory allocators. Use PYTHONMALLOC=debug to install debug\n"
 "   hooks.\n"
+"PYTHONMALLOCARENASIZE: size of the pymalloc arenas (ex: 1M).\n"
+"PYTHONMALLOCHUGEPAGES: back the pymalloc arenas with huge pages.\n"
 "PYTHONCOERCECLOCALE: if this variable is set to 0, it disables the locale\n"
 "   coercion behavior. Use PYTHONCOERCECLOCALE=warn to request display of\n"
 "   locale coercion and locale compatibility warnings on stderr.\n"
@@ -752,6 +754,8 @@ _PyConfig_Copy(PyConfig *config, const PyConfig *config2)
     COPY_ATTR(show_alloc_count);
     COPY_ATTR(dump_refs);
     COPY_ATTR(malloc_stats);
+    COPY_ATTR(pymalloc_arena_size);
+    COPY_ATTR(pymalloc_hugepages);
 
     COPY_WSTR_ATTR(pycache_prefix);
     COPY_WSTR_ATTR(pythonpath_env);
@@ -855,6 +859,8 @@ config_as_dict(const PyConfig *config)
     SET_ITEM_INT(show_alloc_count);
     SET_ITEM_INT(dump_refs);
     SET_ITEM_INT(malloc_stats);
+    SET_ITEM_UINT(pymalloc_arena_size);
+    SET_ITEM_INT(pymalloc_hugepages);
     SET_ITEM_WSTR(filesystem_encoding);
     SET_ITEM_WSTR(filesystem_errors);
     SET_ITEM_WSTR(pycache_prefix);
@@ -1326,6 +1332,75 @@ config_init_tracemalloc(PyConfig *config)
 }
 
 
+/* Parse a size in bytes, optionally followed by a "K" or "M" suffix
+   (kilobytes and megabytes). Return 0 on success, -1 on error. */
+static int
+config_size_with_suffix(unsigned long value, int suffix, unsigned long *size)
+{
+    unsigned long unit;
+    switch (suffix) {
+    case '\0':
+        unit = 1;
+        break;
+    case 'k':
+    case 'K':
+        unit = 1024;
+        break;
+    case 'm':
+    case 'M':
+        unit = 1024 * 1024;
+        break;
+    default:
+        return -1;
+    }
+    if (value > ULONG_MAX / unit) {
+        return -1;
+    }
+    *size = value * unit;
+    return 0;
+}
+
+
+static PyStatus
+config_init_pymalloc_arena_size(PyConfig *config)
+{
+    unsigned long value = 0;
+    unsigned long size;
+
+    const char *env = config_get_env(config, "PYTHONMALLOCARENASIZE");
+    if (env) {
+        char *endptr;
+        errno = 0;
+        value = strtoul(env, &endptr, 10);
+        if (errno || endptr == env
+            || (*endptr != '\0' && endptr[1] != '\0')
+            || config_size_with_suffix(value, *endptr, &size) < 0)
+        {
+            return _PyStatus_ERR("PYTHONMALLOCARENASIZE: invalid size");
+        }
+        config->pymalloc_arena_size = size;
+    }
+
+    const wchar_t *xoption = config_get_xoption(config, L"pymalloc_arena_size");
+    if (xoption) {
+        const wchar_t *sep = wcschr(xoption, L'=');
+        wchar_t *endptr = NULL;
+        if (sep) {
+            errno = 0;
+            value = wcstoul(sep + 1, &endptr, 10);
+        }
+        if (!sep || errno || endptr == sep + 1
+            || (*endptr != L'\0' && endptr[1] != L'\0')
+            || config_size_with_suffix(value, (int)*endptr, &size) < 0)
+        {
+            return _PyStatus_ERR("-X pymalloc_arena_size=SIZE: invalid size");
+        }
+        config->pymalloc_arena_size = size;
+    }
+    return _PyStatus_OK();
+}
+
+
 static PyStatus
 config_init_pycache_prefix(PyConfig *config)
 {
@@ -1368,8 +1443,19 @@ config_read_complex_options(PyConfig *config)
        || config_get_xoption(config, L"importtime")) {
         config->import_time = 1;
     }
+    if (config_get_env(config, "PYTHONMALLOCHUGEPAGES")
+       || config_get_xoption(config, L"pymalloc_hugepages")) {
+        config->pymalloc_hugepages = 1;
+    }
 
     PyStatus status;
+    if (config->pymalloc_arena_size == 0) {
+        status = config_init_pymalloc_arena_size(config);
+        if (_PyStatus_EXCEPTION(status)) {
+            return status;
+        }
+    }
+
     if (config->tracemalloc < 0) {
         status = config_init_tracemalloc(config);
         if (_PyStatus_EXCEPTION(status)) {
@@ -510,6 +510,12 @@ pycore_init_runtime(_PyRuntimeState *runtime,
         return status;
     }
 
+    if (_PyObject_SetArenaConfig(config->pymalloc_arena_size,
+                                 config->pymalloc_hugepages) < 0) {
+        return _PyStatus_ERR("invalid pymalloc arena size: must be a power "
+                             "of 2 between 64K and 16M");
+    }
+
     status = _PyInterpreterState_Enable(runtime);
     if (_PyStatus_EXCEPTION(status)) {
         return status;
@@ -1174,6 +1180,9 @@ Py_FinalizeEx(void)
 
     call_py_exitfuncs(tstate);
 
+    /* Stop the sampling profiler and release its samples */
+    _PySampler_Fini();
+
     /* Copy the core config, PyInterpreterState_Delete() free
        the core config memory */
 #ifdef Py_REF_DEBUG
@@ -0,0 +1,345 @@
+/* Sampling profiler
+
+   A timer thread requests a sample every interval through the eval breaker,
+   like signals and pending calls do.  The thread running Python code then
+   records the code objects and the last instructions of its frames into a
+   ring buffer allocated when the sampling starts: see _PySampler_Sample().  Taking a sample costs a walk
+   of the frame stack, and nothing is done between samples, so the sampling
+   can stay enabled in production.
+
+   _PySampler_GetStacks() aggregates the samples into collapsed stacks, the
+   input format of flame graph tools.
+*/
+
+#include "Python.h"
+#include "pycore_ceval.h"
+#include "pycore_pystate.h"
+#include "frameobject.h"
+
+
+/* The ring buffer is made of entries: for each frame of a sample, from the
+   innermost frame to the outermost one, its code object and its f_lasti,
+   followed by the header of the sample giving its number of frames.  Entries
+   of code objects are strong references; the other entries have their lowest
+   bit set.  The line numbers are only computed when the samples are
+   aggregated. */
+#define SAMPLE_HEADER(depth) (((uintptr_t)(depth) << 1) | 1)
+#define IS_SAMPLE_HEADER(entry) ((entry) & 1)
+#define SAMPLE_DEPTH(entry) ((Py_ssize_t)((entry) >> 1))
+/* f_lasti is -1 in a frame which didn't start yet */
+#define SAMPLE_LASTI(lasti) (((uintptr_t)((lasti) + 1) << 1) | 1)
+#define SAMPLE_LASTI_VALUE(entry) ((int)((entry) >> 1) - 1)
+/* Number of entries of a sample of depth frames */
+#define SAMPLE_SIZE(depth) (2 * (depth) + 1)
+
+static struct {
+    uintptr_t *entries;
+    Py_ssize_t size;
+    /* Total number of entries written: the i-th one is at
+       entries[i % size] */
+    uint64_t written;
+    _PyTime_t interval;
+    int running;
+    /* Held while the timer thread runs: releasing it stops the thread */
+    PyThread_type_lock stop;
+    /* Released by the timer thread when it exits */
+    PyThread_type_lock done;
+} sampler;
+
+
+static void
+sampler_clear_entries(void)
+{
+    if (sampler.entries == NULL) {
+        return;
+    }
+    for (Py_ssize_t i = 0; i < sampler.size; i++) {
+        uintptr_t entry = sampler.entries[i];
+        if (entry != 0 && !IS_SAMPLE_HEADER(entry)) {
+            Py_DECREF((PyObject *)entry);
+        }
+    }
+    PyMem_Free(sampler.entries);
+    sampler.entries = NULL;
+    sampler.size = 0;
+    sampler.written = 0;
+}
+
+static inline void
+sampler_write(uintptr_t entry)
+{
+    uintptr_t *slot = &sampler.entries[sampler.written % sampler.size];
+    uintptr_t old = *slot;
+    *slot = entry;
+    sampler.written++;
+    if (old != 0 && !IS_SAMPLE_HEADER(old)) {
+        Py_DECREF((PyObject *)old);
+    }
+}
+
+/* Record the frames of tstate into the ring buffer.  Called by the eval
+   loop when a sample was requested. */
+void
+_PySampler_Sample(PyThreadState *tstate)
+{
+    PyFrameObject *f;
+    Py_ssize_t depth = 0;
+
+    if (!sampler.running) {
+        return;
+    }
+    for (f = tstate->frame; f != NULL; f = f->f_back) {
+        depth++;
+    }
+    if (depth == 0) {
+        return;
+    }
+    if (SAMPLE_SIZE(depth) > sampler.size) {
+        /* The sample doesn't fit in the buffer */
+        return;
+    }
+    for (f = tstate->frame; f != NULL; f = f->f_back) {
+        Py_INCREF(f->f_code);
+        sampler_write((uintptr_t)f->f_code);
+        sampler_write(SAMPLE_LASTI(f->f_lasti));
+    }
+    sampler_write(SAMPLE_HEADER(depth));
+}
+
+static void
+sampler_thread(void *unused)
+{
+    _PyTime_t timeout = _PyTime_AsMicroseconds(sampler.interval,
+                                               _PyTime_ROUND_CEILING);
+    while (PyThread_acquire_lock_timed(sampler.stop, timeout, 0)
+           == PY_LOCK_FAILURE) {
+        _PyEval_RequestSample(&_PyRuntime.ceval);
+    }
+    PyThread_release_lock(sampler.stop);
+    PyThread_release_lock(sampler.done);
+}
+
+/* Start sampling the running thread every interval, into a new ring buffer
+   of size frames.  Return 0 on success, or raise an exception and return
+   -1 on error. */
+int
+_PySampler_Start(_PyTime_t interval, Py_ssize_t size)
+{
+    if (sampler.running) {
+        PyErr_SetString(PyExc_RuntimeError, "sampling is already running");
+        return -1;
+    }
+    if (interval <= 0) {
+        PyErr_SetString(PyExc_ValueError, "interval must be positive");
+        return -1;
+    }
+    if (size < 2) {
+        PyErr_SetString(PyExc_ValueError, "size must be at least 2");
+        return -1;
+    }
+    if (size > PY_SSIZE_T_MAX / 2) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (sampler.stop == NULL) {
+        sampler.stop = PyThread_allocate_lock();
+        if (sampler.stop == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    if (sampler.done == NULL) {
+        sampler.done = PyThread_allocate_lock();
+        if (sampler.done == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+
+    sampler_clear_entries();
+    /* Two entries per frame */
+    size *= 2;
+    sampler.entries = PyMem_New(uintptr_t, size);
+    if (sampler.entries == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(sampler.entries, 0, size * sizeof(uintptr_t));
+    sampler.size = size;
+    sampler.interval = interval;
+
+    PyThread_acquire_lock(sampler.stop, WAIT_LOCK);
+    PyThread_acquire_lock(sampler.done, WAIT_LOCK);
+    sampler.running = 1;
+    if (PyThread_start_new_thread(sampler_thread, NULL)
+        == PYTHREAD_INVALID_THREAD_ID) {
+        sampler.running = 0;
+        PyThread_release_lock(sampler.done);
+        PyThread_release_lock(sampler.stop);
+        PyErr_SetString(PyExc_RuntimeError, "can't start the sampling thread");
+        return -1;
+    }
+    return 0;
+}
+
+/* Stop sampling.  The samples are kept until the next start.  Do nothing if
+   the sampling is not running. */
+void
+_PySampler_Stop(void)
+{
+    if (!sampler.running) {
+        return;
+    }
+    sampler.running = 0;
+    PyThread_release_lock(sampler.stop);
+    /* The timer thread doesn't need the GIL: it exits promptly */
+    PyThread_acquire_lock(sampler.done, WAIT_LOCK);
+    PyThread_release_lock(sampler.done);
+}
+
+/* Return the label of a frame in the collapsed stacks, given its code
+   object and its f_lasti, caching it in labels.  Return a borrowed
+   reference, or NULL on error. */
+static PyObject *
+sampler_label(PyObject *labels, PyCodeObject *code, int lasti)
+{
+    PyObject *key = Py_BuildValue("(Oi)", code, lasti);
+    if (key == NULL) {
+        return NULL;
+    }
+    PyObject *label = PyDict_GetItemWithError(labels, key);
+    if (label != NULL || PyErr_Occurred()) {
+        Py_DECREF(key);
+        return label;
+    }
+    /* Like PyFrame_GetLineNumber() */
+    label = PyUnicode_FromFormat("%U (%U:%d)",
+                                 code->co_name, code->co_filename,
+                                 PyCode_Addr2Line(code, lasti));
+    if (label == NULL) {
+        Py_DECREF(key);
+        return NULL;
+    }
+    int res = PyDict_SetItem(labels, key, label);
+    Py_DECREF(key);
+    Py_DECREF(label);
+    if (res < 0) {
+        return NULL;
+    }
+    return label;
+}
+
+/* Return a dict mapping the collapsed stacks of the samples in the ring
+   buffer to their number of samples.  A collapsed stack is made of the
+   labels of its frames separated by semicolons, from the outermost frame to
+   the innermost one. */
+PyObject *
+_PySampler_GetStacks(void)
+{
+    PyObject *stacks = NULL, *labels = NULL, *frames = NULL;
+    PyObject *sep = NULL;
+    /* Building the result may run Python code, through the garbage
+       collector: no samples are taken meanwhile, so that the buffer
+       doesn't change. */
+    int running = sampler.running;
+    sampler.running = 0;
+
+    stacks = PyDict_New();
+    labels = PyDict_New();
+    frames = PyList_New(0);
+    sep = PyUnicode_FromString(";");
+    if (stacks == NULL || labels == NULL || frames == NULL || sep == NULL) {
+        goto error;
+    }
+    if (sampler.entries == NULL) {
+        goto done;
+    }
+
+    /* Walk the samples from the newest one: the oldest one may have been
+       partially overwritten */
+    uint64_t begin = 0;
+    uint64_t end = sampler.written;
+    if (end > (uint64_t)sampler.size) {
+        begin = end - sampler.size;
+    }
+    while (end > begin) {
+        uintptr_t header = sampler.entries[(end - 1) % sampler.size];
+        assert(IS_SAMPLE_HEADER(header));
+        Py_ssize_t depth = SAMPLE_DEPTH(header);
+        if (end - begin < (uint64_t)SAMPLE_SIZE(depth)) {
+            break;
+        }
+        if (PyList_SetSlice(frames, 0, PY_SSIZE_T_MAX, NULL) < 0) {
+            goto error;
+        }
+        /* The outermost frame was written last */
+        for (Py_ssize_t i = 0; i < depth; i++) {
+            uint64_t pos = end - 3 - 2 * (uint64_t)i;
+            uintptr_t code = sampler.entries[pos % sampler.size];
+            uintptr_t lasti = sampler.entries[(pos + 1) % sampler.size];
+            PyObject *label = sampler_label(labels, (PyCodeObject *)code,
+                                            SAMPLE_LASTI_VALUE(lasti));
+            if (label == NULL || PyList_Append(frames, label) < 0) {
+                goto error;
+            }
+        }
+        end -= SAMPLE_SIZE(depth);
+
+        PyObject *stack = PyUnicode_Join(sep, frames);
+        if (stack == NULL) {
+            goto error;
+        }
+        PyObject *count = PyDict_GetItemWithError(stacks, stack);
+        if (count == NULL && PyErr_Occurred()) {
+            Py_DECREF(stack);
+            goto error;
+        }
+        count = PyLong_FromSsize_t(
+            count == NULL ? 1 : PyLong_AsSsize_t(count) + 1);
+        if (count == NULL) {
+            Py_DECREF(stack);
+            goto error;
+        }
+        int res = PyDict_SetItem(stacks, stack, count);
+        Py_DECREF(stack);
+        Py_DECREF(count);
+        if (res < 0) {
+            goto error;
+        }
+    }
+
+done:
+    sampler.running = running;
+    Py_DECREF(labels);
+    Py_DECREF(frames);
+    Py_DECREF(sep);
+    return stacks;
+
+error:
+    sampler.running = running;
+    Py_XDECREF(stacks);
+    Py_XDECREF(labels);
+    Py_XDECREF(frames);
+    Py_XDECREF(sep);
+    return NULL;
+}
+
+/* The timer thread doesn't exist in the child process after fork(), and
+   the locks may be held by it. */
+void
+_PySampler_AfterFork(void)
+{
+    if (sampler.running) {
+        sampler.running = 0;
+        /* Leak the locks: they may be in an inconsistent state */
+        sampler.stop = NULL;
+        sampler.done = NULL;
+    }
+}
+
+void
+_PySampler_Fini(void)
+{
+    _PySampler_Stop();
+    sampler_clear_entries();
+}
@@ -1807,6 +1807,88 @@ sys__debugmallocstats_impl(PyObject *module)
     Py_RETURN_NONE;
 }
 
+/*[clinic input]
+sys._trim_memory
+
+Give the memory of the unused pymalloc pools back to the OS.
+
+Return the number of bytes released.
+[clinic start generated code]*/
+
+static PyObject *
+sys__trim_memory_impl(PyObject *module)
+/*[clinic end generated code: output=9b575515df404b35 input=eb43c2d24375cd93]*/
+{
+    size_t released = 0;
+#ifdef WITH_PYMALLOC
+    released = _PyObject_TrimMemory();
+#endif
+    return PyLong_FromSize_t(released);
+}
+
+/*[clinic input]
+sys._start_sampling
+
+    interval: object(c_default="NULL") = 0.001
+    size: Py_ssize_t = 1000000
+
+Start the sampling profiler.
+
+Every interval seconds, record the stack of the thread running Python
+code into a ring buffer of size frames.  The oldest samples are
+overwritten when it is full.
+[clinic start generated code]*/
+
+static PyObject *
+sys__start_sampling_impl(PyObject *module, PyObject *interval,
+                         Py_ssize_t size)
+/*[clinic end generated code: output=3cf85b928247fcfb input=02aa891e7b949c14]*/
+{
+    _PyTime_t timeout = _PyTime_FromNanoseconds(1000 * 1000);
+    if (interval != NULL
+        && _PyTime_FromSecondsObject(&timeout, interval,
+                                     _PyTime_ROUND_CEILING) < 0) {
+        return NULL;
+    }
+    if (_PySampler_Start(timeout, size) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._stop_sampling
+
+Stop the sampling profiler.
+
+The samples are kept until the profiler is started again.
+[clinic start generated code]*/
+
+static PyObject *
+sys__stop_sampling_impl(PyObject *module)
+/*[clinic end generated code: output=1d90a2fdb890f945 input=42de233687891374]*/
+{
+    _PySampler_Stop();
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._get_sampled_stacks
+
+Return the samples of the sampling profiler as collapsed stacks.
+
+Return a dict mapping stacks to their number of samples.  A stack is
+made of the frames of a sample separated by semicolons, from the
+outermost to the innermost one.
+[clinic start generated code]*/
+
+static PyObject *
+sys__get_sampled_stacks_impl(PyObject *module)
+/*[clinic end generated code: output=dc49653a1050ac4b input=eddcf451b9d06d00]*/
+{
+    return _PySampler_GetStacks();
+}
+
 #ifdef Py_TRACE_REFS
 /* Defined in objects.c because it uses static globals if that file */
 extern PyObject *_Py_GetObjects(PyObject *, PyObject *);
@@ -1911,6 +1993,10 @@ static PyMethodDef sys_methods[] = {
     SYS_GETTRACE_METHODDEF
     SYS_CALL_TRACING_METHODDEF
     SYS__DEBUGMALLOCSTATS_METHODDEF
+    SYS__TRIM_MEMORY_METHODDEF
+    SYS__START_SAMPLING_METHODDEF
+    SYS__STOP_SAMPLING_METHODDEF
+    SYS__GET_SAMPLED_STACKS_METHODDEF
     SYS_SET_COROUTINE_ORIGIN_TRACKING_DEPTH_METHODDEF
     SYS_GET_COROUTINE_ORIGIN_TRACKING_DEPTH_METHODDEF
     {"set_asyncgen_hooks", (PyCFunction)(void(*)(void))sys_set_asyncgen_hooks,
@@ -0,0 +1,195 @@
+"""Measure the instruction dispatches saved by the superinstructions.
+
+Each benchmark is a small function run in a loop.  It is first called more
+times than the interpreter needs to quicken it, so that its superinstructions
+(the combined instructions listed in opcode._specialized_instructions, named
+FIRST__SECOND) are in use.  For each benchmark, the number of instructions
+executed per iteration is counted with an opcode tracing function, together
+with the number of dispatches left once the pairs of instructions executed
+by a superinstruction are counted as one, and the best time per iteration of
+a few runs is printed.
+
+Quickening is disabled on debug builds: use a release build.
+"""
+
+import argparse
+import dis
+import opcode
+import sys
+import time
+
+
+# More than OPCACHE_MIN_RUNS in Python/ceval.c
+WARMUP = 1100
+
+def generic_opname(name):
+    """Return the name of the instruction which name specializes."""
+    return max((op for op in opcode.opmap if name.startswith(op)), key=len)
+
+
+SUPERINSTRUCTIONS = {(generic_opname(first), second)
+                     for first, _, second in
+                     (name.partition("__")
+                      for name in getattr(opcode, "_specialized_instructions",
+                                          ())
+                      if "__" in name)}
+
+
+class Point:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+
+def bench_locals(n, a, b):
+    # LOAD_FAST__LOAD_FAST
+    x = 0
+    for i in range(n):
+        x = a + b
+        x = a * b
+    return x
+
+
+def bench_attributes(n, p):
+    # LOAD_FAST__LOAD_ATTR
+    x = 0
+    for i in range(n):
+        x = p.x + p.y
+    return x
+
+
+def bench_while(n):
+    # LOAD_FAST__LOAD_FAST and COMPARE_OP_INT__POP_JUMP_IF_FALSE
+    i = 0
+    while i < n:
+        i += 1
+    return i
+
+
+def bench_branches(n, a, b):
+    # COMPARE_OP_INT__POP_JUMP_IF_FALSE (not for "is")
+    x = 0
+    for i in range(n):
+        if i < a:
+            x += 1
+        if i == b:
+            x -= 1
+        if a is None:
+            x = 0
+    return x
+
+
+def bench_mixed(n, p, q):
+    # All the superinstructions
+    x = 0
+    for i in range(n):
+        dx = p.x - q.x
+        dy = p.y - q.y
+        if dx * dx + dy * dy < i:
+            x += 1
+    return x
+
+
+BENCHMARKS = [
+    (bench_locals, (1, 2)),
+    (bench_attributes, (Point(1, 2),)),
+    (bench_while, ()),
+    (bench_branches, (50, 60)),
+    (bench_mixed, (Point(1, 2), Point(3, 5))),
+]
+
+
+def fused_offsets(code):
+    """Return the offsets of the instructions of code which the quickener
+    replaces by a superinstruction.  The rich comparisons are assumed to be
+    between ints, floats or strings, which are the specialized ones."""
+    offsets = set()
+    instrs = list(dis.get_instructions(code))
+    for prev, first, second in zip([None] + instrs, instrs, instrs[1:]):
+        if prev is not None and prev.opname == "EXTENDED_ARG":
+            continue
+        if first.opname == "COMPARE_OP" and first.arg > 5:
+            continue
+        if (first.opname, second.opname) in SUPERINSTRUCTIONS:
+            offsets.add(first.offset)
+    return offsets
+
+
+def count_dispatches(func, n, args):
+    """Return the number of instructions executed by func(n, *args), and the
+    number of dispatches when superinstructions are used."""
+    code = func.__code__
+    offsets = []
+
+    def tracer(frame, event, arg):
+        if frame.f_code is not code:
+            return None
+        frame.f_trace_opcodes = True
+        frame.f_trace_lines = False
+        if event == "opcode":
+            offsets.append(frame.f_lasti)
+        return tracer
+
+    sys.settrace(tracer)
+    try:
+        func(n, *args)
+    finally:
+        sys.settrace(None)
+
+    # The instruction following a superinstruction is executed without
+    # being dispatched, unless the superinstruction jumped or failed
+    fused = fused_offsets(code)
+    dispatches = 0
+    pending = None
+    for offset in offsets:
+        if offset == pending:
+            pending = None
+            continue
+        dispatches += 1
+        pending = offset + 2 if offset in fused else None
+    return len(offsets), dispatches
+
+
+def time_func(func, n, args, runs):
+    """Return the best time per iteration of func(n, *args)."""
+    best = None
+    for run in range(runs):
+        t0 = time.perf_counter()
+        func(n, *args)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best / n
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--loops", type=int, default=1_000_000,
+                        help="number of iterations of each benchmark "
+                             "(default: %(default)s)")
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of runs of each benchmark "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    if hasattr(sys, "gettotalrefcount"):
+        print("warning: quickening is disabled on debug builds")
+    if not SUPERINSTRUCTIONS:
+        print("warning: no superinstructions in this version")
+    print("%-18s %11s %11s %7s %9s" % ("benchmark", "instrs/it",
+                                       "dispatch/it", "saved", "ns/it"))
+    for func, func_args in BENCHMARKS:
+        for i in range(WARMUP):
+            func(1, *func_args)
+        ninstrs, ndispatches = count_dispatches(func, 1000, func_args)
+        ninstrs0, ndispatches0 = count_dispatches(func, 0, func_args)
+        ninstrs = (ninstrs - ninstrs0) / 1000
+        ndispatches = (ndispatches - ndispatches0) / 1000
+        dt = time_func(func, args.loops, func_args, args.runs)
+        print("%-18s %11.1f %11.1f %6.0f%% %9.1f"
+              % (func.__name__, ninstrs, ndispatches,
+                 (1 - ndispatches / ninstrs) * 100, dt * 1e9))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,63 @@
+"""Time arithmetic on large ints and conversions to decimal strings.
+
+For each number of decimal digits given on the command line, the best time
+of a few runs of str(n), int(s), n * m and divmod(n * m, m) is printed,
+for random n and m of that many digits.
+"""
+
+import argparse
+import operator
+import random
+import time
+
+
+def best_time(runs, func, *args):
+    best = None
+    for run in range(runs):
+        t0 = time.perf_counter()
+        func(*args)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best
+
+
+def format_time(dt):
+    if dt < 1e-3:
+        return "%.1f us" % (dt * 1e6)
+    if dt < 1.0:
+        return "%.1f ms" % (dt * 1e3)
+    return "%.2f s" % dt
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", type=int, default=3,
+                        help="number of runs of each operation "
+                             "(default: %(default)s)")
+    parser.add_argument("digits", type=int, nargs="*",
+                        default=[1000, 10_000, 100_000, 1_000_000],
+                        help="numbers of decimal digits "
+                             "(default: 1000 10000 100000 1000000)")
+    args = parser.parse_args()
+
+    rand = random.Random(0)
+    print("%10s %12s %12s %12s %12s"
+          % ("digits", "str(n)", "int(s)", "n * m", "divmod"))
+    for ndigits in args.digits:
+        n = rand.randrange(10 ** (ndigits - 1), 10 ** ndigits)
+        m = rand.randrange(10 ** (ndigits - 1), 10 ** ndigits)
+        s = str(n)
+        assert int(s) == n
+        p = n * m
+        assert divmod(p, m) == (n, 0)
+        times = [best_time(args.runs, str, n),
+                 best_time(args.runs, int, s),
+                 best_time(args.runs, operator.mul, n, m),
+                 best_time(args.runs, divmod, p, m)]
+        print("%10d %12s %12s %12s %12s"
+              % (ndigits, *map(format_time, times)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+"""Time arithmetic on small ints.
+
+Each benchmark runs a loop doing an operation on ints of a given size, like
+counters and indices do.  The best time of a few runs is printed, per loop
+iteration.
+"""
+
+import argparse
+import time
+
+
+# Values of one and two 30-bit digits, and of three digits
+ONE_DIGIT = 123_456
+TWO_DIGITS = 12_345_678_901
+THREE_DIGITS = 12_345_678_901_234_567_890
+
+
+def bench_add(n, x):
+    y = 0
+    for i in range(n):
+        y = x + x
+    return y
+
+
+def bench_sub(n, x):
+    y = 0
+    for i in range(n):
+        y = x - 7
+    return y
+
+
+def bench_mul(n, x):
+    y = 0
+    for i in range(n):
+        y = x * 3
+    return y
+
+
+def bench_counter(n, x):
+    count = x
+    for i in range(n):
+        count += 1
+    return count
+
+
+def bench_index(n, x):
+    # Mixed arithmetic on a loop index
+    total = 0
+    for i in range(x, x + n):
+        total += (i * 3 - 1) & 0xff
+    return total
+
+
+def bench_fib(n, x):
+    a, b = 0, 1
+    for i in range(n):
+        a, b = b, a + b
+        if a > x:
+            a, b = 0, 1
+    return a
+
+
+BENCHMARKS = [
+    ("add", bench_add),
+    ("sub", bench_sub),
+    ("mul", bench_mul),
+    ("counter", bench_counter),
+    ("index", bench_index),
+    ("fib", bench_fib),
+]
+
+SIZES = [
+    ("1 digit", ONE_DIGIT),
+    ("2 digits", TWO_DIGITS),
+    ("3 digits", THREE_DIGITS),
+]
+
+
+def best_time(runs, loops, func, arg):
+    best = None
+    for run in range(runs):
+        t0 = time.perf_counter()
+        func(loops, arg)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best / loops
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of runs of each benchmark "
+                             "(default: %(default)s)")
+    parser.add_argument("--loops", type=int, default=1_000_000,
+                        help="number of loop iterations of each run "
+                             "(default: %(default)s)")
+    parser.add_argument("benchmarks", nargs="*",
+                        help="benchmarks to run, among %s (default: all)"
+                             % ", ".join(name for name, func in BENCHMARKS))
+    args = parser.parse_args()
+    for name in args.benchmarks:
+        if name not in dict(BENCHMARKS):
+            parser.error("unknown benchmark: %r" % name)
+
+    print("%-10s" % "" + "".join("%12s" % size for size, x in SIZES))
+    for name, func in BENCHMARKS:
+        if args.benchmarks and name not in args.benchmarks:
+            continue
+        times = [best_time(args.runs, args.loops, func, x) for size, x in SIZES]
+        print("%-10s" % name + "".join("%9.1f ns" % (dt * 1e9)
+                                       for dt in times))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+"""Measure the memory kept by the process after a spike of allocations.
+
+A "spike" allocates many small objects, then the "drain" frees most of them
+but keeps small clusters of objects spread over the whole heap: most pymalloc
+pools become empty, but few arenas do.  The resident set size (RSS) is printed
+after each phase, and after sys._trim_memory() gave the memory of the unused
+pools back to the OS.
+
+The RSS is read from /proc/self/statm, so the benchmark only runs on Linux.
+"""
+
+import argparse
+import gc
+import os
+import sys
+
+
+PAGE_SIZE = os.sysconf("SC_PAGE_SIZE")
+
+
+def rss():
+    """Return the resident set size of the process in bytes."""
+    with open("/proc/self/statm") as fp:
+        return int(fp.read().split()[1]) * PAGE_SIZE
+
+
+def spike(nobjects):
+    """Allocate nobjects small objects of various sizes."""
+    objects = []
+    for i in range(nobjects):
+        kind = i % 4
+        if kind == 0:
+            obj = str(i) * (i % 8 + 1)
+        elif kind == 1:
+            obj = (i, i + 1)
+        elif kind == 2:
+            obj = {"key": i}
+        else:
+            obj = [i] * (i % 16)
+        objects.append(obj)
+    return objects
+
+
+def drain(objects, keep, cluster=100):
+    """Free all objects but one cluster of objects out of keep."""
+    for i in range(len(objects)):
+        if (i // cluster) % keep:
+            objects[i] = None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--nobjects", type=int, default=2_000_000,
+                        help="number of objects allocated by the spike "
+                             "(default: %(default)s)")
+    parser.add_argument("-k", "--keep", type=int, default=50,
+                        help="keep one cluster of 100 objects out of KEEP "
+                             "after the drain (default: %(default)s)")
+    parser.add_argument("-r", "--rounds", type=int, default=3,
+                        help="number of spike-and-drain rounds "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    if not hasattr(sys, "_trim_memory"):
+        sys.exit("sys._trim_memory() is not available")
+
+    def report(what):
+        print("%-28s %8.1f MiB" % (what, rss() / (1024 * 1024)))
+
+    report("start")
+    kept = []
+    for round in range(1, args.rounds + 1):
+        objects = spike(args.nobjects)
+        report("round %s: spike" % round)
+        drain(objects, args.keep)
+        kept.append(objects)
+        gc.collect()
+        report("round %s: drain" % round)
+        released = sys._trim_memory()
+        report("round %s: trim (%.1f MiB)" % (round, released / (1024 * 1024)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+"""Time pickle.dumps() of lists and dicts of plain ints, floats and strs.
+
+These homogeneous containers make up most of the payloads sent between
+processes.  The records benchmark pickles a list of small dicts sharing
+their keys, the mixed one a list of ints, floats and strs in turn.  The
+best time of a few runs is printed.
+"""
+
+import argparse
+import pickle
+import time
+
+
+N = 1_000_000
+
+INTS = list(range(N))
+BIG_INTS = [i << 40 for i in range(N)]
+FLOATS = [i * 0.5 for i in range(N)]
+STRS = [str(i) for i in range(N)]
+SHARED_STRS = ["spam", "eggs", "ham"] * (N // 3)
+MIXED = [x for i in range(N // 3) for x in (i, i * 0.5, "%x" % i)]
+DICT_STR_INT = {str(i): i for i in range(N)}
+DICT_INT_FLOAT = {i: i * 0.5 for i in range(N)}
+RECORDS = [{"id": i, "name": "item%d" % i, "price": i * 0.25}
+           for i in range(N // 10)]
+
+BENCHMARKS = [
+    ("list of small ints", INTS),
+    ("list of big ints", BIG_INTS),
+    ("list of floats", FLOATS),
+    ("list of strs", STRS),
+    ("list of shared strs", SHARED_STRS),
+    ("list of mixed", MIXED),
+    ("dict str -> int", DICT_STR_INT),
+    ("dict int -> float", DICT_INT_FLOAT),
+    ("list of records", RECORDS),
+]
+
+
+def best_time(runs, func, *args):
+    best = None
+    for run in range(runs):
+        t0 = time.perf_counter()
+        func(*args)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of runs of each benchmark "
+                             "(default: %(default)s)")
+    parser.add_argument("--protocol", type=int,
+                        default=pickle.HIGHEST_PROTOCOL,
+                        help="pickle protocol (default: %(default)s)")
+    args = parser.parse_args()
+
+    for name, obj in BENCHMARKS:
+        dt = best_time(args.runs, pickle.dumps, obj, args.protocol)
+        print("%-22s %10.3f ms" % (name, dt * 1e3))
+
+
+if __name__ == "__main__":
+    main()
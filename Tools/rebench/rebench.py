@@ -0,0 +1,70 @@
+"""Time regular expression searches over log-like text.
+
+Most patterns require a literal string further than their start, like
+log scanning patterns usually do: the text is searched for the literal
+before trying to match.  The best time of a few runs is printed.
+"""
+
+import argparse
+import re
+import time
+
+
+LINE = ("2019-10-18 12:00:01 INFO [worker-3] GET /api/v1/items?id=42 "
+        "status=200 bytes=5120 time=12ms agent=curl/7.58.0\n")
+TEXT = LINE * (1_000_000 // len(LINE))
+ERROR_TEXT = TEXT + LINE.replace("INFO", "ERROR")
+# The same text with a character out of Latin-1: 2 bytes per character
+TEXT_UCS2 = TEXT.replace("INFO", "INFŐ")
+BTEXT = TEXT.encode("ascii")
+
+BENCHMARKS = [
+    # (name, method, pattern, text)
+    ("search absent", "search", r"\w+ ERROR \[", TEXT),
+    ("search at end", "search", r"\w+ ERROR \[", ERROR_TEXT),
+    ("search absent UCS2", "search", r"\w+ ERROR \[", TEXT_UCS2),
+    ("search absent bytes", "search", rb"\w+ ERROR \[", BTEXT),
+    ("search .* absent", "search", r"GET .*status=500", TEXT),
+    ("findall key=value", "findall", r"(\w+)=(\d+)ms", TEXT),
+    ("findall urls", "findall", r"[a-z]+://\S+", TEXT),
+    ("findall prefix", "findall", r"status=(\d+)", TEXT),
+    ("finditer rare", "finditer", r"(\d+):(\d+):01 ERROR", ERROR_TEXT),
+    ("sub", "sub", r"id=\d+", TEXT),
+]
+
+
+def run(method, pattern, text):
+    if method == "finditer":
+        for m in pattern.finditer(text):
+            pass
+    elif method == "sub":
+        pattern.sub("id=?", text)
+    else:
+        getattr(pattern, method)(text)
+
+
+def best_time(runs, func, *args):
+    best = None
+    for i in range(runs):
+        t0 = time.perf_counter()
+        func(*args)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of runs of each benchmark "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    for name, method, pattern, text in BENCHMARKS:
+        dt = best_time(args.runs, run, method, re.compile(pattern), text)
+        print("%-22s %10.3f ms" % (name, dt * 1e3))
+
+
+if __name__ == "__main__":
+    main()
@@ -15,6 +15,11 @@ extern "C" {
     /* Instruction opcodes for compiled code */
 """.lstrip()
 
+specialized_header = """
+    /* Specialized instructions, only used by the interpreter in the
+       quickened copy of the bytecode of hot code objects */
+"""
+
 footer = """
 /* EXCEPT_HANDLER is a special, implicit block type which is created when
    entering an except handler. It is not an opcode but we define it here
@@ -54,6 +59,10 @@ def main(opcode_py, outfile='Include/opcode.h'):
             if name == 'POP_EXCEPT': # Special entry for HAVE_ARGUMENT
                 fobj.write("#define %-23s %3d\n" %
                             ('HAVE_ARGUMENT', opcode['HAVE_ARGUMENT']))
+        fobj.write(specialized_header)
+        for name in opcode['_specialized_instructions']:
+            fobj.write("#define %-23s %3s\n" %
+                       (name, opcode['_specialized_opmap'][name]))
         fobj.write(footer)
 
     print("%s regenerated from %s" % (outfile, opcode_py))
@@ -0,0 +1,79 @@
+"""Time substring searches in str and bytes.
+
+The "typical" benchmarks search log-like lines for words, like log parsers
+do.  The "worst case" ones use periodic needles which make a naive or
+Horspool search compare the whole needle at almost every position of the
+text.  The best time of a few runs is printed.
+"""
+
+import argparse
+import time
+
+
+LINE = ("2019-10-18 12:00:01 INFO [worker-3] GET /api/v1/items?id=42 "
+        "status=200 bytes=5120 time=12ms agent=curl/7.58.0\n")
+TEXT = LINE * (1_000_000 // len(LINE))
+# The same text with a character out of Latin-1: 2 bytes per character
+TEXT_UCS2 = TEXT.replace("INFO", "INFŐ")
+BTEXT = TEXT.encode("ascii")
+
+WORST = "a" * 1_000_000
+WORST_UCS2 = "Ā" * 1_000_000
+
+
+def periodic(k, c="a", d="b"):
+    # Matches the text everywhere but in its middle
+    return c * k + d + c * k
+
+
+BENCHMARKS = [
+    # typical
+    ("find 3 chars", TEXT.find, "xyz"),
+    ("find 10 chars", TEXT.find, "status=500"),
+    ("find 40 chars", TEXT.find, "GET /api/v1/items?id=42 status=404 bytes"),
+    ("find 100 chars", TEXT.find, LINE[:99] + "!"),
+    ("find 10 chars UCS2", TEXT_UCS2.find, "status=500"),
+    ("find 10 chars bytes", BTEXT.find, b"status=500"),
+    ("count", TEXT.count, "status="),
+    ("split", TEXT.split, " status="),
+    ("replace", TEXT.replace, "status=200", "status=OK"),
+    ("bytes replace", BTEXT.replace, b"status=200", b"status=OK"),
+    # worst case
+    ("worst find 2*10+1", WORST.find, periodic(10)),
+    ("worst find 2*100+1", WORST.find, periodic(100)),
+    ("worst find 2*1000+1", WORST.find, periodic(1000)),
+    ("worst count 2*100+1", WORST.count, periodic(100)),
+    ("worst find UCS2", WORST_UCS2.find, periodic(100, "Ā", "ā")),
+    ("worst find bytes", WORST.encode().find, periodic(100).encode()),
+]
+
+
+def best_time(runs, func, *args):
+    best = None
+    for run in range(runs):
+        t0 = time.perf_counter()
+        func(*args)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", type=int, default=5,
+                        help="number of runs of each benchmark "
+                             "(default: %(default)s)")
+    parser.add_argument("--worst", action="store_true",
+                        help="only run the worst case benchmarks")
+    args = parser.parse_args()
+
+    for name, func, *fargs in BENCHMARKS:
+        if args.worst and not name.startswith("worst"):
+            continue
+        dt = best_time(args.runs, func, *fargs)
+        print("%-22s %10.3f ms" % (name, dt * 1e3))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+"""Time UTF-8 decoding of texts in various scripts.
+
+Each corpus repeats sample lines up to about one megabyte of UTF-8, like log
+files do.  The best time of a few runs of bytes.decode() is printed, with
+the decoding speed in megabytes of input per second.
+"""
+
+import argparse
+import time
+
+
+SAMPLES = {
+    "english": "2019-10-18 12:00:01 INFO Request handled in 12 ms, "
+               "status 200, user agent curl/7.58.0\n",
+    "french": "Le système a redémarré après une défaillance "
+              "du contrôleur de disque à 12h05.\n",
+    "german": "Größere Änderungen an der Übersetzung müssen "
+              "geprüft werden, schöne Grüße.\n",
+    "russian": "Ошибка подключения к базе данных: превышено "
+               "время ожидания ответа сервера.\n",
+    "greek": "Η σύνδεση με τον διακομιστή απέτυχε μετά από "
+             "τρεις προσπάθειες.\n",
+    "chinese": "服务器在处理请求时发生错误，请稍后重试或联系管理员。\n",
+    "japanese": "ファイルの読み込み中にエラーが発生しました。"
+                "設定を確認してください。\n",
+    "emoji": "Deploy finished 🚀 all checks passed ✅ "
+             "coffee time ☕ 😀🎉\n",
+}
+# Lines of all the samples one after the other
+SAMPLES["mixed"] = "".join(SAMPLES.values())
+
+SIZE = 1 << 20
+
+
+def make_corpus(line):
+    data = line.encode("utf-8")
+    return data * max(1, SIZE // len(data))
+
+
+def best_time(runs, func, *args):
+    best = None
+    for run in range(runs):
+        t0 = time.perf_counter()
+        func(*args)
+        dt = time.perf_counter() - t0
+        if best is None or dt < best:
+            best = dt
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", type=int, default=20,
+                        help="number of runs of each benchmark "
+                             "(default: %(default)s)")
+    parser.add_argument("corpora", nargs="*",
+                        help="corpora to decode, among %s (default: all)"
+                             % ", ".join(SAMPLES))
+    args = parser.parse_args()
+    for name in args.corpora:
+        if name not in SAMPLES:
+            parser.error("unknown corpus: %r" % name)
+
+    print("%-10s %12s %12s" % ("corpus", "time", "speed"))
+    for name, line in SAMPLES.items():
+        if args.corpora and name not in args.corpora:
+            continue
+        data = make_corpus(line)
+        dt = best_time(args.runs, data.decode, "utf-8")
+        print("%-10s %9.2f ms %7.0f MB/s"
+              % (name, dt * 1e3, len(data) / dt / 1e6))
+
+
+if __name__ == "__main__":
+    main()